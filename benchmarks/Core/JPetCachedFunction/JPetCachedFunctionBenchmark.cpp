@@ -0,0 +1,53 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetCachedFunctionBenchmark.cpp
+ */
+
+#include "JPetBenchmark/JPetBenchmark.h"
+#include "JPetCachedFunction/JPetCachedFunction.h"
+
+using namespace jpet_common_tools;
+
+JPET_BENCHMARK(JPetCachedFunction_construct1D)
+{
+  JPetCachedFunctionParams params("pol1", {1., 2.});
+  while (state.keepRunning())
+  {
+    JPetCachedFunction1D function(params, Range(10000, 0., 100.));
+    JPetBenchmark::doNotOptimize(function);
+  }
+}
+
+JPET_BENCHMARK(JPetCachedFunction_evaluate1D)
+{
+  JPetCachedFunction1D function(JPetCachedFunctionParams("[0]*x*x+[1]", {1., 2.}), Range(10000, 0., 100.));
+  double x = 0.;
+  while (state.keepRunning())
+  {
+    JPetBenchmark::doNotOptimize(function(x));
+    x = x < 99. ? x + 0.37 : 0.;
+  }
+}
+
+JPET_BENCHMARK(JPetCachedFunction_evaluate2D)
+{
+  JPetCachedFunction2D function(JPetCachedFunctionParams("[0]*x+[1]*y", {1., 2.}), Range(100, 0., 100.), Range(100, 0., 100.));
+  double x = 0.;
+  double y = 50.;
+  while (state.keepRunning())
+  {
+    JPetBenchmark::doNotOptimize(function(x, y));
+    x = x < 99. ? x + 0.37 : 0.;
+    y = y < 99. ? y + 0.71 : 0.;
+  }
+}
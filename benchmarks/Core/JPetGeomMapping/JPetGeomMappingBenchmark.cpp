@@ -0,0 +1,88 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetGeomMappingBenchmark.cpp
+ */
+
+#include "JPetBenchmark/JPetBenchmark.h"
+#include "JPetBenchmark/JPetSyntheticParamGetter.h"
+#include "JPetGeomMapping/JPetGeomMapping.h"
+#include "JPetParamManager/JPetParamManager.h"
+
+namespace
+{
+JPetParamManager& getParamManager()
+{
+  static JPetParamManager manager(new JPetSyntheticParamGetter());
+  static bool isFilled = false;
+  if (!isFilled)
+  {
+    manager.fillParameterBank(1);
+    isFilled = true;
+  }
+  return manager;
+}
+
+std::vector<const JPetBarrelSlot*> getSlots(const JPetParamBank& bank)
+{
+  std::vector<const JPetBarrelSlot*> slots;
+  for (const auto& slot : bank.getBarrelSlots())
+  {
+    slots.push_back(slot.second);
+  }
+  return slots;
+}
+}
+
+JPET_BENCHMARK(JPetGeomMapping_construct)
+{
+  const auto& bank = getParamManager().getParamBank();
+  while (state.keepRunning())
+  {
+    JPetGeomMapping mapping(bank);
+    JPetBenchmark::doNotOptimize(mapping);
+  }
+}
+
+JPET_BENCHMARK(JPetGeomMapping_getStripPos)
+{
+  const auto& bank = getParamManager().getParamBank();
+  JPetGeomMapping mapping(bank);
+  auto slots = getSlots(bank);
+  std::size_t i = 0;
+  while (state.keepRunning())
+  {
+    auto pos = mapping.getStripPos(*slots[i]);
+    JPetBenchmark::doNotOptimize(pos);
+    i = (i + 1) % slots.size();
+  }
+}
+
+JPET_BENCHMARK(JPetGeomMapping_getTOMB)
+{
+  JPetGeomMapping mapping(getParamManager().getParamBank());
+  auto sizes = mapping.getLayersSizes();
+  std::size_t layer = 0;
+  int slot = 0;
+  int threshold = 0;
+  while (state.keepRunning())
+  {
+    auto tomb = mapping.getTOMB(layer + 1, slot + 1, threshold % 2 ? JPetPM::SideA : JPetPM::SideB, threshold % 4 + 1);
+    JPetBenchmark::doNotOptimize(tomb);
+    threshold++;
+    if (++slot == static_cast<int>(sizes[layer]))
+    {
+      slot = 0;
+      layer = (layer + 1) % sizes.size();
+    }
+  }
+}
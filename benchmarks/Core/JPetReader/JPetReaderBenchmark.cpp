@@ -0,0 +1,92 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetReaderBenchmark.cpp
+ */
+
+#include "JPetBenchmark/JPetBenchmark.h"
+#include "JPetReader/JPetReader.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetWriter/JPetWriter.h"
+
+namespace
+{
+const int kEvents = 10000;
+const int kSigChPerEvent = 20;
+
+/// File with kEvents time windows, created once for all the reader benchmarks.
+const std::string& getInputFile()
+{
+  static const std::string fileName = []() {
+    auto name = JPetBenchmark::getTemporaryFileName("reader.root");
+    JPetWriter writer(name.c_str());
+    JPetTimeWindow window("JPetSigCh");
+    for (int event = 0; event < kEvents; event++)
+    {
+      window.Clear();
+      for (int i = 0; i < kSigChPerEvent; i++)
+      {
+        JPetSigCh sigCh(i % 2 == 0 ? JPetSigCh::Leading : JPetSigCh::Trailing, 1000.f * event + 10.f * i);
+        sigCh.setDAQch(i);
+        window.add<JPetSigCh>(sigCh);
+      }
+      writer.write(window);
+    }
+    writer.closeFile();
+    return name;
+  }();
+  return fileName;
+}
+}
+
+/// Sequential loading of the entries, as done by JPetTaskIO.
+JPET_BENCHMARK(JPetReader_nextEntry)
+{
+  JPetReader reader(getInputFile().c_str());
+  while (state.keepRunning())
+  {
+    if (!reader.nextEntry())
+    {
+      reader.firstEntry();
+    }
+    JPetBenchmark::doNotOptimize(reader.getCurrentEntry());
+  }
+}
+
+/// Loading of the entries in a random order.
+JPET_BENCHMARK(JPetReader_nthEntry)
+{
+  JPetReader reader(getInputFile().c_str());
+  long long entry = 0;
+  while (state.keepRunning())
+  {
+    entry = (entry * 7919 + 104729) % kEvents;
+    reader.nthEntry(entry);
+    JPetBenchmark::doNotOptimize(reader.getCurrentEntry());
+  }
+}
+
+/// Opening of the file and reading of all the entries, the throughput is given in events per second.
+JPET_BENCHMARK(JPetReader_readFile)
+{
+  state.setItemsPerIteration(kEvents);
+  const auto& fileName = getInputFile();
+  while (state.keepRunning())
+  {
+    JPetReader reader(fileName.c_str());
+    do
+    {
+      JPetBenchmark::doNotOptimize(reader.getCurrentEntry());
+    } while (reader.nextEntry());
+  }
+}
@@ -0,0 +1,50 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWriterBenchmark.cpp
+ */
+
+#include "JPetBenchmark/JPetBenchmark.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetWriter/JPetWriter.h"
+
+namespace
+{
+const int kSigChPerEvent = 20;
+
+void fillTimeWindow(JPetTimeWindow& window, int event)
+{
+  window.Clear();
+  for (int i = 0; i < kSigChPerEvent; i++)
+  {
+    JPetSigCh sigCh(i % 2 == 0 ? JPetSigCh::Leading : JPetSigCh::Trailing, 1000.f * event + 10.f * i);
+    sigCh.setDAQch(i);
+    sigCh.setThresholdNumber(i % 4 + 1);
+    window.add<JPetSigCh>(sigCh);
+  }
+}
+}
+
+/// Writing of a time window with kSigChPerEvent signal channels, including the flushing of the tree baskets.
+JPET_BENCHMARK(JPetWriter_writeTimeWindow)
+{
+  auto fileName = JPetBenchmark::getTemporaryFileName("writer.root");
+  JPetWriter writer(fileName.c_str());
+  JPetTimeWindow window("JPetSigCh");
+  fillTimeWindow(window, 0);
+  while (state.keepRunning())
+  {
+    writer.write(window);
+  }
+  writer.closeFile();
+}
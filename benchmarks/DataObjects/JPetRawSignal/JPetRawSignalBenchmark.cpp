@@ -0,0 +1,75 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetRawSignalBenchmark.cpp
+ */
+
+#include "JPetBenchmark/JPetBenchmark.h"
+#include "JPetRawSignal/JPetRawSignal.h"
+
+namespace
+{
+const int kThresholds = 4;
+
+JPetRawSignal createSignal()
+{
+  JPetRawSignal signal;
+  for (int thr = 1; thr <= kThresholds; thr++)
+  {
+    JPetSigCh leading(JPetSigCh::Leading, 100.f * thr);
+    leading.setThresholdNumber(thr);
+    leading.setThreshold(80.f * thr);
+    signal.addPoint(leading);
+    JPetSigCh trailing(JPetSigCh::Trailing, 5000.f - 100.f * thr);
+    trailing.setThresholdNumber(thr);
+    trailing.setThreshold(80.f * thr);
+    signal.addPoint(trailing);
+  }
+  return signal;
+}
+}
+
+JPET_BENCHMARK(JPetRawSignal_addPoints)
+{
+  JPetRawSignal signal;
+  JPetSigCh sigCh(JPetSigCh::Leading, 100.f);
+  sigCh.setThresholdNumber(1);
+  while (state.keepRunning())
+  {
+    signal.Clear();
+    for (int i = 0; i < 2 * kThresholds; i++)
+    {
+      signal.addPoint(sigCh);
+    }
+    JPetBenchmark::doNotOptimize(signal);
+  }
+}
+
+JPET_BENCHMARK(JPetRawSignal_getTimesVsThresholdNumber)
+{
+  auto signal = createSignal();
+  while (state.keepRunning())
+  {
+    auto times = signal.getTimesVsThresholdNumber(JPetSigCh::Leading);
+    JPetBenchmark::doNotOptimize(times);
+  }
+}
+
+JPET_BENCHMARK(JPetRawSignal_getTOTsVsThresholdValue)
+{
+  auto signal = createSignal();
+  while (state.keepRunning())
+  {
+    auto tots = signal.getTOTsVsThresholdValue();
+    JPetBenchmark::doNotOptimize(tots);
+  }
+}
@@ -0,0 +1,47 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSmearingFunctionsBenchmark.cpp
+ */
+
+#include "JPetBenchmark/JPetBenchmark.h"
+#include "JPetSmearingFunctions/JPetSmearingFunctions.h"
+
+JPET_BENCHMARK(JPetSmearingFunctions_addEnergySmearing)
+{
+  double energy = 0.;
+  while (state.keepRunning())
+  {
+    JPetBenchmark::doNotOptimize(JPetSmearingFunctions::addEnergySmearing(1, 0., 200. + energy));
+    energy = energy < 300. ? energy + 1. : 0.;
+  }
+}
+
+JPET_BENCHMARK(JPetSmearingFunctions_addZHitSmearing)
+{
+  double z = -20.;
+  while (state.keepRunning())
+  {
+    JPetBenchmark::doNotOptimize(JPetSmearingFunctions::addZHitSmearing(1, z, 300.));
+    z = z < 20. ? z + 0.1 : -20.;
+  }
+}
+
+JPET_BENCHMARK(JPetSmearingFunctions_addTimeSmearing)
+{
+  double time = 0.;
+  while (state.keepRunning())
+  {
+    JPetBenchmark::doNotOptimize(JPetSmearingFunctions::addTimeSmearing(1, 0., 300., time));
+    time += 1000.;
+  }
+}
@@ -0,0 +1,197 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetBenchmark.cpp
+ */
+
+#include "JPetBenchmark.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+/// Removes the files with the synthetic input data at the end of the program.
+struct TemporaryFiles
+{
+  ~TemporaryFiles()
+  {
+    boost::system::error_code ec;
+    for (const auto& fileName : fileNames)
+    {
+      boost::filesystem::remove(fileName, ec);
+    }
+  }
+  std::vector<std::string> fileNames;
+};
+}
+
+JPetBenchmarkState::JPetBenchmarkState(long long iterations) : fIterations(std::max(1LL, iterations)) {}
+
+void JPetBenchmarkState::pauseTiming() { fElapsed += Clock::now() - fStart; }
+
+void JPetBenchmarkState::resumeTiming() { fStart = Clock::now(); }
+
+double JPetBenchmarkState::getElapsedSeconds() const { return std::chrono::duration<double>(fElapsed).count(); }
+
+std::map<std::string, JPetBenchmark::Function>& JPetBenchmark::registry()
+{
+  static std::map<std::string, Function> benchmarks;
+  return benchmarks;
+}
+
+void JPetBenchmark::registerBenchmark(const std::string& name, Function function) { registry()[name] = function; }
+
+std::vector<std::string> JPetBenchmark::getNames()
+{
+  std::vector<std::string> names;
+  for (const auto& benchmark : registry())
+  {
+    names.push_back(benchmark.first);
+  }
+  return names;
+}
+
+/**
+ * The number of iterations grows (at most tenfold per step) until the run takes
+ * at least minTime seconds, then the benchmark is repeated with this number of iterations.
+ */
+JPetBenchmarkResult JPetBenchmark::run(const std::string& name, double minTime, int repetitions)
+{
+  const auto& function = registry().at(name);
+  long long iterations = 1;
+  while (true)
+  {
+    JPetBenchmarkState state(iterations);
+    function(state);
+    double elapsed = state.getElapsedSeconds();
+    if (elapsed >= minTime || iterations >= (1LL << 40))
+    {
+      break;
+    }
+    double factor = elapsed > 0.0 ? 1.4 * minTime / elapsed : 10.0;
+    iterations = static_cast<long long>(iterations * std::min(10.0, std::max(2.0, factor)));
+  }
+
+  std::vector<double> nsPerOp;
+  double itemsPerIteration = 1.0;
+  for (int i = 0; i < std::max(1, repetitions); i++)
+  {
+    JPetBenchmarkState state(iterations);
+    function(state);
+    nsPerOp.push_back(state.getElapsedSeconds() * 1e9 / iterations);
+    itemsPerIteration = state.getItemsPerIteration();
+  }
+  std::sort(nsPerOp.begin(), nsPerOp.end());
+
+  JPetBenchmarkResult result;
+  result.name = name;
+  result.iterations = iterations;
+  result.repetitions = nsPerOp.size();
+  result.nsPerOp = nsPerOp[nsPerOp.size() / 2];
+  result.minNsPerOp = nsPerOp.front();
+  result.maxNsPerOp = nsPerOp.back();
+  result.itemsPerSecond = result.nsPerOp > 0.0 ? itemsPerIteration * 1e9 / result.nsPerOp : 0.0;
+  return result;
+}
+
+std::string JPetBenchmark::toJSON(const std::vector<JPetBenchmarkResult>& results)
+{
+  std::ostringstream out;
+  out << std::setprecision(10);
+  out << "{\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); i++)
+  {
+    const auto& result = results[i];
+    out << (i > 0 ? "," : "") << "\n    {";
+    out << "\"name\": \"" << result.name << "\", ";
+    out << "\"iterations\": " << result.iterations << ", ";
+    out << "\"repetitions\": " << result.repetitions << ", ";
+    out << "\"ns_per_op\": " << result.nsPerOp << ", ";
+    out << "\"min_ns_per_op\": " << result.minNsPerOp << ", ";
+    out << "\"max_ns_per_op\": " << result.maxNsPerOp << ", ";
+    out << "\"items_per_second\": " << result.itemsPerSecond << "}";
+  }
+  out << "\n  ]\n}\n";
+  return out.str();
+}
+
+bool JPetBenchmark::readJSON(const std::string& fileName, std::map<std::string, JPetBenchmarkResult>& results)
+{
+  boost::property_tree::ptree tree;
+  try
+  {
+    boost::property_tree::read_json(fileName, tree);
+    for (const auto& node : tree.get_child("benchmarks"))
+    {
+      JPetBenchmarkResult result;
+      result.name = node.second.get<std::string>("name");
+      result.iterations = node.second.get<long long>("iterations", 0);
+      result.repetitions = node.second.get<int>("repetitions", 0);
+      result.nsPerOp = node.second.get<double>("ns_per_op");
+      result.minNsPerOp = node.second.get<double>("min_ns_per_op", result.nsPerOp);
+      result.maxNsPerOp = node.second.get<double>("max_ns_per_op", result.nsPerOp);
+      result.itemsPerSecond = node.second.get<double>("items_per_second", 0.0);
+      results[result.name] = result;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Unable to read the benchmark results from " << fileName << ": " << e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Print the change of the time per operation with respect to the baseline.
+ *
+ * @return false if any benchmark is slower than the baseline by more than the tolerance (e.g. 0.1 for 10%)
+ */
+bool JPetBenchmark::compare(const std::vector<JPetBenchmarkResult>& results, const std::map<std::string, JPetBenchmarkResult>& baseline,
+                            double tolerance)
+{
+  bool isOK = true;
+  std::printf("%-50s %14s %14s %9s\n", "benchmark", "baseline ns/op", "ns/op", "change");
+  for (const auto& result : results)
+  {
+    auto found = baseline.find(result.name);
+    if (found == baseline.end() || found->second.nsPerOp <= 0.0)
+    {
+      std::printf("%-50s %14s %14.1f %9s\n", result.name.c_str(), "-", result.nsPerOp, "new");
+      continue;
+    }
+    double change = result.nsPerOp / found->second.nsPerOp - 1.0;
+    bool isRegression = change > tolerance;
+    std::printf("%-50s %14.1f %14.1f %+8.1f%%%s\n", result.name.c_str(), found->second.nsPerOp, result.nsPerOp, 100.0 * change,
+                isRegression ? "  REGRESSION" : "");
+    isOK = isOK && !isRegression;
+  }
+  return isOK;
+}
+
+/**
+ * Unique name of a file in the temporary directory, removed at the end of the program.
+ */
+std::string JPetBenchmark::getTemporaryFileName(const std::string& name)
+{
+  static TemporaryFiles files;
+  auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("jpetbench-%%%%%%%%-" + name);
+  files.fileNames.push_back(path.string());
+  return path.string();
+}
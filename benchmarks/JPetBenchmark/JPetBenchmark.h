@@ -0,0 +1,130 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetBenchmark.h
+ */
+
+#ifndef JPETBENCHMARK_H
+#define JPETBENCHMARK_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief State of a single benchmark run, passed to the benchmark function
+ *
+ * The function repeats the measured operation in the loop:
+ *   while (state.keepRunning()) { ... }
+ * and may exclude the preparation of the input from the measured time
+ * with pauseTiming()/resumeTiming(). If a single operation processes more
+ * than one item (e.g. events of a file), it is set with setItemsPerIteration(),
+ * so that the throughput is reported in items per second.
+ */
+class JPetBenchmarkState
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit JPetBenchmarkState(long long iterations);
+  bool keepRunning()
+  {
+    if (fDone < fIterations)
+    {
+      if (fDone++ == 0)
+      {
+        fStart = Clock::now();
+      }
+      return true;
+    }
+    fElapsed += Clock::now() - fStart;
+    return false;
+  }
+  void pauseTiming();
+  void resumeTiming();
+  void setItemsPerIteration(double items) { fItemsPerIteration = items; }
+  long long getIterations() const { return fIterations; }
+  double getItemsPerIteration() const { return fItemsPerIteration; }
+  double getElapsedSeconds() const;
+
+private:
+  long long fIterations = 1;
+  long long fDone = 0;
+  double fItemsPerIteration = 1.0;
+  Clock::time_point fStart;
+  Clock::duration fElapsed = Clock::duration::zero();
+};
+
+/**
+ * @brief Result of a benchmark: the median of the repetitions
+ */
+struct JPetBenchmarkResult
+{
+  std::string name;
+  long long iterations = 0;
+  int repetitions = 0;
+  double nsPerOp = 0.0;
+  double minNsPerOp = 0.0;
+  double maxNsPerOp = 0.0;
+  double itemsPerSecond = 0.0;
+};
+
+/**
+ * @brief Registry and runner of the benchmarks
+ *
+ * Benchmarks are registered with the JPET_BENCHMARK macro. The number of iterations
+ * is increased until a single repetition takes at least the minimal time, then the
+ * benchmark is repeated and the median time per operation is reported. The results
+ * are written in the JSON format and can be compared with a baseline file written
+ * earlier in the same format.
+ */
+class JPetBenchmark
+{
+public:
+  using Function = std::function<void(JPetBenchmarkState&)>;
+
+  static void registerBenchmark(const std::string& name, Function function);
+  static std::vector<std::string> getNames();
+  static JPetBenchmarkResult run(const std::string& name, double minTime, int repetitions);
+  static std::string toJSON(const std::vector<JPetBenchmarkResult>& results);
+  static bool readJSON(const std::string& fileName, std::map<std::string, JPetBenchmarkResult>& results);
+  static bool compare(const std::vector<JPetBenchmarkResult>& results, const std::map<std::string, JPetBenchmarkResult>& baseline,
+                      double tolerance);
+  static std::string getTemporaryFileName(const std::string& name);
+
+  /// Prevents the compiler from optimizing out the computation of the value.
+  template <class T>
+  static void doNotOptimize(const T& value)
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+private:
+  static std::map<std::string, Function>& registry();
+};
+
+struct JPetBenchmarkRegistration
+{
+  JPetBenchmarkRegistration(const std::string& name, JPetBenchmark::Function function)
+  {
+    JPetBenchmark::registerBenchmark(name, function);
+  }
+};
+
+#define JPET_BENCHMARK(NAME)                                                         \
+  static void NAME(JPetBenchmarkState& state);                                       \
+  static JPetBenchmarkRegistration NAME##Registration(#NAME, NAME);                  \
+  static void NAME(JPetBenchmarkState& state)
+
+#endif /* !JPETBENCHMARK_H */
@@ -0,0 +1,100 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetBenchmarkMain.cpp
+ */
+
+#include "JPetBenchmark.h"
+
+#include <boost/program_options.hpp>
+#include <boost/regex.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+int main(int argc, char** argv)
+{
+  po::options_description description("Allowed options");
+  description.add_options()("help,h", "Produce help message")("list,l", "List the benchmarks")(
+    "filter,f", po::value<std::string>()->default_value(".*"), "Regular expression selecting the benchmarks to run")(
+    "min_time", po::value<double>()->default_value(0.5), "Minimal time of a single repetition [s]")(
+    "repetitions,r", po::value<int>()->default_value(5), "Number of repetitions, the median is reported")(
+    "output,o", po::value<std::string>(), "File for the results in the JSON format")(
+    "baseline,b", po::value<std::string>(), "JSON file with the results to compare with")(
+    "tolerance,t", po::value<double>()->default_value(0.1), "Accepted relative increase of the time per operation");
+
+  po::variables_map variables;
+  try
+  {
+    po::store(po::parse_command_line(argc, argv, description), variables);
+    po::notify(variables);
+  }
+  catch (const po::error& e)
+  {
+    std::cerr << e.what() << std::endl << description << std::endl;
+    return 2;
+  }
+  if (variables.count("help"))
+  {
+    std::cout << description << std::endl;
+    return 0;
+  }
+  if (variables.count("list"))
+  {
+    for (const auto& name : JPetBenchmark::getNames())
+    {
+      std::cout << name << std::endl;
+    }
+    return 0;
+  }
+
+  boost::regex filter(variables["filter"].as<std::string>());
+  std::vector<JPetBenchmarkResult> results;
+  std::printf("%-50s %14s %14s %16s\n", "benchmark", "iterations", "ns/op", "items/s");
+  for (const auto& name : JPetBenchmark::getNames())
+  {
+    if (!boost::regex_search(name, filter))
+    {
+      continue;
+    }
+    auto result = JPetBenchmark::run(name, variables["min_time"].as<double>(), variables["repetitions"].as<int>());
+    std::printf("%-50s %14lld %14.1f %16.1f\n", result.name.c_str(), result.iterations, result.nsPerOp, result.itemsPerSecond);
+    std::fflush(stdout);
+    results.push_back(result);
+  }
+
+  if (variables.count("output"))
+  {
+    std::ofstream out(variables["output"].as<std::string>());
+    out << JPetBenchmark::toJSON(results);
+    if (!out)
+    {
+      std::cerr << "Unable to write the results to " << variables["output"].as<std::string>() << std::endl;
+      return 2;
+    }
+  }
+  if (variables.count("baseline"))
+  {
+    std::map<std::string, JPetBenchmarkResult> baseline;
+    if (!JPetBenchmark::readJSON(variables["baseline"].as<std::string>(), baseline))
+    {
+      return 2;
+    }
+    if (!JPetBenchmark::compare(results, baseline, variables["tolerance"].as<double>()))
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSyntheticParamGetter.cpp
+ */
+
+#include "JPetSyntheticParamGetter.h"
+
+#include <numeric>
+
+JPetSyntheticParamGetter::JPetSyntheticParamGetter(const std::vector<int>& slotsInLayers) : fSlotsInLayers(slotsInLayers) {}
+
+int JPetSyntheticParamGetter::getNumberOfSlots() const { return std::accumulate(fSlotsInLayers.begin(), fSlotsInLayers.end(), 0); }
+
+/**
+ * Slots, scintillators and PMs are numbered from 1 layer by layer,
+ * PM 2*slot-1 is on side A and PM 2*slot on side B.
+ */
+ParamObjectsDescriptions JPetSyntheticParamGetter::getAllBasicData(ParamObjectType type, const int)
+{
+  ParamObjectsDescriptions result;
+  const int nSlots = getNumberOfSlots();
+  switch (type)
+  {
+  case kTRB:
+    result[1] = {{"id", "1"}, {"type", "1"}, {"channel", "1"}};
+    break;
+  case kFEB:
+    result[1] = {{"id", "1"},          {"active", "1"},      {"status", "ok"}, {"description", "synthetic"},
+                 {"version", "1"},     {"creator_id", "1"},  {"time_outputs_per_input", "2"},
+                 {"no_time_outputs_per_input", "1"}};
+    break;
+  case kFrame:
+    result[1] = {{"id", "1"}, {"active", "1"}, {"status", "ok"}, {"description", "synthetic"}, {"version", "1"}, {"creator_id", "1"}};
+    break;
+  case kLayer:
+    for (std::size_t layer = 1; layer <= fSlotsInLayers.size(); layer++)
+    {
+      result[layer] = {{"id", std::to_string(layer)}, {"active", "1"}, {"name", "Layer" + std::to_string(layer)},
+                       {"radius", std::to_string(40.0 + 10.0 * layer)}};
+    }
+    break;
+  case kBarrelSlot:
+  {
+    int slot = 1;
+    for (auto slotsInLayer : fSlotsInLayers)
+    {
+      for (int i = 0; i < slotsInLayer; i++, slot++)
+      {
+        result[slot] = {{"id", std::to_string(slot)}, {"active", "1"}, {"name", "Slot" + std::to_string(slot)},
+                        {"theta1", std::to_string(360.0 * i / slotsInLayer)}, {"frame_id", std::to_string(i + 1)}};
+      }
+    }
+    break;
+  }
+  case kScintillator:
+    for (int slot = 1; slot <= nSlots; slot++)
+    {
+      result[slot] = {{"id", std::to_string(slot)}, {"attenuation_length", "0"}, {"length", "500"}, {"width", "19"}, {"height", "7"}};
+    }
+    break;
+  case kPM:
+    for (int pm = 1; pm <= 2 * nSlots; pm++)
+    {
+      result[pm] = {{"id", std::to_string(pm)}, {"is_right_side", pm % 2 == 0 ? "1" : "0"}, {"description", "synthetic"}};
+    }
+    break;
+  case kTOMBChannel:
+    for (int channel = 1; channel <= getNumberOfTOMBChannels(); channel++)
+    {
+      int threshold = (channel - 1) % kThresholds + 1;
+      result[channel] = {{"channel", std::to_string(channel)}, {"local_number", std::to_string(threshold)},
+                         {"FEB", "1"}, {"threshold", std::to_string(80.0 * threshold)}};
+    }
+    break;
+  default:
+    break;
+  }
+  return result;
+}
+
+ParamRelationalData JPetSyntheticParamGetter::getAllRelationalData(ParamObjectType type1, ParamObjectType type2, const int)
+{
+  ParamRelationalData result;
+  const int nSlots = getNumberOfSlots();
+  if (type1 == kFEB && type2 == kTRB)
+  {
+    result[1] = 1;
+  }
+  else if (type1 == kLayer && type2 == kFrame)
+  {
+    for (std::size_t layer = 1; layer <= fSlotsInLayers.size(); layer++)
+    {
+      result[layer] = 1;
+    }
+  }
+  else if (type1 == kBarrelSlot && type2 == kLayer)
+  {
+    int slot = 1;
+    for (std::size_t layer = 1; layer <= fSlotsInLayers.size(); layer++)
+    {
+      for (int i = 0; i < fSlotsInLayers[layer - 1]; i++, slot++)
+      {
+        result[slot] = layer;
+      }
+    }
+  }
+  else if (type1 == kScintillator && type2 == kBarrelSlot)
+  {
+    for (int slot = 1; slot <= nSlots; slot++)
+    {
+      result[slot] = slot;
+    }
+  }
+  else if (type1 == kPM && (type2 == kFEB || type2 == kScintillator || type2 == kBarrelSlot))
+  {
+    for (int pm = 1; pm <= 2 * nSlots; pm++)
+    {
+      result[pm] = type2 == kFEB ? 1 : (pm + 1) / 2;
+    }
+  }
+  else if (type1 == kTOMBChannel && (type2 == kFEB || type2 == kTRB || type2 == kPM))
+  {
+    for (int channel = 1; channel <= getNumberOfTOMBChannels(); channel++)
+    {
+      result[channel] = type2 == kPM ? (channel - 1) / kThresholds + 1 : 1;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,45 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSyntheticParamGetter.h
+ */
+
+#ifndef JPETSYNTHETICPARAMGETTER_H
+#define JPETSYNTHETICPARAMGETTER_H
+
+#include "JPetParamGetter/JPetParamGetter.h"
+#include <vector>
+
+/**
+ * @brief Parameter getter generating the setup of a barrel detector in memory
+ *
+ * Every layer contains the given number of slots, every slot one scintillator
+ * read out by two PMs (side A and B), and every PM has kThresholds TOMB channels.
+ * All PMs are connected to a single FEB and TRB. The TOMB channel numbers
+ * are consecutive, starting from 1.
+ */
+class JPetSyntheticParamGetter: public JPetParamGetter
+{
+public:
+  static const int kThresholds = 4;
+
+  explicit JPetSyntheticParamGetter(const std::vector<int>& slotsInLayers = {48, 48, 96});
+  ParamObjectsDescriptions getAllBasicData(ParamObjectType type, const int runId) override;
+  ParamRelationalData getAllRelationalData(ParamObjectType type1, ParamObjectType type2, const int runId) override;
+  int getNumberOfSlots() const;
+  int getNumberOfTOMBChannels() const { return getNumberOfSlots() * 2 * kThresholds; }
+
+private:
+  std::vector<int> fSlotsInLayers;
+};
+
+#endif /* !JPETSYNTHETICPARAMGETTER_H */
@@ -0,0 +1,41 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamManagerBenchmark.cpp
+ */
+
+#include "JPetBenchmark/JPetBenchmark.h"
+#include "JPetBenchmark/JPetSyntheticParamGetter.h"
+#include "JPetParamManager/JPetParamManager.h"
+
+/// Filling of the bank from the parameter objects already created by the factories.
+JPET_BENCHMARK(JPetParamManager_fillParameterBank)
+{
+  JPetParamManager manager(new JPetSyntheticParamGetter());
+  manager.fillParameterBank(1);
+  while (state.keepRunning())
+  {
+    manager.fillParameterBank(1);
+    JPetBenchmark::doNotOptimize(manager.getParamBank());
+  }
+}
+
+/// Creation of all parameter objects from their descriptions and filling of the bank.
+JPET_BENCHMARK(JPetParamManager_fillParameterBankFromDescriptions)
+{
+  while (state.keepRunning())
+  {
+    JPetParamManager manager(new JPetSyntheticParamGetter());
+    manager.fillParameterBank(1);
+    JPetBenchmark::doNotOptimize(manager.getParamBank());
+  }
+}
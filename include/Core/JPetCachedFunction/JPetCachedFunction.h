@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 namespace  jpet_common_tools
 {
@@ -41,6 +42,52 @@ struct JPetCachedFunctionParams {
   bool fValidFunction = false;
 };
 
+/**
+ * @brief Persistent, content-addressed storage of tabulated function values.
+ *
+ * The lookup tables of JPetCachedFunction1D/2D are identified by the formula,
+ * the parameter values and the sampling ranges. If the cache directory is set,
+ * a table computed once is stored in that directory and later constructions of
+ * the same function map the stored file instead of evaluating TFormula again.
+ * The cache is disabled by default (empty directory). setCacheDirectory() sets the directory
+ * for the whole process, while DirectoryScope overrides it only in the current thread.
+ * In the framework JPetTaskIO uses DirectoryScope during the run of its subtasks if the
+ * user option JPetCachedFunction_CacheDirectory_std::string is given, so the tasks of
+ * different input files can use different directories.
+ */
+class JPetCachedFunctionStore
+{
+public:
+  /// Overrides the cache directory in the current thread, the previous one is restored in the destructor.
+  class DirectoryScope
+  {
+  public:
+    explicit DirectoryScope(const std::string& dir);
+    ~DirectoryScope();
+    DirectoryScope(const DirectoryScope&) = delete;
+    DirectoryScope& operator=(const DirectoryScope&) = delete;
+
+  private:
+    std::string fDirectory;
+    const std::string* fPreviousDirectory = nullptr;
+  };
+
+  static void setCacheDirectory(const std::string& dir);
+  static std::string getCacheDirectory();
+  static bool isEnabled();
+
+  /// Canonical, human readable description of the table content used as the cache key.
+  static std::string generateKey(const JPetCachedFunctionParams& params, const std::vector<Range>& ranges);
+  /// Name of the file in the cache directory corresponding to the given key.
+  static std::string generateFileName(const std::string& key);
+  /// Returns true if the table with exactly expectedSize values was found and loaded into values.
+  static bool load(const std::string& key, std::size_t expectedSize, std::vector<double>& values);
+  static bool save(const std::string& key, const std::vector<double>& values);
+
+private:
+  static std::uint64_t hash(const std::string& key);
+};
+
 /**
  * @brief  Class represent function of TFormula type with the cached values
  *
@@ -48,6 +95,8 @@ struct JPetCachedFunctionParams {
  * The classes JPetCachedFunction1D and JPetCachedFunction2D correspond to  func(x,p0,p1,...) 
  * and func(x,y, p0,p1, ...) implementations.
  * Base class JPetCachedFunction is not ment to be created separately.
+ * If JPetCachedFunctionStore::setCacheDirectory() was called, the tables are
+ * read from and written to the persistent cache.
  * 
  */
 class JPetCachedFunction
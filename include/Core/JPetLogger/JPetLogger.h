@@ -24,9 +24,12 @@
 #include <string>
 
 #ifndef __CINT__
+#include <atomic>
 #include <boost/log/attributes/attribute_cast.hpp>
 #include <boost/log/core.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
+#include <mutex>
 #include <boost/log/trivial.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/utility/setup/file.hpp>
@@ -39,6 +42,12 @@
  * Don't use directly, rather by including JPetLoggerInclude.h
  * and using macros from there. It is wrapper for Boost.Log
  * that is multithread safe and implements own formatter.
+ *
+ * The records are passed through the lock-free queue of the asynchronous sink
+ * and formatted and written to the file by its dedicated thread, so the logging
+ * threads never wait for the disk. The queue is flushed at the exit of the program,
+ * on std::terminate and with flush(). The records below the minimal level are
+ * rejected by the macros with a single atomic load, before any Boost.Log call.
  */
 
 class JPetLogger {
@@ -60,10 +69,17 @@ public:
 
   static void formatter(boost::log::record_view const& rec, boost::log::formatting_ostream& out_stream);
 
-  static void setLogLevel(boost::log::trivial::severity_level level) {
+  static void setLogLevel(boost::log::trivial::severity_level level)
+  {
+    sMinimalLevel.store(level, std::memory_order_relaxed);
     JPetLogger::getInstance().sink->set_filter(boost::log::trivial::severity >= level);
+    boost::log::core::get()->set_filter(boost::log::trivial::severity >= level);
   }
 
+  static bool isLevelEnabled(int level) { return level >= sMinimalLevel.load(std::memory_order_relaxed); }
+
+  static void flush();
+
   static JPetLogger& getInstance()
   {
     static JPetLogger logger;
@@ -72,7 +88,9 @@ public:
 
   static void setThreadsEnabled(bool value) { JPetLogger::getInstance().isThreadsEnabled = value; }
 
-  static void setRotationSize(unsigned int value) { JPetLogger::getInstance().backend->set_rotation_size(value); }
+  static void setRotationSize(unsigned int value) { JPetLogger::getInstance().sink->locked_backend()->set_rotation_size(value); }
+
+  ~JPetLogger();
 #else
   void getSeverity();
   void formatter();
@@ -88,11 +106,20 @@ private:
 
 #ifndef __CINT__
   void init();
+  static void onTerminate();
   boost::shared_ptr<JPetTextFileBackend> backend;
-  typedef boost::log::sinks::synchronous_sink<JPetTextFileBackend> sink_t;
+  typedef boost::log::sinks::asynchronous_sink<JPetTextFileBackend> sink_t;
   boost::shared_ptr<sink_t> sink;
 
   bool isThreadsEnabled = false;
+
+  /// state of the suppression of the repeated messages, used by the formatter
+  std::mutex fRepetitionMutex;
+  std::string fLastMessage;
+  unsigned int fNumberOfRepetitions = 0u;
+
+  static std::atomic<int> sMinimalLevel;
+  static std::terminate_handler sPreviousTerminateHandler;
 #endif
 };
 
@@ -37,12 +37,29 @@
  * See: http://www.cs.technion.ac.il/users/yechiel/c++-faq/macros-with-multi-stmts.html
  */
 #define CUSTOM_LOG(logger, sev, X)                                                                                                                   \
-  if (true) {                                                                                                                                        \
+  if (JPetLogger::isLevelEnabled(sev)) {                                                                                                             \
     BOOST_LOG_SEV(logger, sev) << boost::log::add_value("Line", __LINE__) << boost::log::add_value("File", __FILE__)                                 \
                                << boost::log::add_value("Function", __func__) << X;                                                                  \
   } else                                                                                                                                             \
     (void)0
 
+/* The messages below JPET_LOG_MIN_LEVEL (value of boost::log::trivial::severity_level)
+ * are removed at the compilation time, together with the evaluation of their arguments.
+ * By default DEBUG is removed from the builds with NDEBUG defined (e.g. Release).
+ */
+#ifndef JPET_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define JPET_LOG_MIN_LEVEL 2
+#else
+#define JPET_LOG_MIN_LEVEL 1
+#endif
+#endif
+
+#define JPET_STRIPPED_LOG(X)                                                                                                                         \
+  if (true) {                                                                                                                                        \
+  } else                                                                                                                                             \
+    (void)0
+
 /* To log information you should use macros INFO(X), WARNING(X), ERROR(X), DEBUG(X) or
  * if you want to provie your own level of sevarity of message use macro LOG(X, sev).
  *
@@ -66,10 +83,22 @@
  * And then use it as LOG("Log message", critical);
  *
  */
+#if JPET_LOG_MIN_LEVEL <= 2
 #define INFO(X) CUSTOM_LOG(JPetLogger::getSeverity(), boost::log::trivial::info, X)
+#else
+#define INFO(X) JPET_STRIPPED_LOG(X)
+#endif
+#if JPET_LOG_MIN_LEVEL <= 3
 #define WARNING(X) CUSTOM_LOG(JPetLogger::getSeverity(), boost::log::trivial::warning, X)
+#else
+#define WARNING(X) JPET_STRIPPED_LOG(X)
+#endif
 #define ERROR(X) CUSTOM_LOG(JPetLogger::getSeverity(), boost::log::trivial::error, X)
+#if JPET_LOG_MIN_LEVEL <= 1
 #define DEBUG(X) CUSTOM_LOG(JPetLogger::getSeverity(), boost::log::trivial::debug, X)
+#else
+#define DEBUG(X) JPET_STRIPPED_LOG(X)
+#endif
 
 #define LOG(X, sev) CUSTOM_LOG(JPetLogger::getSevarity(), sev, X)
 
@@ -86,4 +115,6 @@
 
 #define ENABLE_THREADS_INFO(value) JPetLogger::setThreadsEnabled(value)
 
+#define FLUSH_LOG() JPetLogger::flush()
+
 #endif /* !JPETLOGGER_INCLUDE_H */
@@ -113,10 +113,30 @@ private:
    **/
   void checkDisableLogRotation(const std::map<std::string, boost::any>& opts);
 
+  /**
+   * @brief Enables the thread safety of ROOT if the tasks are executed in several threads
+   *
+   * It must be done before any ROOT object (e.g. TFile or TTree) is created, so it is done
+   * before the tasks are started if the threads are enabled or the stages of the fused tasks
+   * are pipelined (JPetFusedTaskIO_Pipeline_bool).
+   **/
+  void checkEnableThreadSafety(const std::map<std::string, boost::any>& opts);
+
+  /**
+   * @brief Starts the recording of the timeline if requested
+   *
+   * If JPetManager_TraceFile_std::string is set, the execution of the tasks, subtasks,
+   * reading, writing and parameter loading is recorded with JPetTracer and saved
+   * in the given file in the Chrome trace format at the end of the processing.
+   * @return name of the trace file or empty string if the recording is off
+   **/
+  std::string startTracing(const std::map<std::string, boost::any>& opts);
+
   JPetManager();
   bool fThreadsEnabled = false;
   jpet_task_factory::JPetTaskFactory fTaskFactory;
   const std::string kUseTasksFromParamsKey = "JPetManager_useTasks_std::vector<std::string>";
   const std::string kDisableLogRotation = "JPetManager_DisableLogRotation_bool";
+  const std::string kTraceFileKey = "JPetManager_TraceFile_std::string";
 };
 #endif /* !JPETMANAGER_H */
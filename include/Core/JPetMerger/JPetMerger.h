@@ -0,0 +1,84 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetMerger.h
+ */
+
+#ifndef JPETMERGER_H
+#define JPETMERGER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class JPetParamBank;
+class JPetTreeHeader;
+class TDirectory;
+class TFile;
+class TObject;
+
+/**
+ * @brief Merges the output files of the framework, e.g. the shards of the data processed separately
+ *
+ * In contrast to ROOT's hadd, the merger understands the content of the J-PET files:
+ * - the trees with the time windows are concatenated without unpacking the entries,
+ *   the shards (see the -s option) are ordered by their index, so the merged tree keeps
+ *   the order of the original data, the other files are taken in the given order,
+ * - the tree headers must have the same processing history, the merged header gets the
+ *   history of the first file and the shard information is removed,
+ * - the histograms and other mergeable objects in the statistics directories are summed,
+ *   the objects which cannot be merged (e.g. TCanvas) are taken from the first file,
+ * - the parameter banks must contain the same objects and only one is written,
+ * - the window indices (see JPetWindowIndex) are concatenated like the trees, if all files contain them.
+ * The statistics and the parameter banks of the input files are read in parallel.
+ */
+class JPetMerger
+{
+public:
+  explicit JPetMerger(unsigned int numberOfThreads = 1);
+  bool merge(const std::vector<std::string>& inputFiles, const std::string& outputFile);
+
+  static bool parseShard(const JPetTreeHeader& header, int& shardIndex, int& numberOfShards);
+  static bool areSameHistories(const JPetTreeHeader& first, const JPetTreeHeader& second);
+  static bool areSameParamBanks(const JPetParamBank& first, const JPetParamBank& second);
+  static bool mergeObject(TObject* target, TObject* source);
+
+protected:
+  /// Objects of the statistics directories detached from the files, the structure of the directories is kept
+  struct Statistics
+  {
+    std::map<std::string, std::unique_ptr<TObject>> fObjects;
+    std::map<std::string, std::unique_ptr<Statistics>> fDirectories;
+  };
+
+  struct Input
+  {
+    std::string fFileName;
+    std::unique_ptr<JPetTreeHeader> fHeader;
+    std::unique_ptr<JPetParamBank> fParamBank;
+    int fShardIndex = -1;
+    int fNumberOfShards = 0;
+  };
+
+  bool readInput(Input& input, Statistics& statistics);
+  bool sortInputs(std::vector<Input>& inputs) const;
+  static void readDirectory(TDirectory& directory, Statistics& statistics, bool isTopDirectory);
+  static void addObject(Statistics& statistics, const std::string& name, std::unique_ptr<TObject> object);
+  static void mergeStatistics(Statistics& target, Statistics& source);
+  static void writeStatistics(TDirectory& directory, const Statistics& statistics);
+  bool mergeTrees(const std::vector<Input>& inputs, const std::string& outputFile, const Statistics& statistics);
+  static void mergeIndexTrees(const std::vector<Input>& inputs, TFile& output, long long numberOfEntries);
+
+  unsigned int fNumberOfThreads = 1;
+};
+#endif /* !JPETMERGER_H */
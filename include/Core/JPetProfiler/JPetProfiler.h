@@ -0,0 +1,117 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetProfiler.h
+ */
+
+#ifndef JPETPROFILER_H
+#define JPETPROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Time spent in the processing stages of a single (sub)task
+ *
+ * Every measurement of a stage is added to the total time of the stage and to its
+ * latency histogram with logarithmic bins (kBinsPerDecade bins per decade from 10 ns
+ * to 100 s), from which the quantiles are estimated. The per-event stages are
+ * reading of the entry, execution of the user task, writing of the output and
+ * the whole event (kEvent); the number of kEvent measurements is the number of
+ * processed events. The steady clock is used, so the measurements are not affected
+ * by the changes of the system time.
+ */
+class JPetProfiler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum Stage
+  {
+    kInit,
+    kRun,
+    kTerminate,
+    kRead,
+    kExec,
+    kWrite,
+    kEvent,
+    kNumberOfStages
+  };
+
+  static const int kBinsPerDecade = 10;
+  static const int kNumberOfBins = 10 * kBinsPerDecade;
+  static const double kMinLatency;
+
+  struct StageStatistics
+  {
+    long long count = 0;
+    double totalSeconds = 0.0;
+    double minSeconds = 0.0;
+    double maxSeconds = 0.0;
+    /// under- and overflow in the first and last element
+    std::array<std::uint64_t, kNumberOfBins + 2> histogram{};
+  };
+
+  /**
+   * @brief Measures the time from the construction to the destruction, if the profiler is set
+   */
+  class Scope
+  {
+  public:
+    Scope(JPetProfiler* profiler, Stage stage) : fProfiler(profiler), fStage(stage)
+    {
+      if (fProfiler)
+      {
+        fStart = Clock::now();
+      }
+    }
+    ~Scope()
+    {
+      if (fProfiler)
+      {
+        fProfiler->add(fStage, Clock::now() - fStart);
+      }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    JPetProfiler* fProfiler;
+    Stage fStage;
+    Clock::time_point fStart;
+  };
+
+  explicit JPetProfiler(const std::string& name = "");
+  void add(Stage stage, Clock::duration duration);
+  void add(Stage stage, double seconds);
+  void reset();
+
+  const std::string& getName() const { return fName; }
+  const StageStatistics& getStage(Stage stage) const { return fStages[stage]; }
+  long long getNumberOfEvents() const { return fStages[kEvent].count; }
+  double getThroughput() const;
+  double getQuantile(Stage stage, double quantile) const;
+  std::string toJSON() const;
+
+  static const char* getStageName(Stage stage);
+  static std::vector<double> getBinEdges();
+  static int getBin(double seconds);
+
+private:
+  std::string fName;
+  std::array<StageStatistics, kNumberOfStages> fStages;
+};
+
+#endif /* !JPETPROFILER_H */
@@ -16,15 +16,35 @@
 #ifndef JPETPROGRESSBARMANAGER_H
 #define JPETPROGRESSBARMANAGER_H
 
+#include "./JPetProgressBarManager/JPetProgressReporter.h"
+#include <memory>
 #include <string>
 
 /**
  * @brief Class managing the progress bar used in while processing events.
+ *
+ * Between startJob() and finishJob() the progress passed to update() is only stored
+ * in an atomic counter and displayed by JPetProgressReporter at a fixed interval,
+ * together with the progress of the other jobs running in parallel.
+ * display() prints the progress immediately.
  */
 class JPetProgressBarManager
 {
 public:
+  ~JPetProgressBarManager();
+  void startJob(const std::string& name, long long numberOfEvents);
+  void update(long long processedEvents)
+  {
+    if (fJob)
+    {
+      fJob->update(processedEvents);
+    }
+  }
+  void finishJob();
   void display(const std::string& taskName, long long currentEventNumber, long long numberOfEvents) const;
   float getCurrentValue(int currentEventNumber, int numberOfEvents) const;
+
+private:
+  std::shared_ptr<JPetProgressReporter::Job> fJob;
 };
 #endif /* !JPETPROGRESSBARMANAGER_H */
@@ -0,0 +1,98 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetProgressReporter.h
+ */
+
+#ifndef JPETPROGRESSREPORTER_H
+#define JPETPROGRESSREPORTER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Progress of all the jobs (e.g. files processed by the parallel chains) in a single line
+ *
+ * The event loop only stores the number of processed events in the atomic counter
+ * of its job. The line with the progress, the rate in events per second and
+ * the estimated remaining time of every job, as well as the aggregated rate, is rendered
+ * by a single background thread every fInterval. The thread runs only while
+ * there are registered jobs.
+ */
+class JPetProgressReporter
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  class Job
+  {
+  public:
+    Job(const std::string& name, long long numberOfEvents);
+    void update(long long processedEvents) { fProcessed.store(processedEvents, std::memory_order_relaxed); }
+    long long getProcessed() const { return fProcessed.load(std::memory_order_relaxed); }
+    const std::string& getName() const { return fName; }
+    long long getNumberOfEvents() const { return fNumberOfEvents; }
+    double getRate() const { return fRate; }
+
+  private:
+    friend class JPetProgressReporter;
+    std::string fName;
+    long long fNumberOfEvents;
+    std::atomic<long long> fProcessed{0};
+    std::atomic<bool> fIsFinished{false};
+    /// updated only by the rendering thread
+    long long fLastProcessed = 0;
+    Clock::time_point fLastTime;
+    double fRate = 0.0;
+  };
+
+  static JPetProgressReporter& getInstance();
+  ~JPetProgressReporter();
+  std::shared_ptr<Job> startJob(const std::string& name, long long numberOfEvents);
+  void finishJob(const std::shared_ptr<Job>& job);
+  void waitUntilIdle();
+  void setInterval(std::chrono::milliseconds interval);
+  void setOutput(std::ostream* output);
+  std::string render(Clock::time_point now);
+
+  static std::string formatRate(double eventsPerSecond);
+  static std::string formatDuration(double seconds);
+
+  static const std::chrono::milliseconds kDefaultInterval;
+
+private:
+  JPetProgressReporter() = default;
+  JPetProgressReporter(const JPetProgressReporter&) = delete;
+  JPetProgressReporter& operator=(const JPetProgressReporter&) = delete;
+  std::string renderLocked(Clock::time_point now);
+  void loop();
+
+  std::mutex fMutex;
+  std::condition_variable fCondition;
+  std::vector<std::shared_ptr<Job>> fJobs;
+  std::thread fThread;
+  bool fIsRunning = false;
+  bool fIsStopping = false;
+  bool fIsWakeUpRequested = false;
+  std::chrono::milliseconds fInterval = kDefaultInterval;
+  std::ostream* fOutput = nullptr;
+  std::size_t fLastLineLength = 0;
+};
+
+#endif /* !JPETPROGRESSREPORTER_H */
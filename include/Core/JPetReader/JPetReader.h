@@ -53,6 +53,7 @@ public:
   virtual bool nthEntry(long long n) override;
   virtual long long getCurrentEntryNumber() const override;
   virtual long long getNbOfAllEntries() const override;
+  long long getCurrentEntrySize() const;
   virtual bool openFileAndLoadData(
     const char* filename, const char* treename = "T") override;
   virtual void closeFile();
@@ -71,6 +72,7 @@ protected:
   TTree* fTree = nullptr;
   TFile* fFile = nullptr;
   long long fCurrentEntryNumber = -1;
+  long long fCurrentEntrySize = 0;
 };
 
 #endif /* !JPETREADER_H */
@@ -16,18 +16,27 @@
 #ifndef JPETSCOPEDATA_H
 #define JPETSCOPEDATA_H
 #include "./JPetDataInterface/JPetDataInterface.h"
+#include "./JPetRecoSignal/JPetRecoSignal.h"
 #include <string>
+#include <vector>
 #include <map>
 
 /**
  * @brief Wrapper class that contains data sent to JPetScopeTask.
+ *
+ * Optionally, the signals already decoded from the files can be passed.
+ * They must be given in the same order as the file names in the map.
  */
 class JPetScopeData : public JPetDataInterface
 {
 public:
   explicit JPetScopeData(const std::pair<int, std::map<std::string, int>>& event);
+  JPetScopeData(const std::pair<int, std::map<std::string, int>>& event, std::vector<JPetRecoSignal>&& decodedSignals);
   std::pair<int, std::map<std::string, int> > getEvent() const;
+  const std::vector<JPetRecoSignal>& getDecodedSignals() const;
+  bool hasDecodedSignals() const;
 protected:
   std::pair<int, std::map<std::string, int>> fEvent;
+  std::vector<JPetRecoSignal> fDecodedSignals;
 };
 #endif /* !JPETSCOPEDATA_H */
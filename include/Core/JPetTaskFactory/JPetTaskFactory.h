@@ -109,6 +109,8 @@ private:
 
 /// Option name used to stop the task iteration loop.
 const std::string kStopIterationOptionName = "StopIteration_bool";
+/// Option name used to execute the consecutive tasks in memory, without the intermediate files (see JPetFusedTaskIO).
+const std::string kFuseTasksOptionName = "JPetTaskFactory_FuseTasks_bool";
 
 /// Set of helper factory functions used by the JPetTaskFactory methods
 
@@ -130,5 +132,17 @@ void addDefaultTasksFromOptions(const std::map<std::string, boost::any>& options
 /// @param outChain chain of task  generators that will be modified.
 void addTaskToChain(const std::map<std::string, TaskGenerator>& generatorsMap, const TaskInfo& info, TaskGeneratorChain& outChain);
 
+/// @brief adds the task generator of the first user task reading the hld file directly with JPetHLDLoader.
+/// @param generatorMap map of registered tasks. Only those task can be used to produce the task generators.
+/// @param info about the task to be added. The task type and name must be present in the generatorsMap.
+/// @param outChain chain of task  generators that will be modified.
+void addHLDLoaderToChain(const std::map<std::string, TaskGenerator>& generatorsMap, const TaskInfo& info, TaskGeneratorChain& outChain);
+
+/// @brief adds the generator of the single task executing the given consecutive tasks in memory (JPetFusedTaskIO).
+/// @param generatorMap map of registered tasks. Only those task can be used to produce the task generators.
+/// @param infos about the tasks to be fused, the input file type of each task is the output file type of the previous one.
+/// @param outChain chain of task  generators that will be modified.
+void addFusedTasksToChain(const std::map<std::string, TaskGenerator>& generatorsMap, const std::vector<TaskInfo>& infos, TaskGeneratorChain& outChain);
+
 }
 #endif /*  !JPETTASKFACTORY_H */
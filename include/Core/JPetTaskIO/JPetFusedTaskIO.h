@@ -0,0 +1,86 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetFusedTaskIO.h
+ */
+
+#ifndef JPETFUSEDTASKIO_H
+#define JPETFUSEDTASKIO_H
+
+#include "./JPetTaskIO/JPetStageQueue.h"
+#include "./JPetTaskIO/JPetTaskIO.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class JPetTimeWindowMC;
+
+/**
+ * @brief Input/output task executing several consecutive user tasks on every entry in memory
+ *
+ * In contrast to JPetTaskIO, in which the subtasks are executed one after another on all
+ * entries of the input file, here every entry read from the input file is passed through all
+ * the subtasks (stages): the JPetTimeWindow produced by a stage is given directly to the next one,
+ * in the same way as it would be written to the file and read back by the next JPetTaskIO
+ * (the empty time windows are not passed further, the MC information is kept).
+ * Only the output of the last stage is written to the output file. The output of the intermediate
+ * stages can be written to the checkpoint files, named as the output file with the data type
+ * of the stage, by listing their output file types in the JPetFusedTaskIO_Checkpoints_std::vector<std::string>
+ * option. Every file gets the tree header with the history of the stages it contains,
+ * the statistics of these stages and the parameter bank.
+ *
+ * All the stages are initialized with the options of the fused task before the first entry is read
+ * and terminated after the last one, so an error in init() of any stage stops the whole task.
+ *
+ * With the JPetFusedTaskIO_Pipeline_bool option the stages are executed concurrently, each in its
+ * own thread, connected by the bounded queues of time windows (JPetStageQueue) of the size given by
+ * JPetFusedTaskIO_PipelineQueueSize_int. The order of the output and the results are the same as
+ * in the sequential execution. ROOT::EnableThreadSafety() must be called before any ROOT object is
+ * created, which JPetManager does when this option is set.
+ */
+class JPetFusedTaskIO: public JPetTaskIO
+{
+public:
+  JPetFusedTaskIO(const char* name, const char* in_file_type, const std::vector<std::string>& stage_out_file_types);
+  virtual ~JPetFusedTaskIO();
+  virtual bool run(const JPetDataInterface& inData) override;
+  virtual bool terminate(JPetParams& outOptions) override;
+
+  static const std::string kCheckpointsKey;
+  static const std::string kPipelineKey;
+  static const std::string kPipelineQueueSizeKey;
+  static const int kDefaultPipelineQueueSize = 16;
+
+protected:
+  /// Time window passed between the stages with its number in the original data, see JPetWindowIndex
+  struct StageWindow
+  {
+    std::unique_ptr<TObject> fWindow;
+    ULong64_t fWindowNumber = 0;
+  };
+  using StageQueue = JPetStageQueue<StageWindow>;
+
+  virtual bool createOutputObjects(const char* outputFilename) override;
+  bool runSequentially(const std::vector<JPetProfiler*>& profilers, long long firstEvent);
+  bool runPipeline(const std::vector<JPetProfiler*>& profilers, long long firstEvent);
+  bool runStage(std::size_t i, TObject& input, ULong64_t windowNumber, JPetProfiler* profiler, TObject*& output);
+  bool runPipelineStage(std::size_t i, TObject& input, ULong64_t windowNumber, JPetProfiler* profiler, StageQueue* queue);
+  void saveCheckpoints();
+  std::vector<std::string> fStageOutFileTypes;
+  std::vector<std::unique_ptr<JPetOutputHandler>> fCheckpoints;
+  std::vector<std::unique_ptr<JPetTimeWindowMC>> fStageMCWindows;
+
+private:
+  JPetFusedTaskIO(const JPetFusedTaskIO&);
+  void operator=(const JPetFusedTaskIO&);
+};
+#endif /* !JPETFUSEDTASKIO_H */
@@ -17,10 +17,14 @@
 #define JPETINPUTHANDLER_H
 
 #include <memory.h>
+#include <memory>
+#include <string>
+#include <vector>
 #include "./JPetReader/JPetReader.h"
 #include "./JPetParams/JPetParams.h"
 #include "./JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
 #include "./JPetTreeHeader/JPetTreeHeader.h"
+#include "./JPetWindowIndex/JPetWindowIndex.h"
 
 struct EntryRange {
   long long firstEntry = 0ll;
@@ -28,6 +32,20 @@ struct EntryRange {
   long long currentEntry = -1ll;
 };
 
+/**
+ * @brief Helper class handles the input operations performed by JPetReader
+ *
+ * Optionally the entries read from the input file are kept in memory, as long as
+ * their total (uncompressed) size does not exceed the size set with setCacheSize().
+ * If the same file is opened again, e.g. in the next iteration of JPetTaskLooper,
+ * the cached entries are taken from memory and only the rest is read from the file,
+ * which therefore plays the role of the storage of the entries spilled from the cache.
+ *
+ * If the entry filter is set and the input file contains the window index (see JPetWindowIndex),
+ * only the entries matching the filter are visited, the others are not read from the file at all.
+ * The index also gives the numbers of the time windows in the original data, see getWindowNumber()
+ * and seekWindow().
+ */
 class JPetInputHandler
 {
 
@@ -43,13 +61,46 @@ public:
   long long getCurrentEntryNumber() const;
   TObject& getEntry();
   bool nextEntry();
+  /// false if no entry of the range matches the entry filter
+  bool hasEntry() const;
+
+  void setEntryFilter(const JPetWindowIndex::Predicate& filter);
+  bool isEntryFilterActive() const;
+  ULong64_t getWindowNumber() const;
+  ULong64_t getNumberOfWindows() const;
+  bool seekWindow(ULong64_t windowNumber);
 
   /// Function calculates the correct entry range [first, last] based on the options provided and the internal reader state
   std::tuple<bool, long long, long long> calculateEntryRange(const jpet_options_tools::OptsStrAny& options) const;
 
   JPetTreeHeader* getHeaderClone(); /// @todo what to do with this function?
+
+  void setCacheSize(std::size_t bytes);
+  void clearCache();
+  std::size_t getCacheSize() const;
+  std::size_t getCachedBytes() const;
+  long long getNumberOfCachedEntries() const;
+  bool isCached(long long entry) const;
+
 protected:
+  void addToCache(long long entry, TObject& object);
+  bool loadIndex();
+  bool moveTo(long long entry);
+
   std::unique_ptr<JPetReaderInterface> fReader{nullptr};
+  std::string fInputFileName;
+  std::size_t fCacheSize = 0;
+  std::size_t fCachedBytes = 0;
+  bool fIsCacheFull = false;
+  /// consecutive entries starting from fFirstCachedEntry
+  std::vector<std::unique_ptr<TObject>> fCache;
+  long long fFirstCachedEntry = 0;
+  /// false if the reader was not moved to the current entry, since it is taken from the cache
+  bool fIsReaderAtCurrentEntry = true;
+  JPetWindowIndex::Predicate fEntryFilter;
+  JPetWindowIndex fIndex;
+  bool fIsIndexLoaded = false;
+  bool fHasEntry = true;
 
 private:
   JPetInputHandler(const JPetInputHandler&);
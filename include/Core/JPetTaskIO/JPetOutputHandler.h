@@ -36,12 +36,17 @@ public:
   JPetOutputHandler(); 
   explicit JPetOutputHandler(const char* outputFilename);
 
-  void saveOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics);
-  void saveAndCloseOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics);
+  void saveOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics, bool clearParameters = true);
+  void saveAndCloseOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics, bool clearParameters = true);
   bool writeEventToFile(JPetTaskInterface* task);
+  /// Number of the next time window in the original data, by default the windows passed to writeEventToFile are counted
+  void setWindowNumber(ULong64_t windowNumber);
+  /// Total number of time windows in the original data, by default the number of the last window passed to writeEventToFile + 1
+  void setNumberOfWindows(ULong64_t numberOfWindows);
 
 protected:
   JPetWriter fWriter;
+  ULong64_t fWindowNumber = 0;
 
 private:
   JPetOutputHandler(const JPetOutputHandler&);
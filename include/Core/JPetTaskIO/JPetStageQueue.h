@@ -0,0 +1,138 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStageQueue.h
+ */
+
+#ifndef JPETSTAGEQUEUE_H
+#define JPETSTAGEQUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free queue connecting two consecutive stages of the pipeline
+ *
+ * The queue has a single producer and a single consumer thread. The elements are kept
+ * in a ring buffer, so the queue never allocates after the construction. The blocking
+ * push() waits while the queue is full, which slows down the producing stage to the pace
+ * of the consuming one (back-pressure). The waiting threads spin, then yield and finally
+ * sleep, so the idle stage does not occupy the processor.
+ *
+ * The producer closes the queue after the last element: pop() returns false once the closed
+ * queue is empty. The consumer closes the queue to stop the producer: push() returns false.
+ */
+template <class T>
+class JPetStageQueue
+{
+public:
+  explicit JPetStageQueue(std::size_t capacity) : fSlots(capacity > 0 ? capacity + 1 : 2) {}
+
+  /// @return false if the queue is full, value is moved to the queue otherwise
+  bool tryPush(T& value)
+  {
+    auto tail = fTail.load(std::memory_order_relaxed);
+    auto next = increment(tail);
+    if (next == fHead.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    fSlots[tail] = std::move(value);
+    fTail.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /// @return false if the queue is empty
+  bool tryPop(T& value)
+  {
+    auto head = fHead.load(std::memory_order_relaxed);
+    if (head == fTail.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    value = std::move(fSlots[head]);
+    fSlots[head] = T();
+    fHead.store(increment(head), std::memory_order_release);
+    return true;
+  }
+
+  /// Wait until there is a free slot in the queue.
+  /// @return false if the queue was closed
+  bool push(T value)
+  {
+    unsigned int attempt = 0;
+    while (!isClosed())
+    {
+      if (tryPush(value))
+      {
+        return true;
+      }
+      wait(attempt++);
+    }
+    return false;
+  }
+
+  /// Wait until there is an element in the queue.
+  /// @return false if the queue was closed and all the elements were taken
+  bool pop(T& value)
+  {
+    unsigned int attempt = 0;
+    while (!tryPop(value))
+    {
+      if (isClosed())
+      {
+        /// the element might have been pushed just before closing
+        return tryPop(value);
+      }
+      wait(attempt++);
+    }
+    return true;
+  }
+
+  void close() { fIsClosed.store(true, std::memory_order_release); }
+  bool isClosed() const { return fIsClosed.load(std::memory_order_acquire); }
+  std::size_t getCapacity() const { return fSlots.size() - 1; }
+
+private:
+  JPetStageQueue(const JPetStageQueue&);
+  void operator=(const JPetStageQueue&);
+
+  std::size_t increment(std::size_t index) const { return index + 1 == fSlots.size() ? 0 : index + 1; }
+
+  static void wait(unsigned int attempt)
+  {
+    if (attempt < 64)
+    {
+      return;
+    }
+    if (attempt < 1024)
+    {
+      std::this_thread::yield();
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+
+  std::vector<T> fSlots;
+  /// the indices modified by different threads are kept in separate cache lines
+  std::atomic<std::size_t> fHead{0};
+  char fHeadPadding[64 - sizeof(std::atomic<std::size_t>)];
+  std::atomic<std::size_t> fTail{0};
+  char fTailPadding[64 - sizeof(std::atomic<std::size_t>)];
+  std::atomic<bool> fIsClosed{false};
+};
+
+#endif /* !JPETSTAGEQUEUE_H */
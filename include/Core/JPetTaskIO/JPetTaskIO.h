@@ -17,6 +17,8 @@
 #define JPETTASKIO_H
 
 #include "./JPetProgressBarManager/JPetProgressBarManager.h"
+#include "./JPetCachedFunction/JPetCachedFunction.h"
+#include "./JPetProfiler/JPetProfiler.h"
 #include "./JPetTaskInterface/JPetTaskInterface.h"
 #include "./JPetParamManager/JPetParamManager.h"
 #include "./JPetStatistics/JPetStatistics.h"
@@ -26,6 +28,7 @@
 #include "./JPetTask/JPetTask.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 class JPetReader;
 class JPetTreeHeader;
@@ -50,6 +53,19 @@ struct TaskIOFileInfo {
  * @brief Class representing computing task with input/output operations.
  * In the current implementation the single entry that is read by the reader
  * corresponds to a JPetTimeWindow object.
+ *
+ * With the JPetTaskIO_Profiling_bool option set, the time spent in init, run and terminate
+ * of every subtask, as well as in reading, processing and writing of every event, is measured
+ * with JPetProfiler. The latency histograms are saved in the statistics directory
+ * of the subtask in the output file and the summary is written to <file>.profile.json.
+ *
+ * With JPetTaskIO_InputCacheSizeMB_int greater than 0, the entries read from the input file
+ * are cached in memory up to the given size (see JPetInputHandler) and reused when the task
+ * is initialized again with the same input file. With JPetTaskIO_SkipOutputEvents_bool set,
+ * the events are not written to the output file, only the header, statistics and parameters.
+ * With JPetCachedFunction_CacheDirectory_std::string set, the tabulated functions created
+ * by the subtasks are stored in and loaded from the given directory (see JPetCachedFunctionStore).
+ * The directory is set only in the thread running the subtasks and only until they finish.
  */
 class JPetTaskIO: public JPetTask
 {
@@ -69,15 +85,30 @@ public:
   bool isOutput() const;
   bool isInput() const;
 
+  static const std::string kProfilingKey;
+  static const std::string kInputCacheKey;
+  static const std::string kSkipOutputEventsKey;
+  static const std::string kIndexMinEventsKey;
+  static const std::string kIndexMinTimeKey;
+  static const std::string kIndexMaxTimeKey;
+  static const std::string kIndexFlagsKey;
+  static const std::string kCacheDirectoryKey;
+
+  static JPetWindowIndex::Predicate createEntryFilter(const jpet_options_tools::OptsStrAny& options);
+
 protected:
   virtual std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(
     const jpet_options_tools::OptsStrAny options
   ) const;
   virtual bool createInputObjects(const char* inputFilename);
   virtual bool createOutputObjects(const char* outputFilename);
+  JPetTreeHeader* createHeader();
   const JPetParamBank& getParamBank();
   JPetParamManager& getParamManager();
   std::string getFirstSubTaskName() const;
+  JPetProfiler* startProfiling(std::size_t subTaskIndex);
+  void saveProfiles(const std::string& fileName);
+  std::unique_ptr<jpet_common_tools::JPetCachedFunctionStore::DirectoryScope> startCacheDirectoryScope() const;
   TaskIOFileInfo fTaskInfo;
   bool fIsOutput = true;
   bool fIsInput = true;
@@ -88,6 +119,10 @@ protected:
   std::unique_ptr<JPetOutputHandler> fOutputHandler{nullptr};
   std::unique_ptr<JPetInputHandler> fInputHandler{nullptr};
   JPetProgressBarManager fProgressBar;
+  bool fIsProfiling = false;
+  bool fIsSkippingOutputEvents = false;
+  std::string fCacheDirectory;
+  std::vector<std::unique_ptr<JPetProfiler>> fProfilers;
 
 private:
   JPetTaskIO(const JPetTaskIO&);
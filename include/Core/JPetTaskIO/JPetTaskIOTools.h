@@ -21,9 +21,19 @@
 
 namespace JPetTaskIOTools
 {
+/// Name of the tree header variable with the shard of the data ("index/number of shards")
+const std::string kShardHeaderVariable = "shard";
+
 /// @brief Function returns (isOK, firstEvent, lastEvent) based on provided options.
 /// if isOK is set to false, that means that an error has occured.
+/// If the shard is set, only its part of the range of events is returned.
 std::tuple<bool, long long, long long> setUserLimits(const jpet_options_tools::OptsStrAny& opts, const long long totalNumEvents);
+/// @brief Function returns (firstEvent, lastEvent) of the shard of the given range,
+/// the range is divided into numberOfShards parts differing in size by at most one event.
+std::pair<long long, long long> getShardLimits(long long first, long long last, int shardIndex, int numberOfShards);
+/// @brief Function returns the file name with the shard added to the base name,
+/// e.g. dabc_123_shard3of16.hits.root, so the data type is kept as the suffix.
+std::string addShardToFileName(const std::string& fileName, int shardIndex, int numberOfShards);
 /// @brief Function returns (isOK, inputFile, outputFileFullPath, isResetOutputPath) based on provided options.
 /// if isOK is set to false, that means that an error has occured.
 std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(const OptsStrAny& opts, bool prevResetOutputPath, const std::string& inFileType, const std::string& outFileType);
@@ -33,8 +33,13 @@ public:
   bool run(const JPetDataInterface& inData) override;
   bool terminate(JPetParams& outOptions) override;
   void setConditionFunction(Predicate isCondition);
+  /// If the number of iterations is known and the input cache is on (JPetTaskIO_InputCacheSizeMB_int),
+  /// the events are written to the output file only in the last iteration.
+  void setNumberOfIterations(int numberOfIterations);
 protected:
+  JPetParams getIterationParams(const JPetParams& params, int iteration) const;
   Predicate fIsCondition;
   JPetParams fParams;
+  int fNumberOfIterations = -1;
 };
 #endif /*  !JPETTASKLOOPER_H */
@@ -23,13 +23,17 @@
 
 /**
  * @brief Measuremet of tasks execution time.
+ *
+ * The times are measured with the steady (monotonic) clock with the nanosecond
+ * resolution. getVectorOfMeasuredTimes() returns them truncated to whole seconds,
+ * getVectorOfPreciseMeasuredTimes() returns the full resolution.
  */
 class JPetTimer
 {
 public:
   using vectorElapsedTimes = std::vector<std::pair<std::string, std::chrono::seconds>>;
-  using startTimeType = std::chrono::time_point<std::chrono::_V2::system_clock,
-    std::chrono::duration<long int, std::ratio<1l, 1000000000l>>>;
+  using vectorPreciseElapsedTimes = std::vector<std::pair<std::string, std::chrono::nanoseconds>>;
+  using startTimeType = std::chrono::steady_clock::time_point;
 
   JPetTimer();
   ~JPetTimer();
@@ -40,11 +44,15 @@ public:
   std::string getAllMeasuredTimes();
   std::string getTotalMeasuredTime();
   vectorElapsedTimes getVectorOfMeasuredTimes();
+  vectorPreciseElapsedTimes getVectorOfPreciseMeasuredTimes();
   startTimeType getCurrentStartTime();
   long int getTotalMeasuredTimeInSeconds();
+  double getTotalMeasuredTimeInPreciseSeconds();
 
 private:
-  vectorElapsedTimes fElapsedTimes;
+  static std::string formatSeconds(std::chrono::nanoseconds time);
+
+  vectorPreciseElapsedTimes fElapsedTimes;
   startTimeType fStartTime;
 };
 
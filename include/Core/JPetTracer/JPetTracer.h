@@ -0,0 +1,91 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTracer.h
+ */
+
+#ifndef JPETTRACER_H
+#define JPETTRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Recorder of the timeline of the processing in the Chrome trace format
+ *
+ * The recording is off by default and is switched on with start(). Every thread
+ * records the spans (JPetTracer::Scope objects) into its own buffer, so no locking
+ * is done on the hot path, and at most kMaxEventsPerThread spans are kept per thread.
+ * stop() writes all the buffers to the JSON file, which can be opened in chrome://tracing
+ * or https://ui.perfetto.dev. It must be called after the recording threads have finished.
+ * With the recording off, a Scope costs a single relaxed atomic load.
+ */
+class JPetTracer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  static const std::size_t kMaxEventsPerThread;
+
+  class Scope
+  {
+  public:
+    Scope(const char* category, const char* name) : fCategory(category)
+    {
+      if (isEnabled())
+      {
+        fIsActive = true;
+        fName = name;
+        fStart = Clock::now();
+      }
+    }
+    Scope(const char* category, const std::string& name) : fCategory(category)
+    {
+      if (isEnabled())
+      {
+        fIsActive = true;
+        fName = name;
+        fStart = Clock::now();
+      }
+    }
+    ~Scope()
+    {
+      if (fIsActive)
+      {
+        record(fCategory, fName, fStart, Clock::now());
+      }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    const char* fCategory;
+    bool fIsActive = false;
+    std::string fName;
+    Clock::time_point fStart;
+  };
+
+  static bool isEnabled() { return sIsEnabled.load(std::memory_order_relaxed); }
+  static void start();
+  static bool stop(const std::string& fileName);
+  static void setThreadName(const std::string& name);
+  static void record(const char* category, const std::string& name, Clock::time_point start, Clock::time_point end);
+  static std::string toJSON();
+  static long long getNumberOfEvents();
+  static long long getNumberOfDroppedEvents();
+
+private:
+  static std::atomic<bool> sIsEnabled;
+};
+
+#endif /* !JPETTRACER_H */
@@ -90,6 +90,7 @@ public:
   }
   void setVariable(std::string name, std::string value);
   std::string getVariable(std::string name) const;
+  void removeVariable(std::string name);
   inline void setBaseFileName(const char* p_name)
   {
     fBaseFilename = p_name;
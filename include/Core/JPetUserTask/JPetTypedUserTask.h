@@ -0,0 +1,105 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTypedUserTask.h
+ */
+
+#ifndef JPETTYPEDUSERTASK_H
+#define JPETTYPEDUSERTASK_H
+
+#include "./JPetLoggerInclude.h"
+#include "./JPetUserTask/JPetUserTask.h"
+#include <TClass.h>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief User task with the types of the input and output events known at compile time
+ *
+ * The class of the events in the input time window is checked against TInput only when
+ * it changes, i.e. once per input file, and the output window is created for TOutput
+ * if the user did not create it in init(). The user implements process(), which gets
+ * a typed view of the input window, so the access to the elements and adding of the
+ * output events use static casts instead of dynamic_cast per element:
+ *
+ *   class MyTask: public JPetTypedUserTask<JPetHit, JPetEvent>
+ *   {
+ *     bool process(const InputEvents& hits) override
+ *     {
+ *       for (const auto& hit : hits) { ... hit.getTime() ... addOutput(event); }
+ *       return true;
+ *     }
+ *   };
+ */
+template <typename TInput, typename TOutput = TInput>
+class JPetTypedUserTask: public JPetUserTask
+{
+public:
+  /// Read-only view of the input time window with the events of type TInput
+  using InputEvents = JPetTimeWindowRange<const TInput>;
+
+  explicit JPetTypedUserTask(const char* name = "") : JPetUserTask(name) {}
+  virtual ~JPetTypedUserTask() {}
+
+  bool init(const JPetParams& inOptions) override
+  {
+    if (!JPetUserTask::init(inOptions))
+    {
+      return false;
+    }
+    if (!fOutputEvents)
+    {
+      fOutputEvents = new JPetTimeWindow(TOutput::Class_Name());
+    }
+    if (!inheritsFrom(fOutputEvents->getEventClass(), TOutput::Class()))
+    {
+      ERROR(std::string("The output time window of task ") + getName() + " does not store " + TOutput::Class_Name() + " objects");
+      return false;
+    }
+    fInputClass = nullptr;
+    return true;
+  }
+
+protected:
+  virtual bool process(const InputEvents& events) = 0; /// should be implemented in descendent class
+
+  bool exec() override
+  {
+    auto window = getInputEvents();
+    if (!window)
+    {
+      ERROR(std::string("No input time window in task ") + getName());
+      return false;
+    }
+    if (window->getEventClass() != fInputClass)
+    {
+      if (!inheritsFrom(window->getEventClass(), TInput::Class()))
+      {
+        ERROR(std::string("The input time window of task ") + getName() + " does not store " + TInput::Class_Name() + " objects");
+        return false;
+      }
+      fInputClass = window->getEventClass();
+    }
+    const JPetTimeWindow& input = *window;
+    return process(input.getEvents<TInput>());
+  }
+
+  void addOutput(const TOutput& event) { fOutputEvents->addUnchecked<TOutput>() = event; }
+  void addOutput(TOutput&& event) { fOutputEvents->addUnchecked<TOutput>() = std::move(event); }
+
+private:
+  static bool inheritsFrom(TClass* eventClass, TClass* expectedClass) { return eventClass && eventClass->InheritsFrom(expectedClass); }
+
+  TClass* fInputClass = nullptr;
+};
+
+#endif /* !JPETTYPEDUSERTASK_H */
@@ -51,9 +51,12 @@ public:
 
   virtual void setEvent(TObject* ev);
   const JPetParamBank& getParamBank();
-  jpet_options_tools::OptsStrAny getOptions() const;
+  const jpet_options_tools::OptsStrAny& getOptions() const;
   virtual JPetTimeWindow* getOutputEvents();
   JPetTimeWindow* getInputEvents();
+  /// Flags of the current output window stored in the window index, see JPetWindowIndex
+  void setWindowFlags(ULong64_t flags);
+  ULong64_t getWindowFlags() const;
 
 protected:
   virtual bool init() = 0; /// should be implemented in descendent class
@@ -66,5 +69,6 @@ protected:
   JPetStatistics* fStatistics = 0;
   JPetParams fParams;
   JPetTimeWindow* fOutputEvents = 0;
+  ULong64_t fWindowFlags = 0;
 };
 #endif /* !JPETUSERTASK_H */
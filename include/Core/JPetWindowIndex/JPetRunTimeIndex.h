@@ -0,0 +1,92 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetRunTimeIndex.h
+ */
+
+#ifndef JPETRUNTIMEINDEX_H
+#define JPETRUNTIMEINDEX_H
+
+#include "./JPetWindowIndex/JPetWindowIndex.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class JPetReader;
+class TObject;
+
+/**
+ * @brief Time index of a run made of several processed files, built on their window indices
+ *
+ * The time windows of the run have the same length, so the window containing the given time
+ * is found from its number, which is kept in the window index of every file (see JPetWindowIndex).
+ * The files must be added in the order of the data, the windows of every file follow
+ * the last window of the previous one, including the empty windows which were not written
+ * (see JPetWindowIndex::getNumberOfWindows). The times are given in ps from the start of the first window
+ * of the run, the times of the events inside the windows are relative to the start of the window.
+ *
+ * Only the indices are read when the files are added, so fetching a window, e.g. in a monitoring tool:
+ *   JPetRunTimeIndex run(windowLength);
+ *   run.addFile("dabc_1.hits.root"); run.addFile("dabc_2.hits.root");
+ *   for (auto window = run.fetch(from); window && run.getStartTime(run.getLocation()) < to; window = run.fetchNext()) {...}
+ * reads only the requested entries of the files.
+ */
+class JPetRunTimeIndex
+{
+public:
+  struct Location
+  {
+    std::size_t fFileIndex = 0;
+    long long fEntry = -1;
+    /// number of the window counted from the start of the run
+    ULong64_t fWindowNumber = 0;
+  };
+
+  explicit JPetRunTimeIndex(double windowLength);
+  ~JPetRunTimeIndex();
+
+  bool addFile(const std::string& fileName);
+  std::size_t getNumberOfFiles() const;
+  const std::string& getFileName(std::size_t fileIndex) const;
+  double getWindowLength() const;
+  double getEndTime() const;
+  double getStartTime(const Location& location) const;
+
+  bool locate(double time, Location& location) const;
+  TObject* fetch(double time);
+  TObject* fetchNext();
+  const Location& getLocation() const;
+
+private:
+  JPetRunTimeIndex(const JPetRunTimeIndex&);
+  void operator=(const JPetRunTimeIndex&);
+
+  struct File
+  {
+    std::string fName;
+    JPetWindowIndex fIndex;
+    ULong64_t fFirstWindow = 0;
+    ULong64_t fNumberOfWindows = 0;
+  };
+
+  bool findFrom(std::size_t fileIndex, ULong64_t windowNumber, Location& location) const;
+  TObject* read(const Location& location);
+
+  double fWindowLength = 0.0;
+  std::vector<File> fFiles;
+  std::unique_ptr<JPetReader> fReader;
+  std::size_t fOpenedFile = 0;
+  bool fIsFileOpened = false;
+  Location fLocation;
+};
+
+#endif /* !JPETRUNTIMEINDEX_H */
@@ -0,0 +1,80 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWindowIndex.h
+ */
+
+#ifndef JPETWINDOWINDEX_H
+#define JPETWINDOWINDEX_H
+
+#include <Rtypes.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+class JPetTimeWindow;
+class TTree;
+
+/**
+ * @brief Summary of every time window of the output tree, stored in a separate small tree
+ *
+ * For every entry of the tree with the time windows, JPetWriter fills one entry of the index tree
+ * with the number of events in the window, the minimal and maximal time of the events,
+ * the flags set by the user task for the window (see JPetUserTask::setWindowFlags) and the number
+ * of the window in the original data. The latter is kept along the processing chain, also when
+ * the empty windows are not written, so it gives the position of the window in time (see JPetRunTimeIndex).
+ * The total number of the windows of the original data, including the empty ones at the end
+ * which are not written, is stored in the user info of the index tree.
+ * The times are known for the windows of JPetHit, JPetCompactHit, JPetEvent, JPetPhysSignal
+ * and JPetSigCh objects, for other types they are set to NaN, which matches any time range.
+ *
+ * When the file is read, the index is loaded in memory and the predicates on its entries,
+ * e.g. minNumberOfEvents(2), allow JPetInputHandler to read only the matching windows.
+ */
+class JPetWindowIndex
+{
+public:
+  struct Entry
+  {
+    UInt_t fNumberOfEvents = 0;
+    Double_t fMinTime = 0.0;
+    Double_t fMaxTime = 0.0;
+    ULong64_t fFlags = 0;
+    ULong64_t fWindowNumber = 0;
+  };
+  using Predicate = std::function<bool(const Entry&)>;
+
+  static const std::string kIndexTreeName;
+
+  static Entry createEntry(const JPetTimeWindow& window, ULong64_t flags = 0, ULong64_t windowNumber = 0);
+  static TTree* createTree(Entry& buffer);
+  static void setNumberOfWindows(TTree& tree, ULong64_t numberOfWindows);
+
+  static Predicate minNumberOfEvents(unsigned int numberOfEvents);
+  static Predicate timeRange(double minTime, double maxTime);
+  static Predicate allFlags(ULong64_t flags);
+  static Predicate allOf(const std::vector<Predicate>& predicates);
+
+  bool read(TTree& tree);
+  void clear();
+  long long size() const { return fEntries.size(); }
+  const Entry& operator[](long long entry) const { return fEntries[entry]; }
+  long long findNext(long long first, long long last, const Predicate& predicate) const;
+  long long findWindow(ULong64_t windowNumber) const;
+  ULong64_t getNumberOfWindows() const { return fNumberOfWindows; }
+
+private:
+  std::vector<Entry> fEntries;
+  ULong64_t fNumberOfWindows = 0;
+};
+
+#endif /* !JPETWINDOWINDEX_H */
@@ -26,9 +26,11 @@ class boost::noncopyable;
 #include "./JPetBarrelSlot/JPetBarrelSlot.h"
 #include "./JPetPhysSignal/JPetPhysSignal.h"
 #include "./JPetTimeWindow/JPetTimeWindow.h"
+#include "./JPetWindowIndex/JPetWindowIndex.h"
 #include "./JPetSigCh/JPetSigCh.h"
 #include "./JPetEvent/JPetEvent.h"
 #include "./JPetLoggerInclude.h"
+#include "./JPetTracer/JPetTracer.h"
 #include "./JPetScin/JPetScin.h"
 #include "./JPetHit/JPetHit.h"
 #include "./JPetLOR/JPetLOR.h"
@@ -38,6 +40,7 @@ class boost::noncopyable;
 #include <TFile.h>
 #include <TList.h>
 #include <TTree.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -77,18 +80,34 @@ public:
     if (fFile) return (fFile->IsOpen() && !fFile->IsZombie());
     else return false;
   }
+  /// Flags stored in the window index with the next written time window
+  void setIndexFlags(ULong64_t flags) { fIndexFlags = flags; }
+  /// Number of the next written time window in the original data, the following windows are numbered consecutively
+  void setIndexWindowNumber(ULong64_t windowNumber) { fIndexWindowNumber = windowNumber; }
+  /// Total number of time windows in the original data, also the empty ones which are not written
+  void setIndexNumberOfWindows(ULong64_t numberOfWindows) { fIndexNumberOfWindows = std::max(fIndexNumberOfWindows, numberOfWindows); }
 
 protected:
+  void fillIndex(const JPetTimeWindow& window);
+  void fillIndex(const TObject&) {}
+  void saveTrees();
+
   std::string fFileName;
   TFile* fFile;
   bool fIsBranchCreated;
   TTree* fTree;
   TList fTList;
+  TTree* fIndexTree = nullptr;
+  JPetWindowIndex::Entry fIndexEntry;
+  ULong64_t fIndexFlags = 0;
+  ULong64_t fIndexWindowNumber = 0;
+  ULong64_t fIndexNumberOfWindows = 0;
 };
 
 template <class T>
 bool JPetWriter::write(const T& obj)
 {
+  JPetTracer::Scope scope("io", "JPetWriter::write");
   DEBUG("JPetWriter");
   if ( !fFile->IsOpen() ) {
     ERROR("Could not write to file. Have you closed it already?");
@@ -109,6 +128,7 @@ bool JPetWriter::write(const T& obj)
   }
   DEBUG("fTree->Fill()");
   fTree->Fill();
+  fillIndex(obj);
   return true;
 }
 
@@ -0,0 +1,95 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetCompactHit.h
+ */
+
+#ifndef JPETCOMPACTHIT_H
+#define JPETCOMPACTHIT_H
+
+#include "./JPetHit/JPetHit.h"
+#include <TObject.h>
+#include <TVector3.h>
+
+/**
+ * @brief Lightweight version of JPetHit for the LOR and event level analysis
+ *
+ * The compact hit keeps only the reconstructed properties of the hit: time, energy,
+ * position, their qualities and the IDs of the scintillator and the barrel slot.
+ * The signals are not embedded, instead the hit keeps their indices in the side
+ * array of JPetCompactHitWindow, which is filled only if requested, and kNoSignal otherwise.
+ * A compact hit takes less than 100 bytes, compared with kilobytes of JPetHit with both signals.
+ * Agreed convention of units: energy [keV], time [ps], position [cm].
+ */
+class JPetCompactHit: public TObject
+{
+public:
+  static const int kNoSignal = -1;
+
+  JPetCompactHit();
+  explicit JPetCompactHit(const JPetHit& hit, int signalAIndex = kNoSignal, int signalBIndex = kNoSignal);
+  virtual ~JPetCompactHit();
+
+  JPetHit::RecoFlag getRecoFlag() const { return fFlag; }
+  float getEnergy() const { return fEnergy; }
+  float getQualityOfEnergy() const { return fQualityOfEnergy; }
+  float getTime() const { return fTime; }
+  float getQualityOfTime() const { return fQualityOfTime; }
+  float getTimeDiff() const { return fTimeDiff; }
+  float getQualityOfTimeDiff() const { return fQualityOfTimeDiff; }
+  float getPosX() const { return fPosX; }
+  float getPosY() const { return fPosY; }
+  float getPosZ() const { return fPosZ; }
+  TVector3 getPos() const { return TVector3(fPosX, fPosY, fPosZ); }
+  int getScintillatorID() const { return fScintillatorID; }
+  int getBarrelSlotID() const { return fBarrelSlotID; }
+  unsigned int getMCindex() const { return fMCindex; }
+  int getSignalAIndex() const { return fSignalAIndex; }
+  int getSignalBIndex() const { return fSignalBIndex; }
+  bool hasSignalA() const { return fSignalAIndex != kNoSignal; }
+  bool hasSignalB() const { return fSignalBIndex != kNoSignal; }
+
+  void setRecoFlag(JPetHit::RecoFlag flag) { fFlag = flag; }
+  void setEnergy(float energy) { fEnergy = energy; }
+  void setQualityOfEnergy(float qualityOfEnergy) { fQualityOfEnergy = qualityOfEnergy; }
+  void setTime(float time) { fTime = time; }
+  void setQualityOfTime(float qualityOfTime) { fQualityOfTime = qualityOfTime; }
+  void setTimeDiff(float timeDiff) { fTimeDiff = timeDiff; }
+  void setQualityOfTimeDiff(float qualityOfTimeDiff) { fQualityOfTimeDiff = qualityOfTimeDiff; }
+  void setPos(float x, float y, float z);
+  void setScintillatorID(int id) { fScintillatorID = id; }
+  void setBarrelSlotID(int id) { fBarrelSlotID = id; }
+  void setMCindex(unsigned int index) { fMCindex = index; }
+  void setSignalIndices(int signalAIndex, int signalBIndex);
+  void Clear(Option_t* opt = "");
+
+private:
+  JPetHit::RecoFlag fFlag = JPetHit::Unknown;
+  float fEnergy = 0.0f;
+  float fQualityOfEnergy = 0.0f;
+  float fTime = 0.0f;
+  float fQualityOfTime = 0.0f;
+  float fTimeDiff = 0.0f;
+  float fQualityOfTimeDiff = 0.0f;
+  float fPosX = 0.0f;
+  float fPosY = 0.0f;
+  float fPosZ = 0.0f;
+  int fScintillatorID = -1;
+  int fBarrelSlotID = -1;
+  unsigned int fMCindex = JPetHit::kMCindexError;
+  int fSignalAIndex = kNoSignal;
+  int fSignalBIndex = kNoSignal;
+
+  ClassDef(JPetCompactHit, 1);
+};
+
+#endif /* !JPETCOMPACTHIT_H */
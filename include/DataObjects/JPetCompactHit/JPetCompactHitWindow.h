@@ -0,0 +1,79 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetCompactHitWindow.h
+ */
+
+#ifndef JPETCOMPACTHITWINDOW_H
+#define JPETCOMPACTHITWINDOW_H
+
+#include "./JPetCompactHit/JPetCompactHit.h"
+#include "./JPetPhysSignal/JPetPhysSignal.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <TClonesArray.h>
+
+/**
+ * @brief Time window of JPetCompactHit objects with the side array of their signals
+ *
+ * The signals are stored in a separate TClonesArray, written by JPetWriter as a separate
+ * sub-branch of the time window, and the compact hits refer to them by index.
+ * The window is used by JPetCompactHitConverter only when the signals are requested,
+ * otherwise the compact hits are stored in a plain JPetTimeWindow.
+ */
+class JPetCompactHitWindow: public JPetTimeWindow
+{
+public:
+  JPetCompactHitWindow() : JPetTimeWindow(), fSignals() {}
+  JPetCompactHitWindow(const char* event_type) : JPetTimeWindow(event_type), fSignals("JPetPhysSignal", 4000) {}
+
+  int addSignal(const JPetPhysSignal& signal)
+  {
+    dynamic_cast<JPetPhysSignal&>(*(fSignals.ConstructedAt(fSignalCount))) = signal;
+    return static_cast<int>(fSignalCount++);
+  }
+
+  inline size_t getNumberOfSignals() const
+  {
+    return fSignalCount;
+  }
+
+  inline const JPetPhysSignal& getSignal(int i) const
+  {
+    return *(dynamic_cast<JPetPhysSignal*>(fSignals[i]));
+  }
+
+  const JPetPhysSignal& getSignalA(const JPetCompactHit& hit) const;
+  const JPetPhysSignal& getSignalB(const JPetCompactHit& hit) const;
+
+  virtual ~JPetCompactHitWindow()
+  {
+    fSignals.Clear("C");
+    fSignalCount = 0;
+  }
+
+  virtual void Clear()
+  {
+    JPetTimeWindow::Clear();
+    fSignals.Clear("C");
+    fSignalCount = 0;
+  }
+
+  ClassDef(JPetCompactHitWindow, 1);
+
+private:
+  const JPetPhysSignal& getSignalOrNull(int i) const;
+
+  TClonesArray fSignals;
+  unsigned int fSignalCount = 0;
+};
+
+#endif /* !JPETCOMPACTHITWINDOW_H */
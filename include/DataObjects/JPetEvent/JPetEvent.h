@@ -37,6 +37,10 @@
  * bit OR operators. This option can be used for instatnce to flag that
  * the final type of the event is yet undecided or it contains hits
  * from several separate physical events.
+ * Clearing the event does not free the hits: they are kept in a transient
+ * pool and reused by the next hits added or assigned to the event, so an
+ * event living in a JPetTimeWindow slot keeps the storage of its hits and
+ * signals from one time window to the next.
  */
 
 class JPetEvent: public TObject
@@ -49,6 +53,10 @@ public:
   JPetEvent(const std::vector<JPetHit>& hits,
             JPetEventType eventType = JPetEventType::kUnknown,
             bool orderedByTime = true);
+  JPetEvent(const JPetEvent& event);
+  JPetEvent(JPetEvent&&) = default;
+  JPetEvent& operator=(const JPetEvent& event);
+  JPetEvent& operator=(JPetEvent&& event);
   JPetEvent::RecoFlag getRecoFlag() const;
   const std::vector<JPetHit>& getHits() const;
   void setRecoFlag(JPetEvent::RecoFlag flag);
@@ -70,7 +78,10 @@ protected:
 #endif
 
 private:
+  void recycleHits();
+
   RecoFlag fFlag = JPetEvent::Unknown;
+  std::vector<JPetHit> fRecycledHits; //! cleared hits reused by addHit
 
   ClassDef(JPetEvent, 6);
 };
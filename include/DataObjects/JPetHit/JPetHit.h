@@ -49,6 +49,10 @@ public:
           TVector3& Position, JPetPhysSignal& SignalA, JPetPhysSignal& SignalB,
           JPetBarrelSlot& BarrelSlot, JPetScin& Scintillator);
   virtual ~JPetHit();
+  JPetHit(const JPetHit&) = default;
+  JPetHit(JPetHit&&) = default;
+  JPetHit& operator=(const JPetHit&) = default;
+  JPetHit& operator=(JPetHit&&) = default;
   JPetHit::RecoFlag getRecoFlag() const;
   float getEnergy() const;
   float getQualityOfEnergy() const;
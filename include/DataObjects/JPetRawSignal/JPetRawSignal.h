@@ -36,10 +36,19 @@ public:
 
   JPetRawSignal(const int points = 4);
   virtual ~JPetRawSignal();
+  JPetRawSignal(const JPetRawSignal&) = default;
+  JPetRawSignal(JPetRawSignal&&) = default;
+  JPetRawSignal& operator=(const JPetRawSignal&) = default;
+  JPetRawSignal& operator=(JPetRawSignal&&) = default;
   int getNumberOfPoints(JPetSigCh::EdgeType edge) const;
   void addPoint(const JPetSigCh& sigch);
   std::vector<JPetSigCh> getPoints(JPetSigCh::EdgeType edge,
     JPetRawSignal::PointsSortOrder order = JPetRawSignal::ByThrValue) const;
+  /// Access to the points in the order of adding them, without copying and sorting.
+  const std::vector<JPetSigCh>& getUnsortedPoints(JPetSigCh::EdgeType edge) const
+  {
+    return edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints;
+  }
   std::map<int, double> getTimesVsThresholdNumber(JPetSigCh::EdgeType edge) const;
   std::map<int, std::pair<float, float>> getTimesVsThresholdValue(JPetSigCh::EdgeType edge) const;
   std::map<int, double> getTOTsVsThresholdValue() const;
@@ -16,9 +16,15 @@
 #ifndef _JPETTIMEWINDOW_H_
 #define _JPETTIMEWINDOW_H_
 
+#include "./JPetTimeWindow/JPetTimeWindowRange.h"
+#include <TClass.h>
 #include <TClonesArray.h>
 #include <TNamed.h>
+#include <functional>
 #include <iostream>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 #include <map>
 
@@ -27,6 +33,14 @@
  *
  * A single TimeWindow contains many objects (referred to as "events")
  * representing events which happened during one time window of the DAQ system.
+ * The objects are stored in the slots of a TClonesArray, which are kept by Clear(),
+ * so the capacity follows the largest window seen. Events are copied (add),
+ * moved (add with an rvalue, addAll with a moved vector) or constructed from
+ * arguments (emplace) into the next slot; reserve() presizes a fresh window.
+ * getEvents<T>() returns a typed random access range over the events and
+ * gather<T>() copies one field of all events into a contiguous array, e.g.
+ *   window.gather<JPetHit>(times, &JPetHit::getTime);
+ *   window.gather<JPetHit>(scinIDs, [](const JPetHit& hit) { return hit.getScintillator().getID(); });
  */
 class JPetTimeWindow: public TObject
 {
@@ -38,7 +52,60 @@ public:
   template<typename T>
   void add(const T& evt)
   {
-    dynamic_cast<T&>(*(fEvents.ConstructedAt(fEventCount++))) = evt;
+    constructAt<T>(fEvents, fEventCount) = evt;
+  }
+
+  template<typename T, typename = typename std::enable_if<!std::is_lvalue_reference<T>::value>::type>
+  void add(T&& evt)
+  {
+    constructAt<typename std::decay<T>::type>(fEvents, fEventCount) = std::forward<T>(evt);
+  }
+
+  template<typename T, typename... Args>
+  T& emplace(Args&&... args)
+  {
+    auto& evt = constructAt<T>(fEvents, fEventCount);
+    evt = T(std::forward<Args>(args)...);
+    return evt;
+  }
+
+  template<typename T>
+  void addAll(const T* events, size_t size)
+  {
+    reserve(fEventCount + size);
+    for (size_t i = 0; i < size; i++)
+    {
+      add<T>(events[i]);
+    }
+  }
+
+  template<typename T>
+  void addAll(const std::vector<T>& events)
+  {
+    addAll<T>(events.data(), events.size());
+  }
+
+  template<typename T>
+  void addAll(std::vector<T>&& events)
+  {
+    reserve(fEventCount + events.size());
+    for (auto& evt : events)
+    {
+      add<T>(std::move(evt));
+    }
+  }
+
+  inline void reserve(size_t size)
+  {
+    if (static_cast<size_t>(fEvents.GetSize()) < size)
+    {
+      fEvents.Expand(size);
+    }
+  }
+
+  inline size_t getCapacity() const
+  {
+    return fEvents.GetSize();
   }
 
   inline size_t getNumberOfEvents() const
@@ -57,6 +124,56 @@ public:
     return *(dynamic_cast<T*>(fEvents[i]));
   }
 
+  /**
+   * The unchecked access is meant for the code which verified the event class
+   * once (see getEventClass), e.g. JPetTypedUserTask, and casts the elements statically.
+   */
+  template<typename T>
+  inline const T& getEventUnchecked(int i) const
+  {
+    return static_cast<const T&>(*fEvents.UncheckedAt(i));
+  }
+
+  template<typename T>
+  inline T& addUnchecked()
+  {
+    return static_cast<T&>(*fEvents.ConstructedAt(fEventCount++));
+  }
+
+  inline TClass* getEventClass() const
+  {
+    return fEvents.GetClass();
+  }
+
+  template<typename T>
+  JPetTimeWindowRange<const T> getEvents() const
+  {
+    return makeRange<const T>(fEvents, fEventCount);
+  }
+
+  template<typename T>
+  JPetTimeWindowRange<T> getEvents()
+  {
+    return makeRange<T>(fEvents, fEventCount);
+  }
+
+  template<typename T, typename Value, typename Getter>
+  void gather(std::vector<Value>& values, Getter getter) const
+  {
+    auto events = getEvents<T>();
+    values.resize(events.size());
+    for (size_t i = 0; i < events.size(); i++)
+    {
+      values[i] = getter(events[i]);
+    }
+  }
+
+  template<typename T, typename Value, typename Base>
+  void gather(std::vector<Value>& values, Value (Base::*getter)() const) const
+  {
+    gather<T>(values, std::mem_fn(getter));
+  }
+
   virtual ~JPetTimeWindow()
   {
     fEvents.Clear("C");
@@ -71,6 +188,24 @@ public:
 
   ClassDef(JPetTimeWindow, 5);
 
+protected:
+  template<typename T>
+  static T& constructAt(TClonesArray& array, unsigned int& count)
+  {
+    return dynamic_cast<T&>(*(array.ConstructedAt(count++)));
+  }
+
+  /// The class of the stored objects is checked once, std::bad_cast is thrown if it is not a T
+  template<typename T>
+  static JPetTimeWindowRange<T> makeRange(const TClonesArray& array, unsigned int count)
+  {
+    if (count > 0 && (!array.GetClass() || !array.GetClass()->InheritsFrom(std::remove_const<T>::type::Class())))
+    {
+      throw std::bad_cast();
+    }
+    return JPetTimeWindowRange<T>(array.GetObjectRef(), count);
+  }
+
 private:
   TClonesArray fEvents;
   unsigned int fEventCount = 0;
@@ -0,0 +1,141 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTimeWindowRange.h
+ */
+
+#ifndef JPETTIMEWINDOWRANGE_H
+#define JPETTIMEWINDOWRANGE_H
+
+#include <TObject.h>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief Random access iterator over the objects of type T stored in a TClonesArray
+ *
+ * The iterator walks the contiguous array of the object pointers of the TClonesArray
+ * and casts the objects statically, the type is checked once when the range is created.
+ * T can be const-qualified for the read-only access.
+ */
+template <typename T>
+class JPetTimeWindowIterator
+{
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename std::remove_const<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  JPetTimeWindowIterator() {}
+  explicit JPetTimeWindowIterator(TObject* const* slot) : fSlot(slot) {}
+
+  /// Conversion of the mutable iterator to the const one
+  template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+  JPetTimeWindowIterator(const JPetTimeWindowIterator<U>& other) : fSlot(other.getSlot())
+  {
+  }
+
+  reference operator*() const { return static_cast<reference>(**fSlot); }
+  pointer operator->() const { return static_cast<pointer>(*fSlot); }
+  reference operator[](difference_type n) const { return static_cast<reference>(*fSlot[n]); }
+
+  JPetTimeWindowIterator& operator++()
+  {
+    ++fSlot;
+    return *this;
+  }
+
+  JPetTimeWindowIterator operator++(int) { return JPetTimeWindowIterator(fSlot++); }
+
+  JPetTimeWindowIterator& operator--()
+  {
+    --fSlot;
+    return *this;
+  }
+
+  JPetTimeWindowIterator operator--(int) { return JPetTimeWindowIterator(fSlot--); }
+
+  JPetTimeWindowIterator& operator+=(difference_type n)
+  {
+    fSlot += n;
+    return *this;
+  }
+
+  JPetTimeWindowIterator& operator-=(difference_type n)
+  {
+    fSlot -= n;
+    return *this;
+  }
+
+  JPetTimeWindowIterator operator+(difference_type n) const { return JPetTimeWindowIterator(fSlot + n); }
+  JPetTimeWindowIterator operator-(difference_type n) const { return JPetTimeWindowIterator(fSlot - n); }
+  friend JPetTimeWindowIterator operator+(difference_type n, const JPetTimeWindowIterator& it) { return it + n; }
+  difference_type operator-(const JPetTimeWindowIterator& other) const { return fSlot - other.fSlot; }
+
+  bool operator==(const JPetTimeWindowIterator& other) const { return fSlot == other.fSlot; }
+  bool operator!=(const JPetTimeWindowIterator& other) const { return fSlot != other.fSlot; }
+  bool operator<(const JPetTimeWindowIterator& other) const { return fSlot < other.fSlot; }
+  bool operator>(const JPetTimeWindowIterator& other) const { return fSlot > other.fSlot; }
+  bool operator<=(const JPetTimeWindowIterator& other) const { return fSlot <= other.fSlot; }
+  bool operator>=(const JPetTimeWindowIterator& other) const { return fSlot >= other.fSlot; }
+
+  TObject* const* getSlot() const { return fSlot; }
+
+private:
+  TObject* const* fSlot = nullptr;
+};
+
+/**
+ * @brief Typed view of the events of a time window, compatible with the STL algorithms
+ *
+ * The range is returned by JPetTimeWindow::getEvents<T>() and JPetTimeWindowMC::getMCHits<T>()
+ * or getDecayTrees<T>() and is valid until the window is modified or cleared. Since the iterators
+ * are random access, the mutable ranges can be sorted or partitioned in place, e.g.
+ *   auto hits = window.getEvents<JPetHit>();
+ *   std::sort(hits.begin(), hits.end(), [](const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); });
+ * which swaps the objects, not the slots of the TClonesArray. The ranges can be split
+ * between threads as well, as long as each thread modifies different elements.
+ */
+template <typename T>
+class JPetTimeWindowRange
+{
+public:
+  using value_type = typename std::remove_const<T>::type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const value_type&;
+  using iterator = JPetTimeWindowIterator<T>;
+  using const_iterator = JPetTimeWindowIterator<const value_type>;
+
+  JPetTimeWindowRange() {}
+  JPetTimeWindowRange(TObject* const* first, std::size_t size) : fFirst(first), fSize(size) {}
+
+  iterator begin() const { return iterator(fFirst); }
+  iterator end() const { return iterator(fFirst + fSize); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  std::size_t size() const { return fSize; }
+  bool empty() const { return fSize == 0; }
+  reference operator[](std::size_t i) const { return static_cast<reference>(*fFirst[i]); }
+  reference front() const { return (*this)[0]; }
+  reference back() const { return (*this)[fSize - 1]; }
+
+private:
+  TObject* const* fFirst = nullptr;
+  std::size_t fSize = 0;
+};
+
+#endif /* !JPETTIMEWINDOWRANGE_H */
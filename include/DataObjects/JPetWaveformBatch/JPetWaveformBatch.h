@@ -0,0 +1,87 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWaveformBatch.h
+ */
+
+#ifndef JPETWAVEFORMBATCH_H
+#define JPETWAVEFORMBATCH_H
+
+#include "./JPetRecoSignal/JPetRecoSignal.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Structure-of-arrays storage of many sampled signal shapes
+ *
+ * The shapes of all signals added to the batch are kept in two contiguous
+ * float arrays (times in [ps] and amplitudes in [mV]), one signal after another,
+ * with the position of every signal given by an offsets array.
+ * The calculate* methods process all signals of the batch at once, with the inner
+ * loops written over fixed-width lanes, so that the compiler can vectorize them.
+ *
+ * Signals are assumed to be negative pulses (as registered by the scope),
+ * sorted by time. All properties are expressed as positive values with respect
+ * to the baseline, e.g. a threshold of 50 mV means 50 mV below the baseline.
+ * Times and thresholds for signals without a crossing are set to Unset.
+ */
+class JPetWaveformBatch
+{
+public:
+  static const float Unset;
+  static const std::size_t kLaneWidth = 8;
+
+  void clear();
+  void reserve(std::size_t nSignals, std::size_t nPointsPerSignal);
+  std::size_t addSignal(const JPetRecoSignal& signal);
+  void addSignals(const JPetTimeWindow& window);
+
+  std::size_t getNumberOfSignals() const
+  {
+    return fOffsets.size() - 1;
+  }
+
+  std::size_t getNumberOfPoints(std::size_t signal) const
+  {
+    return fOffsets[signal + 1] - fOffsets[signal];
+  }
+
+  const float* getTimes(std::size_t signal) const
+  {
+    return fTimes.data() + fOffsets[signal];
+  }
+
+  const float* getAmplitudes(std::size_t signal) const
+  {
+    return fAmplitudes.data() + fOffsets[signal];
+  }
+
+  void calculateBaselines(std::size_t nBaselinePoints, std::vector<float>& baselines) const;
+  void calculateAmplitudes(const std::vector<float>& baselines, std::vector<float>& amplitudes) const;
+  void calculateCharges(const std::vector<float>& baselines, std::vector<float>& charges) const;
+  void calculateThresholdTimes(const std::vector<float>& baselines, float threshold, std::vector<float>& times) const;
+  void calculateConstantFractionTimes(const std::vector<float>& baselines, const std::vector<float>& amplitudes, float fraction,
+                                      std::vector<float>& times) const;
+
+  static float mean(const float* values, std::size_t size);
+  static float maxDepth(const float* amplitudes, std::size_t size, float baseline);
+  static float integrateDepth(const float* times, const float* amplitudes, std::size_t size, float baseline);
+  static float crossingTime(const float* times, const float* amplitudes, std::size_t size, float level);
+
+private:
+  std::vector<float> fTimes;
+  std::vector<float> fAmplitudes;
+  std::vector<std::size_t> fOffsets = {0};
+};
+
+#endif /* !JPETWAVEFORMBATCH_H */
@@ -58,13 +58,51 @@ public:
   template<typename T>
   void addMCHit(const T& evt)
   {
-    dynamic_cast<T&>(*(fMCHits.ConstructedAt(fMCHitsCount++))) = evt;
+    constructAt<T>(fMCHits, fMCHitsCount) = evt;
+  }
+
+  template<typename T, typename = typename std::enable_if<!std::is_lvalue_reference<T>::value>::type>
+  void addMCHit(T&& evt)
+  {
+    constructAt<typename std::decay<T>::type>(fMCHits, fMCHitsCount) = std::forward<T>(evt);
+  }
+
+  template<typename T, typename... Args>
+  T& emplaceMCHit(Args&&... args)
+  {
+    auto& evt = constructAt<T>(fMCHits, fMCHitsCount);
+    evt = T(std::forward<Args>(args)...);
+    return evt;
+  }
+
+  template<typename T>
+  void addMCHits(const std::vector<T>& hits)
+  {
+    for (const auto& hit : hits)
+    {
+      addMCHit<T>(hit);
+    }
+  }
+
+  template<typename T>
+  void addMCHits(std::vector<T>&& hits)
+  {
+    for (auto& hit : hits)
+    {
+      addMCHit<T>(std::move(hit));
+    }
   }
 
   template<typename T>
   void addDecayTree(const T& evt)
   {
-    dynamic_cast<T&>(*(fDecayTrees.ConstructedAt(fDecayTreesCount++))) = evt;
+    constructAt<T>(fDecayTrees, fDecayTreesCount) = evt;
+  }
+
+  template<typename T, typename = typename std::enable_if<!std::is_lvalue_reference<T>::value>::type>
+  void addDecayTree(T&& evt)
+  {
+    constructAt<typename std::decay<T>::type>(fDecayTrees, fDecayTreesCount) = std::forward<T>(evt);
   }
 
   inline size_t getNumberOfMCHits() const
@@ -89,6 +127,30 @@ public:
     return *(dynamic_cast<T*>(fDecayTrees[i]));
   }
 
+  template<typename T>
+  JPetTimeWindowRange<const T> getMCHits() const
+  {
+    return makeRange<const T>(fMCHits, fMCHitsCount);
+  }
+
+  template<typename T>
+  JPetTimeWindowRange<T> getMCHits()
+  {
+    return makeRange<T>(fMCHits, fMCHitsCount);
+  }
+
+  template<typename T>
+  JPetTimeWindowRange<const T> getDecayTrees() const
+  {
+    return makeRange<const T>(fDecayTrees, fDecayTreesCount);
+  }
+
+  template<typename T>
+  JPetTimeWindowRange<T> getDecayTrees()
+  {
+    return makeRange<T>(fDecayTrees, fDecayTreesCount);
+  }
+
 
   virtual ~JPetTimeWindowMC()
   {
@@ -34,6 +34,7 @@ public:
   void addValidatorFunction(const std::string& name, bool(*validatorFunction)(std::pair <std::string, boost::any>));
   static bool isNumberBoundsInRangeValid(std::pair <std::string, boost::any> option);
   static bool isRangeOfEventsValid(std::pair <std::string, boost::any> option);
+  static bool isShardValid(std::pair <std::string, boost::any> option);
   static bool isCorrectFileType(std::pair <std::string, boost::any> option);
   static bool isFileTypeMatchingExtensions(std::pair<std::string, boost::any> option);
   static bool isRunIdValid(std::pair <std::string, boost::any> option);
@@ -0,0 +1,114 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetOptions.h
+ */
+
+#ifndef JPETOPTIONS_H
+#define JPETOPTIONS_H
+
+#include <boost/any.hpp>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Immutable set of options shared by pointer
+ *
+ * The options are created once from the map of the "name_type" keys
+ * (jpet_options_tools::OptsStrAny) and shared between the copies of JPetParams
+ * and the tasks, so the map is never copied to read an option. The map is still
+ * available with getMap() for the functions from jpet_options_tools.
+ *
+ * The option names are interned: a Key, constructed once (e.g. as a static object),
+ * gets the unique index of its name, and the value is found by this index
+ * in a vector instead of comparing the strings in the map:
+ *
+ *   static const JPetOptions::Key kThresholdKey("Thresholds_std::vector<int>");
+ *   auto thresholds = options->get<std::vector<int>>(kThresholdKey);
+ *
+ * The requested type must be the one given by the type suffix of the name.
+ */
+class JPetOptions
+{
+public:
+  using OptsStrAny = std::map<std::string, boost::any>;
+  using Ptr = std::shared_ptr<const JPetOptions>;
+
+  /**
+   * @brief Interned name of an option
+   */
+  class Key
+  {
+  public:
+    explicit Key(const std::string& name);
+    const std::string& getName() const { return fName; }
+    std::size_t getId() const { return fId; }
+
+  private:
+    std::string fName;
+    std::size_t fId;
+  };
+
+  static Ptr create(const OptsStrAny& options);
+  static Ptr create(OptsStrAny&& options);
+  static Ptr getEmpty();
+
+  explicit JPetOptions(OptsStrAny options);
+  const OptsStrAny& getMap() const { return fOptions; }
+  std::size_t size() const { return fOptions.size(); }
+
+  bool isSet(const Key& key) const { return find(key) != nullptr; }
+  const boost::any* find(const Key& key) const { return key.getId() < fValues.size() ? fValues[key.getId()] : nullptr; }
+
+  /// @return pointer to the value, or nullptr if the option is not set or has a different type
+  template <class T>
+  const T* getIf(const Key& key) const
+  {
+    auto value = find(key);
+    return value ? boost::any_cast<T>(value) : nullptr;
+  }
+
+  /// @throw std::out_of_range if the option is not set, boost::bad_any_cast if it has a different type
+  template <class T>
+  const T& get(const Key& key) const
+  {
+    auto value = find(key);
+    if (!value)
+    {
+      throw std::out_of_range("Option " + key.getName() + " is not set");
+    }
+    return boost::any_cast<const T&>(*value);
+  }
+
+  /// @return value of the option, or defaultValue if the option is not set
+  template <class T>
+  T get(const Key& key, const T& defaultValue) const
+  {
+    auto value = find(key);
+    return value ? boost::any_cast<const T&>(*value) : defaultValue;
+  }
+
+private:
+  static std::size_t intern(const std::string& name);
+
+  JPetOptions(const JPetOptions&);
+  void operator=(const JPetOptions&);
+
+  OptsStrAny fOptions;
+  /// values in fOptions indexed with the ids of the names
+  std::vector<const boost::any*> fValues;
+};
+
+#endif /* !JPETOPTIONS_H */
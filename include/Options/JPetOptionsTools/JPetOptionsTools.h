@@ -49,6 +49,8 @@ std::string getOutputPath(const OptsStrAny& opts);
 long long getFirstEvent(const OptsStrAny& opts);
 long long getLastEvent(const OptsStrAny& opts);
 long long getTotalEvents(const OptsStrAny& opts);
+int getShardIndex(const OptsStrAny& opts);
+int getNumberOfShards(const OptsStrAny& opts);
 int getRunNumber(const OptsStrAny& opts);
 bool isProgressBar(const OptsStrAny& opts);
 bool isLocalDB(const OptsStrAny& opts);
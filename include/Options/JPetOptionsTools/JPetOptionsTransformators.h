@@ -28,6 +28,8 @@ using Transformer = std::function<OptNameValPair(boost::any opt)>;
 std::pair <std::string, boost::any>appendSlash(boost::any option);
 std::pair <std::string, boost::any>generateLowerEventBound(boost::any option);
 std::pair <std::string, boost::any>generateHigherEventBound(boost::any option);
+std::pair <std::string, boost::any>generateShardIndex(boost::any option);
+std::pair <std::string, boost::any>generateNumberOfShards(boost::any option);
 Transformer generateSetFileTypeTransformator(const std::map<std::string, boost::any>& options);
 }
 #endif /* !JPETOPTIONSTRANSFORMATORS_H */
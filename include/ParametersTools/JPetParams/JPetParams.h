@@ -18,23 +18,32 @@
 
 #include "./JPetParamManager/JPetParamManager.h"
 #include "./JPetOptionsTools/JPetOptionsTools.h"
+#include "./JPetOptionsTools/JPetOptions.h"
 #include <boost/any.hpp>
 #include <string>
 #include <memory>
 #include <map>
 
+/**
+ * @brief Options and parameters passed to the tasks
+ *
+ * The options are kept in the immutable JPetOptions object, shared by all the copies
+ * of JPetParams, so neither copying the parameters nor reading the options copies the map.
+ */
 class JPetParams
 {
 public:
   JPetParams();
   JPetParams(const jpet_options_tools::OptsStrAny& opts, std::shared_ptr<JPetParamManager> mgr);
-  jpet_options_tools::OptsStrAny getOptions() const;
+  JPetParams(JPetOptions::Ptr opts, std::shared_ptr<JPetParamManager> mgr);
+  const jpet_options_tools::OptsStrAny& getOptions() const;
+  JPetOptions::Ptr getSharedOptions() const;
   JPetParamManager* getParamManager() const;
   std::shared_ptr<JPetParamManager> getParamManagerAsShared() const;
   void setParamManager(std::shared_ptr<JPetParamManager> mgr);
 
 protected:
-  jpet_options_tools::OptsStrAny fOptions;
+  JPetOptions::Ptr fOptions;
   std::shared_ptr<JPetParamManager> fParamManager;
 };
 #endif /* !JPETPARAMS_H */
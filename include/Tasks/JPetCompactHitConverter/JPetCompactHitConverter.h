@@ -0,0 +1,49 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetCompactHitConverter.h
+ */
+
+#ifndef JPETCOMPACTHITCONVERTER_H
+#define JPETCOMPACTHITCONVERTER_H
+
+#include "./JPetCompactHit/JPetCompactHit.h"
+#include "./JPetCompactHit/JPetCompactHitWindow.h"
+#include "./JPetUserTask/JPetUserTask.h"
+#include <string>
+
+/**
+ * @brief Converts the time windows of JPetHit into the time windows of JPetCompactHit
+ *
+ * The stage is meant to be put after the hit reconstruction, so that the LOR and event
+ * level tasks read the compact hits only. If the JPetCompactHitConverter_KeepSignals_bool
+ * option is set, the signals of the hits are stored in the side array of JPetCompactHitWindow
+ * and referenced by index from the compact hits, by default they are dropped.
+ * For the Monte Carlo input the output is written as JPetTimeWindowMC, so the signals are not kept.
+ */
+class JPetCompactHitConverter: public JPetUserTask
+{
+public:
+  static const std::string kKeepSignalsKey;
+
+  JPetCompactHitConverter(const char* name = "JPetCompactHitConverter");
+  virtual ~JPetCompactHitConverter();
+  virtual bool init() override;
+  virtual bool exec() override;
+  virtual bool terminate() override;
+  static JPetCompactHit convert(const JPetHit& hit, JPetCompactHitWindow* signals = nullptr);
+
+private:
+  bool fKeepSignals = false;
+};
+
+#endif /* !JPETCOMPACTHITCONVERTER_H */
@@ -0,0 +1,153 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDDecoder.h
+ */
+
+#ifndef JPETHLDDECODER_H
+#define JPETHLDDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class JPetStreamDecompressor;
+
+/**
+ * @brief Single edge registered by a TDC channel
+ *
+ * The channel is the global channel number (channel offset of the TDC plus the channel
+ * number within the TDC), as in the output of the Unpacker2. The time in [ps]
+ * is given relative to the reference channel of the same TDC.
+ */
+struct JPetHLDChannelHit
+{
+  unsigned int channel = 0;
+  double time = 0.0;
+  bool isLeading = true;
+};
+
+/**
+ * @brief Content of a single HLD event (one readout of the DAQ)
+ */
+struct JPetHLDEvent
+{
+  void clear()
+  {
+    hits.clear();
+    hitsWithoutReference = 0;
+  }
+  std::uint32_t sequenceNumber = 0;
+  std::uint32_t runNumber = 0;
+  std::vector<JPetHLDChannelHit> hits;
+  unsigned int hitsWithoutReference = 0;
+};
+
+/**
+ * @brief Streaming decoder of HLD files with TRB3 TDC data
+ *
+ * The file is read event by event, plain or compressed (.gz, .xz, .bz2, decompressed
+ * on the fly by JPetStreamDecompressor), so no intermediate file is needed.
+ * The TDC endpoints are described by the same XML file as used by the Unpacker2
+ * (MODULE entries with TRBNET_ADDRESS, CHANNEL_OFFSET and NUMBER_OF_CHANNELS).
+ * Data of endpoints not present in the configuration are skipped. Blocks of the
+ * DATA_SOURCE (hub) addresses are searched for the endpoint data recursively.
+ *
+ * Times are calculated with a linear fine time calibration within the configured
+ * range of fine time counter values; channel 0 of every TDC is the reference channel
+ * and is not returned in the hits. Events without any subevent (e.g. the file header
+ * written by the DAQ) are skipped and not counted.
+ *
+ * Plain files can be read from any event with seek(), using the offsets from JPetHLDIndex,
+ * and up to the given end offset, so independent byte ranges can be decoded in parallel.
+ */
+class JPetHLDDecoder
+{
+public:
+  struct TDCModule
+  {
+    unsigned int channelOffset;
+    unsigned int numberOfChannels;
+  };
+
+  static const std::size_t kEventHeaderSize = 32;
+  static const std::size_t kSubEventHeaderSize = 16;
+  static const std::size_t kMaxEventSize = 1 << 26;
+  static const unsigned int kDefaultFineTimeMin = 15;
+  static const unsigned int kDefaultFineTimeMax = 500;
+  static const double kCoarseTimeUnit;
+
+  JPetHLDDecoder();
+  ~JPetHLDDecoder();
+  JPetHLDDecoder(const JPetHLDDecoder&) = delete;
+  JPetHLDDecoder& operator=(const JPetHLDDecoder&) = delete;
+
+  bool loadConfig(const std::string& configFileName);
+  void addTDC(unsigned int address, unsigned int channelOffset, unsigned int numberOfChannels);
+  void addHub(unsigned int address);
+  void setFineTimeRange(unsigned int min, unsigned int max);
+  const std::map<unsigned int, TDCModule>& getTDCs() const { return fTDCs; }
+
+  void setConfiguration(const JPetHLDDecoder& other);
+
+  bool open(const std::string& fileName, unsigned int nThreads = 1);
+  void close();
+  bool isSeekable() const { return fFile != nullptr; }
+  bool seek(std::uint64_t offset, long long eventNumber);
+  void setEndOffset(std::uint64_t endOffset) { fEndOffset = endOffset; }
+  std::uint64_t getCurrentOffset() const { return fOffset; }
+  bool nextEvent(JPetHLDEvent& event);
+  long long skipEvents(long long nEvents);
+  long long getNumberOfReadEvents() const { return fNumberOfReadEvents; }
+  bool hasError() const { return fError; }
+
+  static bool readEventSize(const char* header, std::size_t& size);
+
+  bool decodeEvent(const char* data, std::size_t size, JPetHLDEvent& event);
+
+private:
+  struct RawHit
+  {
+    unsigned int channel;
+    std::uint64_t coarse;
+    unsigned int fine;
+    bool isLeading;
+  };
+
+  bool readEvent();
+  std::size_t readBytes(char* buffer, std::size_t size);
+  void decodeBlocks(const char* data, std::size_t nWords, bool swapped, JPetHLDEvent& event);
+  void decodeTDC(const char* data, std::size_t nWords, bool swapped, const TDCModule& tdc, JPetHLDEvent& event);
+  double getFineTime(unsigned int fine) const;
+  void setError(const std::string& message);
+
+  std::map<unsigned int, TDCModule> fTDCs;
+  std::set<unsigned int> fHubs;
+  unsigned int fFineTimeMin = kDefaultFineTimeMin;
+  unsigned int fFineTimeMax = kDefaultFineTimeMax;
+  std::string fFileName;
+  std::FILE* fFile = nullptr;
+  std::unique_ptr<JPetStreamDecompressor> fDecompressor;
+  std::vector<char> fBuffer;
+  std::vector<RawHit> fRawHits;
+  std::uint64_t fOffset = 0;
+  std::uint64_t fEndOffset = 0;
+  long long fNumberOfReadEvents = 0;
+  bool fError = false;
+};
+
+#endif /* !JPETHLDDECODER_H */
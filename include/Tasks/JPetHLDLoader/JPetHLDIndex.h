@@ -0,0 +1,65 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDIndex.h
+ */
+
+#ifndef JPETHLDINDEX_H
+#define JPETHLDINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Byte offsets of the events in a plain HLD file
+ *
+ * The index is built by reading only the event headers, so it is much faster
+ * than the decoding of the file. It is stored in a sidecar file next to the HLD file
+ * (the HLD file name with the .idx suffix) and reused by the later runs, as long as
+ * the size and modification time of the HLD file are unchanged. Events are counted
+ * as in JPetHLDDecoder, i.e. the events without any subevent are skipped.
+ *
+ * With the index the decoding can start at any event (JPetHLDDecoder::seek())
+ * and a range of events can be split into independent byte ranges.
+ */
+class JPetHLDIndex
+{
+public:
+  struct Range
+  {
+    long long firstEvent;
+    long long lastEvent;
+    std::uint64_t beginOffset;
+    std::uint64_t endOffset;
+  };
+
+  static std::string getIndexFileName(const std::string& hldFileName);
+
+  bool loadOrBuild(const std::string& hldFileName);
+  bool build(const std::string& hldFileName);
+  bool load(const std::string& hldFileName);
+  bool save(const std::string& hldFileName) const;
+
+  long long getNumberOfEvents() const { return fOffsets.size(); }
+  std::uint64_t getEventOffset(long long event) const;
+  std::uint64_t getFileSize() const { return fFileSize; }
+  Range getRange(long long firstEvent, long long lastEvent) const;
+  std::vector<Range> split(long long firstEvent, long long lastEvent, unsigned int nParts) const;
+
+private:
+  std::vector<std::uint64_t> fOffsets;
+  std::uint64_t fFileSize = 0;
+  std::int64_t fModificationTime = 0;
+};
+
+#endif /* !JPETHLDINDEX_H */
@@ -0,0 +1,82 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDLoader.h
+ */
+
+#ifndef JPETHLDLOADER_H
+#define JPETHLDLOADER_H
+
+#include "./JPetHLDLoader/JPetHLDDecoder.h"
+#include "./JPetHLDLoader/JPetHLDIndex.h"
+#include "./JPetTaskIO/JPetTaskIO.h"
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+class JPetParamBank;
+class JPetTimeWindow;
+
+/**
+ * @brief Task reading the HLD file directly, without the intermediate hld.root file
+ *
+ * It plays the role of JPetTaskIO for the first user task in the chain, when
+ * the JPetHLDLoader_NativeDecoding_bool option is set and the input file is
+ * an hld file (plain or compressed). Every HLD event is decoded by JPetHLDDecoder
+ * and converted to a JPetTimeWindow of JPetSigCh objects, which is passed
+ * to the user task in place of the Unpacker2 event. The JPetUnzipAndUnpackTask
+ * does not run the Unpacker2 in this mode.
+ *
+ * The TDC endpoints are read from the unpacker configuration file and the global
+ * channel numbers are mapped to the TOMB channels of the parameter bank.
+ * The linear fine time calibration range can be changed with
+ * JPetHLDLoader_FineTimeMin_int and JPetHLDLoader_FineTimeMax_int.
+ *
+ * For plain hld files the JPetHLDIndex is used to start directly at the first requested
+ * event and, with JPetHLDLoader_DecodingThreads_int larger than 1, to decode
+ * the events in parallel in independent byte ranges of the file.
+ */
+class JPetHLDLoader: public JPetTaskIO
+{
+public:
+  JPetHLDLoader(const char* name = "", const char* out_file_type = "");
+  virtual ~JPetHLDLoader();
+  virtual bool run(const JPetDataInterface& inData) override;
+  virtual bool terminate(JPetParams& outOptions) override;
+  static bool isNativeDecodingOn(const jpet_options_tools::OptsStrAny& options);
+  void fillTimeWindow(const JPetHLDEvent& event, const JPetParamBank& bank, JPetTimeWindow& window);
+
+  static const std::string kNativeDecodingKey;
+  static const std::string kFineTimeMinKey;
+  static const std::string kFineTimeMaxKey;
+  static const std::string kDecompressionThreadsKey;
+  static const std::string kDecodingThreadsKey;
+  static const std::string kUseIndexKey;
+  static const long long kEventsPerBatch = 1000;
+
+protected:
+  bool createInputObjects(const char* inputFilename) override;
+  std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(
+    const jpet_options_tools::OptsStrAny options) const override;
+  bool runParallel(long long firstEvent, long long lastEvent, const std::function<bool(const JPetHLDEvent&, long long)>& processEvent);
+  bool decodeRange(const JPetHLDIndex::Range& range, std::vector<JPetHLDEvent>& events) const;
+  JPetHLDDecoder fDecoder;
+  JPetHLDIndex fIndex;
+  bool fHasIndex = false;
+  unsigned int fDecodingThreads = 1;
+  std::string fInputFileName;
+  std::set<unsigned int> fUnknownChannels;
+  long long fHitsWithoutReference = 0;
+};
+
+#endif /* !JPETHLDLOADER_H */
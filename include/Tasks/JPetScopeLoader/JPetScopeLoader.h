@@ -23,6 +23,7 @@
 #include "./JPetTask/JPetTask.h"
 #include <cstddef>
 #include <fstream>
+#include <functional>
 #include <vector>
 #include <string>
 #include <set>
@@ -47,6 +48,14 @@ class JPetWriter;
  * map contains a set of file names corresponding to the signals and (second int)
  * photomultiplier ids bound to given signal.
  *
+ * The input directory is scanned in a streaming way: a time window is scheduled
+ * for processing once files for all photomultipliers prefixes were found and no window
+ * with a lower index is still waiting for its files. The indices need not start from 0
+ * nor be consecutive.
+ * The files of several time windows are decoded in parallel by JPetScopeFileParser,
+ * the number of threads is given by the JPetScopeLoader_NumberOfDecodingThreads_int
+ * user option (by default the number of hardware threads).
+ *
  * Please, note that this class overrides the createInputObjects, createOutputObjects
  * and setInputAndOutputFile methods from JPetTaskIO class. The overriden method
  * setInputAndOutputFile is called init() in the original JPetTaskIO.
@@ -55,6 +64,7 @@ class JPetWriter;
 class JPetScopeLoader: public JPetTaskIO
 {
 public:
+  using TimeWindowFiles = std::pair<int, std::map<std::string, int>>;
   JPetScopeLoader(std::unique_ptr<JPetScopeTask> task);
   virtual ~JPetScopeLoader();
   virtual bool init(const JPetParams& opts) override;
@@ -64,19 +74,29 @@ public:
   static std::map<int, std::map<std::string, int>> groupScopeFileNamesByTimeWindowIndex(
     const std::map<std::string, int>& scopeFileNames);
   static int getTimeWindowIndex(const std::string&  pathAndFileName);
+  static int parseTimeWindowIndex(const std::string& fileName);
   std::map<std::string, int> createInputScopeFileNames(
     const std::string& inputPathToScopeFiles,
     std::map<std::string, int> pmPref2Id
   ) const;
+  bool scanInputScopeFiles(
+    const std::string& inputPathToScopeFiles,
+    const std::map<std::string, int>& pmPref2Id,
+    const std::function<bool(TimeWindowFiles&&)>& onTimeWindow
+  ) const;
   std::map<std::string, int> getPMPrefixToPMIdMap();
   bool isCorrectScopeFileName(const std::string& filename) const;
   std::string getFilePrefix(const std::string& filename) const;
 
 protected:
+  bool processTimeWindows(std::vector<TimeWindowFiles>& timeWindows, unsigned int nThreads);
+  unsigned int getNumberOfDecodingThreads(const jpet_options_tools::OptsStrAny& opts) const;
   bool createInputObjects(const char*) override;
   bool createOutputObjects(const char*) override;
   std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(
     const jpet_options_tools::OptsStrAny options) const override;
+  const std::string kNumberOfDecodingThreadsKey = "JPetScopeLoader_NumberOfDecodingThreads_int";
+  const std::size_t kFilesPerThreadInBatch = 64;
 };
 
 #endif /* !_SCOPE_LOADER_MODULE_H_ */
@@ -0,0 +1,53 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeFileParser.h
+ */
+
+#ifndef JPETSCOPEFILEPARSER_H
+#define JPETSCOPEFILEPARSER_H
+
+#include "./JPetRecoSignal/JPetRecoSignal.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Decoder of the oscilloscope ASCII files into JPetRecoSignal objects.
+ *
+ * The files are memory mapped and the numbers are parsed with a simple
+ * locale independent parser, instead of reading them line by line with
+ * fgets/fscanf. The format is the same as the one accepted before:
+ * five header lines (the fourth word of the second line is the number of points),
+ * followed by the pairs of time [s] and amplitude [V]. Files with the .tsv extension
+ * have no header. The parseFiles method decodes a set of files using several threads,
+ * the order of the returned signals is the same as the order of the file names.
+ */
+class JPetScopeFileParser
+{
+public:
+  static JPetRecoSignal parseFile(const std::string& fileName);
+  static std::vector<JPetRecoSignal> parseFiles(const std::vector<std::string>& fileNames, unsigned int nThreads);
+  static JPetRecoSignal parseContent(const char* begin, const char* end, bool hasHeader, const std::string& fileName = "");
+  /// Parses the number starting at pos (leading blanks and new lines are skipped).
+  /// In case of success pos is moved after the number and true is returned.
+  static bool parseNumber(const char*& pos, const char* end, double& value);
+
+  static constexpr double kSecondsToPs = 1.0e+12;
+  static constexpr double kVoltsTomV = 1.0e+3;
+  static const int kNumberOfHeaderLines = 5;
+
+private:
+  static const char* skipLine(const char* pos, const char* end);
+  static const char* skipWord(const char* pos, const char* end);
+};
+
+#endif /* !JPETSCOPEFILEPARSER_H */
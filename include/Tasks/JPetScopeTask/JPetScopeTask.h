@@ -17,11 +17,18 @@
 #define JPETSCOPETASK_H
 
 #include "JPetUserTask/JPetUserTask.h"
+#include "JPetWaveformBatch/JPetWaveformBatch.h"
 #include <string>
+#include <vector>
 #include <map>
 
 /**
  * @brief Module for oscilloscope data
+ *
+ * If JPetScopeTask_CalculateSignalProperties_bool is set, the offset, amplitude and charge
+ * of all signals in the time window are calculated in one pass over a JPetWaveformBatch,
+ * together with the times at the constant fraction JPetScopeTask_ConstantFraction_float
+ * and at the thresholds JPetScopeTask_Thresholds_std::vector<int> [mV].
  */
 class JPetScopeTask: public JPetUserTask
 {
@@ -34,7 +41,20 @@ protected:
   bool init() override;
   bool exec() override;
   bool terminate() override;
+  void calculateSignalProperties(std::vector<JPetRecoSignal>& signals);
+  const std::string kCalculateSignalPropertiesParamKey = "JPetScopeTask_CalculateSignalProperties_bool";
+  const std::string kBaselinePointsParamKey = "JPetScopeTask_BaselinePoints_int";
+  const std::string kConstantFractionParamKey = "JPetScopeTask_ConstantFraction_float";
+  const std::string kThresholdsParamKey = "JPetScopeTask_Thresholds_std::vector<int>";
+  bool fCalculateSignalProperties = false;
+  int fBaselinePoints = 50;
+  float fConstantFraction = 0.5f;
+  std::vector<int> fThresholds;
+  JPetWaveformBatch fWaveforms;
+  std::vector<JPetRecoSignal> fSignals;
   std::pair<int, std::map<std::string, int>> fInputFilesInCurrentWindow;
+  /// Signals decoded in advance by JPetScopeLoader, valid only during the exec() call.
+  const std::vector<JPetRecoSignal>* fDecodedSignals = nullptr;
 };
 
 #endif /* !JPETSCOPETASK_H */
@@ -24,52 +24,98 @@
 #endif
 #include <boost/numeric/ublas/io.hpp>
 #include <boost/numeric/ublas/vector.hpp>
+#include <cmath>
 
 /**
  * @brief Helper mathematical functions used in the reconstruction
  */
 namespace ublas = boost::numeric::ublas;
 
-float polynomialFit(const ublas::vector<float>& t, const ublas::vector<float>& v_source, int alfa, float v0) {
-  ublas::vector<float> v(v_source);
-  int K;
-  float tSig = -1.0;
-  float a, b;
-  float meanT = 0.0;
-  float meanV = 0.0;
-  float sx = 0.0;
-  float sxy = 0.0;
-  if (v.size() != t.size())
-    return tSig;
-  K = v.size();
-  if ((K < 2) || (alfa < 1)) {
-    if (K == 1) {
-      tSig = t(0);
+/**
+ * @brief Leading-edge fit of the signal time, configured once with alpha and the selected threshold
+ *
+ * The points (t_i, v_i) are transformed to (t_i, (-v_i)^(1/alpha)) and fitted with a straight line,
+ * the returned time is the crossing of the line with (-v0)^(1/alpha).
+ * The 1/alpha root of the selected threshold is precomputed in the constructor and the most common
+ * cases alpha = 1 and alpha = 2 avoid calling pow. Neither fit() nor fitAll() allocate memory,
+ * fitAll() works on the structure-of-arrays layout: points of the signal i occupy the
+ * range [offsets[i], offsets[i+1]) of the time and threshold arrays.
+ */
+class LeadingEdgeFitter
+{
+public:
+  explicit LeadingEdgeFitter(int alfa = 1, float v0 = 0.0) : fAlfa(alfa < 1 ? 1 : alfa), fInvAlfa(1.0 / fAlfa)
+  {
+    fV0Root = root(v0 > 0.0 ? 0.0 : v0);
+  }
+
+  inline int getAlpha() const { return fAlfa; }
+
+  inline float fit(const float* t, const float* v, int K) const
+  {
+    if (K < 2) {
+      return K == 1 ? t[0] : -1.0;
+    }
+    // Single pass with the times shifted by t[0] and double accumulators,
+    // numerically equivalent to the two-pass mean-centred formula.
+    const double t0 = t[0];
+    double sumT = 0.0, sumV = 0.0, sumTT = 0.0, sumTV = 0.0;
+    for (int i = 0; i < K; i++) {
+      const double dt = t[i] - t0;
+      const double r = root(v[i]);
+      sumT += dt;
+      sumV += r;
+      sumTT += dt * dt;
+      sumTV += dt * r;
+    }
+    const double meanT = sumT / K;
+    const double meanV = sumV / K;
+    const double sx = sumTT - sumT * meanT;
+    const double sxy = sumTV - sumT * meanV;
+    const double a = sxy / sx;
+    if (!(std::fabs(a) >= 1e-10)) {
+      return t[0];
     }
-    return tSig;
+    const double b = meanV - a * meanT;
+    return static_cast<float>(t0 + (fV0Root - b) / a);
   }
-  for (int i = 0; i < K; i++)
-    v(i) = pow(-v(i), 1.0 / alfa);
-  for (int i = 0; i < K; i++) {
-    meanT = meanT + t(i);
-    meanV = meanV + v(i);
+
+  inline void fitAll(const float* t, const float* v, const int* offsets, int nSignals, float* results) const
+  {
+    for (int i = 0; i < nSignals; i++) {
+      results[i] = fit(t + offsets[i], v + offsets[i], offsets[i + 1] - offsets[i]);
+    }
   }
-  meanT = meanT / K;
-  meanV = meanV / K;
-  for (int i = 0; i < K; i++) {
-    sx = sx + (t(i) - meanT) * (t(i) - meanT);
-    sxy = sxy + (t(i) - meanT) * (v(i) - meanV);
+
+private:
+  inline double root(float v) const
+  {
+    switch (fAlfa) {
+    case 1:
+      return -v;
+    case 2:
+      return std::sqrt(-v);
+    default:
+      return std::pow(-v, fInvAlfa);
+    }
   }
-  a = sxy / sx;
-  b = meanV - a * meanT;
-  if (fabs(a) < 1e-10)
-    tSig = t(0);
-  else {
-    if (v0 > 0.0)
-      v0 = 0.0;
-    tSig = (pow(-v0, 1.0 / alfa) - b) / a;
+
+  int fAlfa = 1;
+  double fInvAlfa = 1.0;
+  double fV0Root = 0.0;
+};
+
+inline float polynomialFit(const ublas::vector<float>& t, const ublas::vector<float>& v, int alfa, float v0) {
+  if (v.size() != t.size())
+    return -1.0;
+  int K = v.size();
+  if ((K < 2) || (alfa < 1)) {
+    if (K == 1) {
+      return t(0);
+    }
+    return -1.0;
   }
-  return tSig;
+  return LeadingEdgeFitter(alfa, v0).fit(&t(0), &v(0), K);
 }
 
 #endif /* !_HELPERMATHFUNCTIONS_H_ */
@@ -19,26 +19,45 @@
 #include "./JPetPhysSignal/JPetPhysSignal.h"
 #include "./JPetRecoSignal/JPetRecoSignal.h"
 #include "./JPetUserTask/JPetUserTask.h"
+#include "./JPetSimplePhysSignalReco/HelperMathFunctions.h"
+#include <vector>
 
 class JPetWriter;
 
+/**
+ * @brief Simple reconstruction of JPetPhysSignal from JPetRecoSignal
+ *
+ * The alpha and the selected threshold are read from the configParams.json once in init().
+ * The times of all signals of the time window are fitted in one batch: the leading-edge
+ * points are gathered into the structure-of-arrays buffers, which are reused between
+ * the time windows, so in the steady state the fit does not allocate memory.
+ */
 class JPetSimplePhysSignalReco: public JPetUserTask
 {
 public:
-  JPetSimplePhysSignalReco();
+  JPetSimplePhysSignalReco(const char* name = "JPetSimplePhysSignalReco");
   virtual ~JPetSimplePhysSignalReco();
+  virtual bool init() override;
   virtual bool exec() override;
+  virtual bool terminate() override;
   inline int getAlpha() const { return fAlpha; }
   inline float getThresholdSel() const { return fThresholdSel; }
-  inline void setAlpha(int val) { fAlpha = val; }
-  inline void setThresholdSel(float val) { fThresholdSel = val; }
+  inline void setAlpha(int val) { fAlpha = val; fFitter = LeadingEdgeFitter(fAlpha, fThresholdSel); }
+  inline void setThresholdSel(float val) { fThresholdSel = val; fFitter = LeadingEdgeFitter(fAlpha, fThresholdSel); }
   void readConfigFileAndSetAlphaAndThreshParams(const char* filename);
+  void reconstructTimes(const JPetTimeWindow& timeWindow);
+  inline const std::vector<float>& getFittedTimes() const { return fFittedTimes; }
 
 private:
-  JPetPhysSignal createPhysSignal(JPetRecoSignal& signals);
+  JPetPhysSignal createPhysSignal(const JPetRecoSignal& recoSignal, int signalIndex) const;
   void savePhysSignal( JPetPhysSignal signal);
   int fAlpha;
   float fThresholdSel;
+  LeadingEdgeFitter fFitter;
+  std::vector<float> fLeadingTimes;
+  std::vector<float> fLeadingThresholds;
+  std::vector<int> fSignalOffsets;
+  std::vector<float> fFittedTimes;
 };
 
 #endif /* !_JPETSIMPLEPHYSSIGNALRECO_H_ */
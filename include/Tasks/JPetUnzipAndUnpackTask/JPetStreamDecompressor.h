@@ -0,0 +1,78 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStreamDecompressor.h
+ */
+
+#ifndef JPETSTREAMDECOMPRESSOR_H
+#define JPETSTREAMDECOMPRESSOR_H
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Streaming decompressor of .gz, .xz and .bz2 files
+ *
+ * The compressed file is read in chunks and decompressed in-process with
+ * zlib, liblzma or libbzip2, so the decompressed data never has to be stored on disk.
+ * Concatenated streams (e.g. from pigz or pbzip2) are supported. Multi-block .xz files
+ * (e.g. created with xz -T) are decoded with several threads if nThreads > 1
+ * and the liblzma version supports it.
+ */
+class JPetStreamDecompressor
+{
+public:
+  enum Format
+  {
+    kUnknown,
+    kGzip,
+    kXz,
+    kBzip2
+  };
+
+  static Format getFormat(const std::string& fileName);
+  static bool decompressToFile(const std::string& inFileName, const std::string& outFileName, unsigned int nThreads = 1);
+
+  explicit JPetStreamDecompressor(const std::string& fileName, unsigned int nThreads = 1);
+  ~JPetStreamDecompressor();
+  JPetStreamDecompressor(const JPetStreamDecompressor&) = delete;
+  JPetStreamDecompressor& operator=(const JPetStreamDecompressor&) = delete;
+
+  bool isOpen() const { return fCodec != nullptr && fInput != nullptr; }
+  bool hasError() const { return !fErrorMessage.empty(); }
+  bool isFinished() const { return fFinished; }
+  const std::string& getErrorMessage() const { return fErrorMessage; }
+
+  std::size_t read(char* buffer, std::size_t size);
+
+  class Codec;
+
+private:
+  void setError(const std::string& message);
+
+  static const std::size_t kInputBufferSize = 1 << 20;
+  std::string fFileName;
+  std::FILE* fInput = nullptr;
+  std::unique_ptr<Codec> fCodec;
+  std::vector<unsigned char> fInputBuffer;
+  const unsigned char* fNextIn = nullptr;
+  std::size_t fAvailIn = 0;
+  bool fInputEnd = false;
+  bool fStreamEnded = false;
+  bool fFinished = false;
+  std::string fErrorMessage;
+};
+
+#endif /* !JPETSTREAMDECOMPRESSOR_H */
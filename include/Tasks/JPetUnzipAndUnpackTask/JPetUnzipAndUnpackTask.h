@@ -20,6 +20,23 @@
 #include <boost/any.hpp>
 #include <map>
 
+/**
+ * @brief Task unpacking the hld file, decompressing it first if needed
+ *
+ * Compressed .gz, .xz and .bz2 inputs are decompressed in-process. By default
+ * the decompressed data are streamed to the unpacker through a named pipe created
+ * in place of the unzipped file, so the full hld file is never written to disk.
+ * With JPetUnzipAndUnpackTask_StreamDecompression_bool set to false the file is
+ * decompressed to disk before unpacking. JPetUnzipAndUnpackTask_DecompressionThreads_int
+ * sets the number of threads for .xz decoding (by default all available cores).
+ *
+ * If the first event is set for a plain hld file, the unpacking starts directly
+ * at this event, found with the JPetHLDIndex stored next to the hld file, and ends
+ * at the last event, or at the end of the file if the last event is not set.
+ * With the -s option only the events of the given shard are unpacked, also found with the index,
+ * to the file with the shard in its name, e.g. file_shard0of4.hld.root.
+ * This can be switched off with JPetUnzipAndUnpackTask_HLDIndex_bool set to false.
+ */
 class JPetUnzipAndUnpackTask: public JPetTask
 {
 public:
@@ -31,15 +48,31 @@ public:
   static bool unpackFile(const std::string& filename, long long nevents,
                          const std::string& configfile, const std::string& totCalibFile,
                          const std::string& tdcCalibFile);
-  static bool unzipFile(const std::string& filename);
+  static bool unzipFile(const std::string& filename, unsigned int nThreads = 1);
+  static bool unzipAndUnpackFile(const std::string& filename, long long nevents,
+                                 const std::string& configfile, const std::string& totCalibFile,
+                                 const std::string& tdcCalibFile, unsigned int nThreads = 1);
+  static bool unpackFileRange(const std::string& filename, const std::string& outputFile,
+                              long long firstEvent, long long lastEvent,
+                              const std::string& configfile, const std::string& totCalibFile,
+                              const std::string& tdcCalibFile);
 
 protected:
+  std::string getUnpackedFileName() const;
+  bool unpackShard(const std::string& filename, const std::string& configfile) const;
   OptsStrAny fOptions;
   bool fUnpackHappened = false;
+  bool fIsRangeUnpacked = false;
   const std::string kTOToffsetCalibKey = "Unpacker_TOToffsetCalib_std::string";
   const std::string kTDCnonlinearityCalibKey = "Unpacker_TDCnonlinearityCalib_std::string";
   std::string fTOToffsetCalibFile;
   std::string fTDCnonlinearityCalibFile;
+  const std::string kStreamDecompressionKey = "JPetUnzipAndUnpackTask_StreamDecompression_bool";
+  const std::string kDecompressionThreadsKey = "JPetUnzipAndUnpackTask_DecompressionThreads_int";
+  const std::string kHLDIndexKey = "JPetUnzipAndUnpackTask_HLDIndex_bool";
+  bool fStreamDecompression = true;
+  bool fUseHLDIndex = true;
+  unsigned int fDecompressionThreads = 1;
 };
 
 #endif /* !JPETUNZIPANDUNPACKTASK_H */
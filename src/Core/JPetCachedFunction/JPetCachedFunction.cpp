@@ -15,7 +15,13 @@
 
 #include "JPetCachedFunction/JPetCachedFunction.h"
 #include "JPetLoggerInclude.h"
+#include <boost/filesystem.hpp>
 #include <TFormula.h>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
 
 namespace  jpet_common_tools
 {
@@ -26,8 +32,6 @@ JPetCachedFunction::JPetCachedFunction(const JPetCachedFunctionParams& params):
 
 JPetCachedFunction1D::JPetCachedFunction1D(const JPetCachedFunctionParams& params, const Range& range): JPetCachedFunction(params), fRange(range)
 {
-  TFormula func("myFunc", fParams.fFormula.c_str());
-  func.SetParameters(fParams.fParams.data());
   if (fRange.fBins <= 0) {
     ERROR("Number of bins must be greater than 0!");
     fParams.fValidFunction = false;
@@ -40,19 +44,30 @@ JPetCachedFunction1D::JPetCachedFunction1D(const JPetCachedFunctionParams& param
     return;
   }
   fStep = step;
+  std::string cacheKey;
+  if (JPetCachedFunctionStore::isEnabled()) {
+    cacheKey = JPetCachedFunctionStore::generateKey(fParams, {fRange});
+    if (JPetCachedFunctionStore::load(cacheKey, fRange.fBins, fValues)) {
+      fParams.fValidFunction = true;
+      return;
+    }
+  }
+  TFormula func("myFunc", fParams.fFormula.c_str());
+  func.SetParameters(fParams.fParams.data());
   fValues.reserve(fRange.fBins);
   double currX = fRange.fMin;
   for (int i = 0; i < fRange.fBins; i++) {
     fValues.push_back(func.Eval(currX));
     currX = currX + step;
   }
+  if (!cacheKey.empty()) {
+    JPetCachedFunctionStore::save(cacheKey, fValues);
+  }
   fParams.fValidFunction = true;
 }
 
 JPetCachedFunction2D::JPetCachedFunction2D(const JPetCachedFunctionParams& params, const Range& xRange, const Range& yRange): JPetCachedFunction(params), fRange(xRange, yRange)
 {
-  TFormula func("myFunc", fParams.fFormula.c_str());
-  func.SetParameters(fParams.fParams.data());
   if (fRange.first.fBins <= 0) {
     ERROR("Number of bins X must be greater than 0!");
     fParams.fValidFunction = false;
@@ -78,7 +93,18 @@ JPetCachedFunction2D::JPetCachedFunction2D(const JPetCachedFunctionParams& param
   }
 
   fSteps = {stepX, stepY};
-  fValues.reserve(fRange.first.fBins * fRange.second.fBins);
+  std::size_t nValues = static_cast<std::size_t>(fRange.first.fBins) * fRange.second.fBins;
+  std::string cacheKey;
+  if (JPetCachedFunctionStore::isEnabled()) {
+    cacheKey = JPetCachedFunctionStore::generateKey(fParams, {fRange.first, fRange.second});
+    if (JPetCachedFunctionStore::load(cacheKey, nValues, fValues)) {
+      fParams.fValidFunction = true;
+      return;
+    }
+  }
+  TFormula func("myFunc", fParams.fFormula.c_str());
+  func.SetParameters(fParams.fParams.data());
+  fValues.reserve(nValues);
   double currX = fRange.first.fMin;
   double currY = fRange.second.fMin;
   for (int j = 0; j < fRange.second.fBins; j++) {
@@ -89,6 +115,9 @@ JPetCachedFunction2D::JPetCachedFunction2D(const JPetCachedFunctionParams& param
     currX = fRange.first.fMin;
     currY = currY + stepY;
   }
+  if (!cacheKey.empty()) {
+    JPetCachedFunctionStore::save(cacheKey, fValues);
+  }
   fParams.fValidFunction = true;
 }
 
@@ -135,4 +164,165 @@ int JPetCachedFunction2D::xyValueToIndex(double x, double y) const
   return (x / fSteps.first) + (y / fSteps.second) * fRange.first.fBins;
 }
 
+namespace
+{
+const char kCacheMagic[8] = {'J', 'P', 'E', 'T', 'C', 'F', 'N', '1'};
+
+/// Layout of the cache file: header, key characters, table of doubles.
+struct CacheFileHeader {
+  char fMagic[8];
+  std::uint64_t fKeyLength;
+  std::uint64_t fNumberOfValues;
+};
+
+std::mutex gCacheDirectoryMutex;
+std::string gCacheDirectory;
+/// Directory of the innermost DirectoryScope of the thread, if any.
+thread_local const std::string* tScopeCacheDirectory = nullptr;
+}
+
+JPetCachedFunctionStore::DirectoryScope::DirectoryScope(const std::string& dir): fDirectory(dir), fPreviousDirectory(tScopeCacheDirectory)
+{
+  tScopeCacheDirectory = &fDirectory;
+}
+
+JPetCachedFunctionStore::DirectoryScope::~DirectoryScope()
+{
+  tScopeCacheDirectory = fPreviousDirectory;
+}
+
+void JPetCachedFunctionStore::setCacheDirectory(const std::string& dir)
+{
+  std::lock_guard<std::mutex> lock(gCacheDirectoryMutex);
+  gCacheDirectory = dir;
+}
+
+std::string JPetCachedFunctionStore::getCacheDirectory()
+{
+  if (tScopeCacheDirectory) {
+    return *tScopeCacheDirectory;
+  }
+  std::lock_guard<std::mutex> lock(gCacheDirectoryMutex);
+  return gCacheDirectory;
+}
+
+bool JPetCachedFunctionStore::isEnabled()
+{
+  return !getCacheDirectory().empty();
+}
+
+/**
+ * The key contains the full formula, the parameters and the ranges written with
+ * the maximal precision, so two tables share the key only if they are identical.
+ */
+std::string JPetCachedFunctionStore::generateKey(const JPetCachedFunctionParams& params, const std::vector<Range>& ranges)
+{
+  std::ostringstream out;
+  out << std::setprecision(17);
+  out << "formula:" << params.fFormula << ";params:";
+  for (const auto& par : params.fParams) {
+    out << par << ",";
+  }
+  out << ";ranges:";
+  for (const auto& range : ranges) {
+    out << range.fBins << "," << range.fMin << "," << range.fMax << ";";
+  }
+  return out.str();
+}
+
+/**
+ * FNV-1a hash, used instead of std::hash since the file names
+ * must be stable between the compilers and the program runs.
+ */
+std::uint64_t JPetCachedFunctionStore::hash(const std::string& key)
+{
+  std::uint64_t result = 14695981039346656037ull;
+  for (auto c : key) {
+    result ^= static_cast<unsigned char>(c);
+    result *= 1099511628211ull;
+  }
+  return result;
+}
+
+std::string JPetCachedFunctionStore::generateFileName(const std::string& key)
+{
+  std::ostringstream out;
+  out << std::hex << std::setw(16) << std::setfill('0') << hash(key) << ".jpetcache";
+  return (boost::filesystem::path(getCacheDirectory()) / out.str()).string();
+}
+
+/**
+ * The table is read directly into the values, only the header and the key are checked first.
+ */
+bool JPetCachedFunctionStore::load(const std::string& key, std::size_t expectedSize, std::vector<double>& values)
+{
+  auto fileName = generateFileName(key);
+  boost::system::error_code ec;
+  auto size = boost::filesystem::file_size(fileName, ec);
+  if (ec) {
+    return false;
+  }
+  std::ifstream in(fileName, std::ios::binary);
+  CacheFileHeader header;
+  if (!in || size < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+  if (std::memcmp(header.fMagic, kCacheMagic, sizeof(kCacheMagic)) != 0
+      || header.fKeyLength != key.size() || header.fNumberOfValues != expectedSize
+      || size != sizeof(header) + header.fKeyLength + header.fNumberOfValues * sizeof(double)) {
+    WARNING("Cached function file: " + fileName + " is corrupted or does not match, the values will be recalculated.");
+    return false;
+  }
+  std::string storedKey(header.fKeyLength, '\0');
+  if (!in.read(&storedKey[0], storedKey.size()) || storedKey != key) {
+    /// Hash collision, the file belongs to some other function.
+    return false;
+  }
+  values.resize(expectedSize);
+  if (!in.read(reinterpret_cast<char*>(values.data()), expectedSize * sizeof(double))) {
+    WARNING("Unable to read cached function file: " + fileName);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * The file is first written under a temporary name and then renamed, so concurrent jobs
+ * sharing the cache directory never see partially written tables.
+ */
+bool JPetCachedFunctionStore::save(const std::string& key, const std::vector<double>& values)
+{
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(getCacheDirectory(), ec);
+  auto fileName = generateFileName(key);
+  auto tmpFileName = fileName + "." + boost::filesystem::unique_path().string() + ".tmp";
+  {
+    std::ofstream out(tmpFileName, std::ios::binary);
+    if (!out) {
+      WARNING("Unable to create cached function file: " + tmpFileName);
+      return false;
+    }
+    CacheFileHeader header;
+    std::memcpy(header.fMagic, kCacheMagic, sizeof(kCacheMagic));
+    header.fKeyLength = key.size();
+    header.fNumberOfValues = values.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(key.data(), key.size());
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    if (!out) {
+      WARNING("Unable to write cached function file: " + tmpFileName);
+      out.close();
+      boost::filesystem::remove(tmpFileName, ec);
+      return false;
+    }
+  }
+  boost::filesystem::rename(tmpFileName, fileName, ec);
+  if (ec) {
+    WARNING("Unable to store cached function file: " + fileName + " " + ec.message());
+    boost::filesystem::remove(tmpFileName, ec);
+    return false;
+  }
+  return true;
+}
+
 }
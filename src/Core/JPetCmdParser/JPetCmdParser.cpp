@@ -28,6 +28,8 @@ JPetCmdParser::JPetCmdParser() : fOptionsDescriptions("Allowed options")
       "file,f", po::value<std::vector<std::string>>()->required()->multitoken(),
       "File(s) to open.")("outputPath,o", po::value<std::string>(), "Location to which the outputFiles will be saved.")(
       "range,r", po::value<std::vector<int>>()->multitoken()->default_value({-1, -1}, ""), "Range of events to process e.g. -r 1 1000 .")(
+      "shard,s", po::value<std::vector<int>>()->multitoken(),
+      "Process only the shard i of N equal parts of the range of events, e.g. -s 0 16 . The shard number is added to the output file names.")(
       "unpackerConfigFile,p", po::value<std::string>(), "xml file with TRB settings used by the unpacker program.")(
       "unpackerCalibFile,c", po::value<std::string>(), "ROOT file with TRB calibration used by the unpacker program.")(
       "runId,i", po::value<int>(), "Run id.")("progressBar,b", po::bool_switch()->default_value(false),
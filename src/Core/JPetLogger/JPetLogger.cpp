@@ -14,9 +14,24 @@
  */
 
 #include "JPetLogger/JPetLogger.h"
+#include <cstdlib>
+#include <exception>
+
+std::atomic<int> JPetLogger::sMinimalLevel(boost::log::trivial::info);
+std::terminate_handler JPetLogger::sPreviousTerminateHandler = nullptr;
 
 JPetLogger::JPetLogger() { init(); }
 
+/**
+ * The records still in the queue are written before the program exits.
+ */
+JPetLogger::~JPetLogger()
+{
+  boost::log::core::get()->remove_sink(sink);
+  sink->stop();
+  sink->flush();
+}
+
 void JPetLogger::init() {
   backend = boost::make_shared<JPetTextFileBackend>(boost::log::keywords::file_name = "JPet_%Y-%m-%d_%H-%M-%S.%N.log",
                                                     boost::log::keywords::auto_flush = true, boost::log::keywords::rotation_size = kRotationSize);
@@ -26,24 +41,47 @@ void JPetLogger::init() {
   boost::log::add_common_attributes();
   boost::log::core::get()->set_filter(boost::log::trivial::severity >=
                                       boost::log::trivial::info);
+  sPreviousTerminateHandler = std::set_terminate(&JPetLogger::onTerminate);
 }
 
+/**
+ * Wait until all the records logged so far are written to the file.
+ */
+void JPetLogger::flush() { JPetLogger::getInstance().sink->flush(); }
+
+/**
+ * The error messages logged just before an uncaught exception must not be lost in the queue.
+ */
+void JPetLogger::onTerminate()
+{
+  JPetLogger::getInstance().sink->flush();
+  if (sPreviousTerminateHandler)
+  {
+    sPreviousTerminateHandler();
+  }
+  std::abort();
+}
+
+/**
+ * Called only by the thread of the asynchronous sink, the mutex guards
+ * the repetition state also against the direct use of the formatter.
+ */
 void JPetLogger::formatter(boost::log::record_view const &rec,
                            boost::log::formatting_ostream &out_stream) {
-  static std::string fLastMessage = "";
-  static unsigned int fNumberOfRepetitions = 0u;
+  auto& logger = JPetLogger::getInstance();
+  std::lock_guard<std::mutex> lock(logger.fRepetitionMutex);
 
-  if (fLastMessage == rec[boost::log::expressions::smessage])
+  if (logger.fLastMessage == rec[boost::log::expressions::smessage])
   { // same message as last time, increase repetitions number and return
-    fNumberOfRepetitions++;
+    logger.fNumberOfRepetitions++;
     return;
   }
-  else if (fNumberOfRepetitions != 0)
+  else if (logger.fNumberOfRepetitions != 0)
   { // some other message, print repetitions number and process message
-    out_stream << "--- The last message repeated " << fNumberOfRepetitions << " times" << std::endl;
-    fNumberOfRepetitions = 0u;
+    out_stream << "--- The last message repeated " << logger.fNumberOfRepetitions << " times" << std::endl;
+    logger.fNumberOfRepetitions = 0u;
   }
-  fLastMessage = rec[boost::log::expressions::smessage].get();
+  logger.fLastMessage = rec[boost::log::expressions::smessage].get();
   boost::log::value_ref<std::string> fullpath =
       boost::log::extract<std::string>("File", rec);
   boost::log::value_ref<std::string> fullfunction =
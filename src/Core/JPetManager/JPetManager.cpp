@@ -19,8 +19,12 @@
 #include "JPetGeantParser/JPetGeantParser.h"
 #include "JPetLoggerInclude.h"
 #include "JPetOptionsGenerator/JPetOptionsGenerator.h"
+#include "JPetProgressBarManager/JPetProgressReporter.h"
 #include "JPetTaskChainExecutor/JPetTaskChainExecutor.h"
+#include "JPetTaskIO/JPetFusedTaskIO.h"
+#include "JPetTracer/JPetTracer.h"
 
+#include <TROOT.h>
 #include <TThread.h>
 #include <cassert>
 #include <exception>
@@ -52,6 +56,8 @@ void JPetManager::run(int argc, const char** argv)
   JPetManager::registerDefaultTasks();
   useTasksFromUserParams(allValidatedOptions);  // add userTasks registered in userParams to run
   checkDisableLogRotation(allValidatedOptions); // disable log rotation if enabled
+  checkEnableThreadSafety(allValidatedOptions);
+  auto traceFile = startTracing(allValidatedOptions);
   auto chainOfTasks = fTaskFactory.createTaskGeneratorChain(allValidatedOptions);
   JPetOptionsGenerator optionsGenerator;
   auto options = optionsGenerator.generateOptionsForTasks(allValidatedOptions, chainOfTasks.size());
@@ -98,6 +104,18 @@ void JPetManager::run(int argc, const char** argv)
       thread->Join();
     }
   }
+  JPetProgressReporter::getInstance().waitUntilIdle();
+  if (!traceFile.empty())
+  {
+    if (JPetTracer::getNumberOfDroppedEvents() > 0)
+    {
+      WARNING(std::to_string(JPetTracer::getNumberOfDroppedEvents()) + " trace events were dropped, the buffers are full.");
+    }
+    if (!JPetTracer::stop(traceFile))
+    {
+      ERROR("Unable to write the trace to " + traceFile);
+    }
+  }
   INFO("======== Finished processing all tasks: " + JPetCommonTools::getTimeString() + " ========\n");
 }
 
@@ -170,3 +188,27 @@ void JPetManager::checkDisableLogRotation(const std::map<std::string, boost::any
     }
   }
 }
+
+void JPetManager::checkEnableThreadSafety(const std::map<std::string, boost::any>& opts)
+{
+  using namespace jpet_options_tools;
+  bool isPipelined = isOptionSet(opts, JPetFusedTaskIO::kPipelineKey) && getOptionAsBool(opts, JPetFusedTaskIO::kPipelineKey);
+  if (areThreadsEnabled() || isPipelined)
+  {
+    ROOT::EnableThreadSafety();
+  }
+}
+
+std::string JPetManager::startTracing(const std::map<std::string, boost::any>& opts)
+{
+  using namespace jpet_options_tools;
+  if (!isOptionSet(opts, kTraceFileKey) || getOptionAsString(opts, kTraceFileKey).empty())
+  {
+    return "";
+  }
+  auto traceFile = getOptionAsString(opts, kTraceFileKey);
+  INFO("Recording the timeline of the processing to " + traceFile);
+  JPetTracer::start();
+  JPetTracer::setThreadName("main");
+  return traceFile;
+}
@@ -0,0 +1,494 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetMerger.cpp
+ */
+
+#include "JPetMerger/JPetMerger.h"
+#include "JPetLoggerInclude.h"
+#include "JPetParamBank/JPetParamBank.h"
+#include "JPetReader/JPetReader.h"
+#include "JPetTaskIO/JPetTaskIOTools.h"
+#include "JPetTreeHeader/JPetTreeHeader.h"
+#include "JPetUserInfoStructure/JPetUserInfoStructure.h"
+#include "JPetWindowIndex/JPetWindowIndex.h"
+
+#include <TChain.h>
+#include <TClass.h>
+#include <TEfficiency.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TROOT.h>
+#include <TTree.h>
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+bool haveSameContents(const JPetScin& first, const JPetScin& second)
+{
+  return first.getAttenLen() == second.getAttenLen() && first.getScinSize(JPetScin::kLength) == second.getScinSize(JPetScin::kLength) &&
+         first.getScinSize(JPetScin::kHeight) == second.getScinSize(JPetScin::kHeight) &&
+         first.getScinSize(JPetScin::kWidth) == second.getScinSize(JPetScin::kWidth);
+}
+
+bool haveSameContents(const JPetPM& first, const JPetPM& second)
+{
+  return first.getSide() == second.getSide() && first.getHVset() == second.getHVset() && first.getHVopt() == second.getHVopt() &&
+         first.getDescription() == second.getDescription();
+}
+
+bool haveSameContents(const JPetFEB& first, const JPetFEB& second)
+{
+  return first.isActive() == second.isActive() && first.status() == second.status() && first.description() == second.description() &&
+         first.version() == second.version() && first.getNtimeOutsPerInput() == second.getNtimeOutsPerInput() &&
+         first.getNnotimeOutsPerInput() == second.getNnotimeOutsPerInput();
+}
+
+bool haveSameContents(const JPetTRB& first, const JPetTRB& second)
+{
+  return first.getType() == second.getType() && first.getChannel() == second.getChannel();
+}
+
+bool haveSameContents(const JPetBarrelSlot& first, const JPetBarrelSlot& second)
+{
+  return first.isActive() == second.isActive() && first.getName() == second.getName() && first.getTheta() == second.getTheta() &&
+         first.getInFrameID() == second.getInFrameID();
+}
+
+bool haveSameContents(const JPetLayer& first, const JPetLayer& second)
+{
+  return first.getIsActive() == second.getIsActive() && first.getName() == second.getName() && first.getRadius() == second.getRadius();
+}
+
+bool haveSameContents(const JPetFrame& first, const JPetFrame& second)
+{
+  return first.getIsActive() == second.getIsActive() && first.getStatus() == second.getStatus() &&
+         first.getDescription() == second.getDescription() && first.getVersion() == second.getVersion();
+}
+
+bool haveSameContents(const JPetTOMBChannel& first, const JPetTOMBChannel& second)
+{
+  return first.getThreshold() == second.getThreshold() && first.getLocalChannelNumber() == second.getLocalChannelNumber() &&
+         first.getFEBInputNumber() == second.getFEBInputNumber() && first.getDescription() == second.getDescription();
+}
+
+template <class T>
+bool haveSameObjects(const std::map<int, T*>& first, const std::map<int, T*>& second)
+{
+  return first.size() == second.size() &&
+         std::equal(first.begin(), first.end(), second.begin(), [](const std::pair<const int, T*>& a, const std::pair<const int, T*>& b) {
+           return a.first == b.first && haveSameContents(*a.second, *b.second);
+         });
+}
+} // namespace
+
+JPetMerger::JPetMerger(unsigned int numberOfThreads) : fNumberOfThreads(std::max(1u, numberOfThreads)) {}
+
+bool JPetMerger::merge(const std::vector<std::string>& inputFiles, const std::string& outputFile)
+{
+  if (inputFiles.empty())
+  {
+    ERROR("No input files to merge");
+    return false;
+  }
+  std::vector<Input> inputs(inputFiles.size());
+  for (std::size_t i = 0; i < inputFiles.size(); i++)
+  {
+    inputs[i].fFileName = inputFiles[i];
+  }
+
+  /// Every thread reads a continuous block of the files, so the objects which cannot be merged
+  /// are taken from the first file, as in the sequential reading.
+  auto numberOfThreads = std::min<std::size_t>(fNumberOfThreads, inputs.size());
+  if (numberOfThreads > 1)
+  {
+    ROOT::EnableThreadSafety();
+  }
+  std::vector<Statistics> statistics(numberOfThreads);
+  std::vector<char> isOK(numberOfThreads, true);
+  auto readInputs = [&](std::size_t thread) {
+    auto begin = inputs.size() * thread / numberOfThreads;
+    auto end = inputs.size() * (thread + 1) / numberOfThreads;
+    for (auto i = begin; i < end && isOK[thread]; i++)
+    {
+      isOK[thread] = readInput(inputs[i], statistics[thread]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (std::size_t thread = 1; thread < numberOfThreads; thread++)
+  {
+    threads.emplace_back(readInputs, thread);
+  }
+  readInputs(0);
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  if (std::find(isOK.begin(), isOK.end(), false) != isOK.end())
+  {
+    return false;
+  }
+  for (std::size_t thread = 1; thread < numberOfThreads; thread++)
+  {
+    mergeStatistics(statistics.front(), statistics[thread]);
+  }
+
+  if (!sortInputs(inputs))
+  {
+    return false;
+  }
+  const auto& first = inputs.front();
+  for (const auto& input : inputs)
+  {
+    if (static_cast<bool>(input.fHeader) != static_cast<bool>(first.fHeader) ||
+        (input.fHeader && !areSameHistories(*first.fHeader, *input.fHeader)))
+    {
+      ERROR("The processing history of " + input.fFileName + " differs from the one of " + first.fFileName);
+      return false;
+    }
+    if (first.fParamBank && input.fParamBank && !areSameParamBanks(*first.fParamBank, *input.fParamBank))
+    {
+      ERROR("The parameter bank of " + input.fFileName + " differs from the one of " + first.fFileName);
+      return false;
+    }
+  }
+  return mergeTrees(inputs, outputFile, statistics.front());
+}
+
+/**
+ * @return true if the shard ("index/number of shards") is stored in the header
+ */
+bool JPetMerger::parseShard(const JPetTreeHeader& header, int& shardIndex, int& numberOfShards)
+{
+  std::istringstream shard(header.getVariable(JPetTaskIOTools::kShardHeaderVariable));
+  char separator = 0;
+  return static_cast<bool>(shard >> shardIndex >> separator >> numberOfShards) && separator == '/';
+}
+
+bool JPetMerger::areSameHistories(const JPetTreeHeader& first, const JPetTreeHeader& second)
+{
+  if (first.getStagesNb() != second.getStagesNb())
+  {
+    return false;
+  }
+  for (int i = 0; i < first.getStagesNb(); i++)
+  {
+    if (first.getProcessingStageInfo(i).fModuleName != second.getProcessingStageInfo(i).fModuleName)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Banks are the same when they hold the same objects under the same IDs and each pair of objects has equal parameters.
+ * The links between the objects (e.g. the FEB of a PM) are not compared.
+ */
+bool JPetMerger::areSameParamBanks(const JPetParamBank& first, const JPetParamBank& second)
+{
+  return haveSameObjects(first.getScintillators(), second.getScintillators()) && haveSameObjects(first.getPMs(), second.getPMs()) &&
+         haveSameObjects(first.getFEBs(), second.getFEBs()) && haveSameObjects(first.getTRBs(), second.getTRBs()) &&
+         haveSameObjects(first.getBarrelSlots(), second.getBarrelSlots()) && haveSameObjects(first.getLayers(), second.getLayers()) &&
+         haveSameObjects(first.getFrames(), second.getFrames()) && haveSameObjects(first.getTOMBChannels(), second.getTOMBChannels());
+}
+
+/**
+ * The objects are merged with the Merge method of their class, as in hadd,
+ * which sums the histograms, efficiencies and joins the points of the graphs.
+ * @return false if the objects cannot be merged
+ */
+bool JPetMerger::mergeObject(TObject* target, TObject* source)
+{
+  if (target->IsA() != source->IsA())
+  {
+    return false;
+  }
+  auto mergeFunction = target->IsA()->GetMerge();
+  if (!mergeFunction)
+  {
+    return false;
+  }
+  TList list;
+  list.Add(source);
+  return mergeFunction(target, &list, nullptr) >= 0;
+}
+
+bool JPetMerger::readInput(Input& input, Statistics& statistics)
+{
+  TFile file(input.fFileName.c_str(), "READ");
+  if (!file.IsOpen() || file.IsZombie())
+  {
+    ERROR("Cannot open the file to merge: " + input.fFileName);
+    return false;
+  }
+  auto tree = dynamic_cast<TTree*>(file.Get(JPetReader::kRootTreeName.c_str()));
+  if (!tree)
+  {
+    ERROR("No tree " + JPetReader::kRootTreeName + " in the file to merge: " + input.fFileName);
+    return false;
+  }
+  auto header = dynamic_cast<JPetTreeHeader*>(tree->GetUserInfo()->At(JPetUserInfoStructure::kHeader));
+  if (header)
+  {
+    input.fHeader.reset(new JPetTreeHeader(*header));
+    if (!parseShard(*header, input.fShardIndex, input.fNumberOfShards))
+    {
+      input.fShardIndex = -1;
+      input.fNumberOfShards = 0;
+    }
+  }
+  input.fParamBank.reset(dynamic_cast<JPetParamBank*>(file.Get("ParamBank;1")));
+  readDirectory(file, statistics, true);
+  return true;
+}
+
+/**
+ * The shards are ordered by their index, so the merged tree contains the entries in the original order.
+ * The files without the shard information are merged in the given order.
+ */
+bool JPetMerger::sortInputs(std::vector<Input>& inputs) const
+{
+  auto numberOfShards = inputs.front().fNumberOfShards;
+  for (const auto& input : inputs)
+  {
+    if (input.fNumberOfShards != numberOfShards)
+    {
+      ERROR("The files to merge are not the shards of the same data, e.g. " + input.fFileName + " and " + inputs.front().fFileName);
+      return false;
+    }
+  }
+  if (numberOfShards == 0)
+  {
+    return true;
+  }
+  std::stable_sort(inputs.begin(), inputs.end(), [](const Input& first, const Input& second) { return first.fShardIndex < second.fShardIndex; });
+  for (std::size_t i = 1; i < inputs.size(); i++)
+  {
+    if (inputs[i].fShardIndex == inputs[i - 1].fShardIndex)
+    {
+      ERROR("The shard " + std::to_string(inputs[i].fShardIndex) + " is given twice: " + inputs[i - 1].fFileName + " and " + inputs[i].fFileName);
+      return false;
+    }
+  }
+  if (static_cast<int>(inputs.size()) != numberOfShards)
+  {
+    WARNING("Only " + std::to_string(inputs.size()) + " of " + std::to_string(numberOfShards) + " shards are merged");
+  }
+  return true;
+}
+
+/**
+ * Only the latest cycle of every object is read, the directories are read recursively.
+ * The tree and the parameter bank in the top directory are handled separately.
+ */
+void JPetMerger::readDirectory(TDirectory& directory, Statistics& statistics, bool isTopDirectory)
+{
+  std::set<std::string> readNames;
+  TIter next(directory.GetListOfKeys());
+  while (auto key = static_cast<TKey*>(next()))
+  {
+    std::string name = key->GetName();
+    if (!readNames.insert(name).second)
+    {
+      continue;
+    }
+    if (isTopDirectory && (name == JPetReader::kRootTreeName || name == "ParamBank"))
+    {
+      continue;
+    }
+    auto objectClass = TClass::GetClass(key->GetClassName());
+    if (!objectClass || objectClass->InheritsFrom(TTree::Class()))
+    {
+      continue;
+    }
+    if (objectClass->InheritsFrom(TDirectory::Class()))
+    {
+      auto subdirectory = directory.GetDirectory(name.c_str());
+      if (subdirectory)
+      {
+        auto& subStatistics = statistics.fDirectories[name];
+        if (!subStatistics)
+        {
+          subStatistics.reset(new Statistics);
+        }
+        readDirectory(*subdirectory, *subStatistics, false);
+      }
+      continue;
+    }
+    std::unique_ptr<TObject> object(key->ReadObj());
+    if (!object)
+    {
+      continue;
+    }
+    if (auto histogram = dynamic_cast<TH1*>(object.get()))
+    {
+      histogram->SetDirectory(nullptr);
+    }
+    else if (auto efficiency = dynamic_cast<TEfficiency*>(object.get()))
+    {
+      efficiency->SetDirectory(nullptr);
+    }
+    addObject(statistics, name, std::move(object));
+  }
+}
+
+void JPetMerger::addObject(Statistics& statistics, const std::string& name, std::unique_ptr<TObject> object)
+{
+  auto found = statistics.fObjects.find(name);
+  if (found == statistics.fObjects.end())
+  {
+    statistics.fObjects.emplace(name, std::move(object));
+  }
+  else if (!mergeObject(found->second.get(), object.get()))
+  {
+    DEBUG("The object " + name + " cannot be merged, it is taken from the first file");
+  }
+}
+
+void JPetMerger::mergeStatistics(Statistics& target, Statistics& source)
+{
+  for (auto& object : source.fObjects)
+  {
+    addObject(target, object.first, std::move(object.second));
+  }
+  for (auto& directory : source.fDirectories)
+  {
+    auto& targetDirectory = target.fDirectories[directory.first];
+    if (targetDirectory)
+    {
+      mergeStatistics(*targetDirectory, *directory.second);
+    }
+    else
+    {
+      targetDirectory = std::move(directory.second);
+    }
+  }
+  source.fObjects.clear();
+  source.fDirectories.clear();
+}
+
+void JPetMerger::writeStatistics(TDirectory& directory, const Statistics& statistics)
+{
+  directory.cd();
+  for (const auto& object : statistics.fObjects)
+  {
+    object.second->Write(object.first.c_str());
+  }
+  for (const auto& subStatistics : statistics.fDirectories)
+  {
+    auto subdirectory = directory.mkdir(subStatistics.first.c_str());
+    writeStatistics(*subdirectory, *subStatistics.second);
+  }
+}
+
+/**
+ * The baskets of the trees are copied without unpacking the time windows ("fast" cloning).
+ */
+bool JPetMerger::mergeTrees(const std::vector<Input>& inputs, const std::string& outputFile, const Statistics& statistics)
+{
+  TChain chain(JPetReader::kRootTreeName.c_str());
+  for (const auto& input : inputs)
+  {
+    chain.Add(input.fFileName.c_str());
+  }
+  TFile output(outputFile.c_str(), "RECREATE");
+  if (!output.IsOpen() || output.IsZombie())
+  {
+    ERROR("Could not open the merged file to write: " + outputFile);
+    return false;
+  }
+  output.cd();
+  auto tree = chain.CloneTree(0);
+  if (!tree)
+  {
+    ERROR("Could not create the merged tree in: " + outputFile);
+    return false;
+  }
+  tree->CopyEntries(&chain, -1, "fast");
+  tree->GetUserInfo()->Delete();
+  const auto& first = inputs.front();
+  if (first.fHeader)
+  {
+    auto header = new JPetTreeHeader(*first.fHeader);
+    if (first.fNumberOfShards > 0)
+    {
+      header->removeVariable(JPetTaskIOTools::kShardHeaderVariable);
+      header->setVariable("mergedShards", std::to_string(inputs.size()) + "/" + std::to_string(first.fNumberOfShards));
+    }
+    tree->GetUserInfo()->AddAt(header, JPetUserInfoStructure::kHeader);
+  }
+  else
+  {
+    WARNING("No tree header in the merged files");
+  }
+  tree->Write();
+  mergeIndexTrees(inputs, output, tree->GetEntries());
+  writeStatistics(output, statistics);
+  auto paramBank = std::find_if(inputs.begin(), inputs.end(), [](const Input& input) { return static_cast<bool>(input.fParamBank); });
+  if (paramBank != inputs.end())
+  {
+    output.WriteTObject(paramBank->fParamBank.get(), "ParamBank");
+  }
+  output.Close();
+  return true;
+}
+
+/**
+ * The window indices are concatenated in the same order as the trees, the merged index is written
+ * only if all input files contain it, so that its entries correspond to the entries of the merged tree.
+ * The shards keep the window numbers of the original data, so the merged number of windows is the largest one.
+ */
+void JPetMerger::mergeIndexTrees(const std::vector<Input>& inputs, TFile& output, long long numberOfEntries)
+{
+  TChain chain(JPetWindowIndex::kIndexTreeName.c_str());
+  for (const auto& input : inputs)
+  {
+    chain.Add(input.fFileName.c_str());
+  }
+  if (chain.GetEntries() == 0)
+  {
+    return;
+  }
+  if (chain.GetEntries() != numberOfEntries)
+  {
+    WARNING("Some of the merged files have no window index, the merged file will not contain it");
+    return;
+  }
+  output.cd();
+  auto index = chain.CloneTree(0);
+  if (!index)
+  {
+    WARNING("Could not create the merged window index");
+    return;
+  }
+  index->CopyEntries(&chain, -1, "fast");
+  ULong64_t numberOfWindows = 0;
+  for (const auto& input : inputs)
+  {
+    TFile file(input.fFileName.c_str(), "READ");
+    auto inputIndexTree = dynamic_cast<TTree*>(file.Get(JPetWindowIndex::kIndexTreeName.c_str()));
+    JPetWindowIndex inputIndex;
+    if (inputIndexTree && inputIndex.read(*inputIndexTree))
+    {
+      numberOfWindows = std::max(numberOfWindows, inputIndex.getNumberOfWindows());
+    }
+  }
+  output.cd();
+  JPetWindowIndex::setNumberOfWindows(*index, numberOfWindows);
+  index->Write();
+}
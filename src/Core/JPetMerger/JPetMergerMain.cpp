@@ -0,0 +1,63 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetMergerMain.cpp
+ */
+
+#include "JPetMerger/JPetMerger.h"
+
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/**
+ * Merges the output files of the framework, e.g. the shards processed with the -s option:
+ *   JPetMerger.x -o dabc_123.hits.root dabc_123_shard*of16.hits.root
+ */
+int main(int argc, char** argv)
+{
+  po::options_description description("Allowed options");
+  description.add_options()("help,h", "Produce help message")("output,o", po::value<std::string>()->required(), "Merged output file")(
+    "threads,j", po::value<unsigned int>()->default_value(std::max(1u, std::thread::hardware_concurrency())),
+    "Number of threads reading the input files")("input", po::value<std::vector<std::string>>()->required(), "Files to merge");
+  po::positional_options_description positional;
+  positional.add("input", -1);
+
+  po::variables_map variables;
+  try
+  {
+    po::store(po::command_line_parser(argc, argv).options(description).positional(positional).run(), variables);
+    if (variables.count("help"))
+    {
+      std::cout << "Usage: JPetMerger.x -o output.root input1.root input2.root ..." << std::endl << description << std::endl;
+      return 0;
+    }
+    po::notify(variables);
+  }
+  catch (const po::error& e)
+  {
+    std::cerr << e.what() << std::endl << description << std::endl;
+    return 2;
+  }
+
+  JPetMerger merger(variables["threads"].as<unsigned int>());
+  if (!merger.merge(variables["input"].as<std::vector<std::string>>(), variables["output"].as<std::string>()))
+  {
+    std::cerr << "Merging failed, see the log for details" << std::endl;
+    return 1;
+  }
+  return 0;
+}
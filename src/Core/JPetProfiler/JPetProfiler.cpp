@@ -0,0 +1,141 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetProfiler.cpp
+ */
+
+#include "JPetProfiler/JPetProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+const int JPetProfiler::kBinsPerDecade;
+const int JPetProfiler::kNumberOfBins;
+const double JPetProfiler::kMinLatency = 1e-8;
+
+JPetProfiler::JPetProfiler(const std::string& name) : fName(name) {}
+
+void JPetProfiler::add(Stage stage, Clock::duration duration) { add(stage, std::chrono::duration<double>(duration).count()); }
+
+void JPetProfiler::add(Stage stage, double seconds)
+{
+  auto& stats = fStages[stage];
+  if (stats.count == 0 || seconds < stats.minSeconds)
+  {
+    stats.minSeconds = seconds;
+  }
+  stats.maxSeconds = std::max(stats.maxSeconds, seconds);
+  stats.count++;
+  stats.totalSeconds += seconds;
+  stats.histogram[getBin(seconds)]++;
+}
+
+void JPetProfiler::reset() { fStages = std::array<StageStatistics, kNumberOfStages>(); }
+
+/**
+ * @return number of processed events per second of the run stage, or 0 if not measured
+ */
+double JPetProfiler::getThroughput() const
+{
+  double runTime = fStages[kRun].totalSeconds;
+  return runTime > 0.0 ? getNumberOfEvents() / runTime : 0.0;
+}
+
+/**
+ * Estimate of the quantile of the single measurement times of the stage, with the linear
+ * interpolation within the histogram bin, limited to the measured minimum and maximum.
+ */
+double JPetProfiler::getQuantile(Stage stage, double quantile) const
+{
+  const auto& stats = fStages[stage];
+  if (stats.count == 0)
+  {
+    return 0.0;
+  }
+  const auto edges = getBinEdges();
+  double target = std::min(1.0, std::max(0.0, quantile)) * stats.count;
+  double cumulated = 0.0;
+  for (int bin = 0; bin < kNumberOfBins + 2; bin++)
+  {
+    double content = stats.histogram[bin];
+    if (content > 0.0 && cumulated + content >= target)
+    {
+      double low = bin == 0 ? stats.minSeconds : edges[bin - 1];
+      double high = bin == kNumberOfBins + 1 ? stats.maxSeconds : edges[bin];
+      double value = low + (high - low) * (target - cumulated) / content;
+      return std::min(stats.maxSeconds, std::max(stats.minSeconds, value));
+    }
+    cumulated += content;
+  }
+  return stats.maxSeconds;
+}
+
+const char* JPetProfiler::getStageName(Stage stage)
+{
+  static const char* names[kNumberOfStages] = {"init", "run", "terminate", "read", "exec", "write", "event"};
+  return names[stage];
+}
+
+/**
+ * @return kNumberOfBins + 1 edges of the histogram bins in seconds
+ */
+std::vector<double> JPetProfiler::getBinEdges()
+{
+  std::vector<double> edges(kNumberOfBins + 1);
+  for (int i = 0; i <= kNumberOfBins; i++)
+  {
+    edges[i] = kMinLatency * std::pow(10.0, static_cast<double>(i) / kBinsPerDecade);
+  }
+  return edges;
+}
+
+/**
+ * @return index in the histogram, 0 for the underflow and kNumberOfBins + 1 for the overflow
+ */
+int JPetProfiler::getBin(double seconds)
+{
+  if (!(seconds >= kMinLatency))
+  {
+    return 0;
+  }
+  int bin = static_cast<int>(std::floor(std::log10(seconds / kMinLatency) * kBinsPerDecade)) + 1;
+  return std::min(bin, kNumberOfBins + 1);
+}
+
+std::string JPetProfiler::toJSON() const
+{
+  std::ostringstream out;
+  out << std::setprecision(9);
+  out << "{\"name\": \"" << fName << "\", \"events\": " << getNumberOfEvents() << ", \"events_per_second\": " << getThroughput()
+      << ", \"stages\": {";
+  bool isFirst = true;
+  for (int i = 0; i < kNumberOfStages; i++)
+  {
+    auto stage = static_cast<Stage>(i);
+    const auto& stats = fStages[stage];
+    if (stats.count == 0)
+    {
+      continue;
+    }
+    out << (isFirst ? "" : ", ") << "\"" << getStageName(stage) << "\": {";
+    out << "\"count\": " << stats.count << ", \"total_s\": " << stats.totalSeconds;
+    out << ", \"mean_ns\": " << 1e9 * stats.totalSeconds / stats.count;
+    out << ", \"min_ns\": " << 1e9 * stats.minSeconds << ", \"max_ns\": " << 1e9 * stats.maxSeconds;
+    out << ", \"p50_ns\": " << 1e9 * getQuantile(stage, 0.5) << ", \"p90_ns\": " << 1e9 * getQuantile(stage, 0.9);
+    out << ", \"p99_ns\": " << 1e9 * getQuantile(stage, 0.99) << "}";
+    isFirst = false;
+  }
+  out << "}}";
+  return out.str();
+}
@@ -16,6 +16,23 @@
 #include "JPetProgressBarManager/JPetProgressBarManager.h"
 #include <iostream>
 
+JPetProgressBarManager::~JPetProgressBarManager() { finishJob(); }
+
+void JPetProgressBarManager::startJob(const std::string& name, long long numberOfEvents)
+{
+  finishJob();
+  fJob = JPetProgressReporter::getInstance().startJob(name, numberOfEvents);
+}
+
+void JPetProgressBarManager::finishJob()
+{
+  if (fJob)
+  {
+    JPetProgressReporter::getInstance().finishJob(fJob);
+    fJob.reset();
+  }
+}
+
 void JPetProgressBarManager::display(const std::string& taskName, long long currentNumber, long long totalNumber) const
 {
   std::cout << std::string(30, '\b');
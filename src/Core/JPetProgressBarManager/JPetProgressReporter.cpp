@@ -0,0 +1,209 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetProgressReporter.cpp
+ */
+
+#include "JPetProgressBarManager/JPetProgressReporter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+const std::chrono::milliseconds JPetProgressReporter::kDefaultInterval(500);
+
+JPetProgressReporter::Job::Job(const std::string& name, long long numberOfEvents)
+    : fName(name), fNumberOfEvents(numberOfEvents), fLastTime(Clock::now())
+{
+}
+
+JPetProgressReporter& JPetProgressReporter::getInstance()
+{
+  static JPetProgressReporter instance;
+  return instance;
+}
+
+JPetProgressReporter::~JPetProgressReporter()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fIsStopping = true;
+  }
+  fCondition.notify_all();
+  if (fThread.joinable())
+  {
+    fThread.join();
+  }
+}
+
+/**
+ * Register the job and start the rendering thread, if it is not running.
+ */
+std::shared_ptr<JPetProgressReporter::Job> JPetProgressReporter::startJob(const std::string& name, long long numberOfEvents)
+{
+  auto job = std::make_shared<Job>(name, numberOfEvents);
+  std::lock_guard<std::mutex> lock(fMutex);
+  fJobs.push_back(job);
+  if (!fIsRunning && !fIsStopping)
+  {
+    /// the previous thread has already left the loop
+    if (fThread.joinable())
+    {
+      fThread.join();
+    }
+    fIsRunning = true;
+    fThread = std::thread(&JPetProgressReporter::loop, this);
+  }
+  return job;
+}
+
+/**
+ * The job is shown for the last time at the next rendering and then removed.
+ */
+void JPetProgressReporter::finishJob(const std::shared_ptr<Job>& job)
+{
+  if (job)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    job->fIsFinished.store(true);
+    fIsWakeUpRequested = true;
+    fCondition.notify_all();
+  }
+}
+
+/**
+ * Wait until all the jobs are finished and the final progress line is written.
+ */
+void JPetProgressReporter::waitUntilIdle()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fCondition.wait(lock, [this]() { return !fIsRunning; });
+}
+
+void JPetProgressReporter::setInterval(std::chrono::milliseconds interval)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fInterval = interval;
+}
+
+/**
+ * Stream for the progress line, std::cout by default.
+ */
+void JPetProgressReporter::setOutput(std::ostream* output)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fOutput = output;
+}
+
+std::string JPetProgressReporter::render(Clock::time_point now)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return renderLocked(now);
+}
+
+/**
+ * Update the rates with the events processed since the previous rendering and remove
+ * the finished jobs.
+ *
+ * @return progress line e.g. "TaskA 45.0% 12.3k ev/s ETA 0:00:12 | total 12.3k ev/s"
+ */
+std::string JPetProgressReporter::renderLocked(Clock::time_point now)
+{
+  std::string line;
+  double totalRate = 0.0;
+  for (const auto& job : fJobs)
+  {
+    long long processed = job->getProcessed();
+    double elapsed = std::chrono::duration<double>(now - job->fLastTime).count();
+    if (elapsed > 0.0)
+    {
+      double rate = (processed - job->fLastProcessed) / elapsed;
+      /// smoothing of the fluctuations between the intervals
+      job->fRate = job->fLastProcessed == 0 ? rate : 0.5 * (job->fRate + rate);
+      job->fLastProcessed = processed;
+      job->fLastTime = now;
+    }
+    totalRate += job->fRate;
+    line += (line.empty() ? "" : " | ") + job->fName;
+    if (job->fNumberOfEvents > 0)
+    {
+      char percent[16];
+      std::snprintf(percent, sizeof(percent), " %.1f%%", 100.0 * std::min(processed, job->fNumberOfEvents) / job->fNumberOfEvents);
+      line += percent;
+    }
+    line += " " + formatRate(job->fRate);
+    if (job->fNumberOfEvents > 0 && job->fRate > 0.0 && !job->fIsFinished.load())
+    {
+      line += " ETA " + formatDuration(std::max(0LL, job->fNumberOfEvents - processed) / job->fRate);
+    }
+  }
+  if (fJobs.size() > 1)
+  {
+    line += " | total " + formatRate(totalRate);
+  }
+  fJobs.erase(std::remove_if(fJobs.begin(), fJobs.end(), [](const std::shared_ptr<Job>& job) { return job->fIsFinished.load(); }),
+              fJobs.end());
+  return line;
+}
+
+void JPetProgressReporter::loop()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (!fIsStopping)
+  {
+    fCondition.wait_for(lock, fInterval, [this]() { return fIsStopping || fIsWakeUpRequested; });
+    fIsWakeUpRequested = false;
+    auto line = renderLocked(Clock::now());
+    auto& output = fOutput ? *fOutput : std::cout;
+    /// the spaces clear the rest of the previous, longer line
+    output << '\r' << line << std::string(fLastLineLength > line.size() ? fLastLineLength - line.size() : 0, ' ');
+    fLastLineLength = line.size();
+    if (fJobs.empty())
+    {
+      output << std::endl;
+      fLastLineLength = 0;
+      break;
+    }
+    output << std::flush;
+  }
+  fIsRunning = false;
+  fCondition.notify_all();
+}
+
+std::string JPetProgressReporter::formatRate(double eventsPerSecond)
+{
+  char buffer[32];
+  if (eventsPerSecond >= 1e6)
+  {
+    std::snprintf(buffer, sizeof(buffer), "%.1fM ev/s", eventsPerSecond / 1e6);
+  }
+  else if (eventsPerSecond >= 1e3)
+  {
+    std::snprintf(buffer, sizeof(buffer), "%.1fk ev/s", eventsPerSecond / 1e3);
+  }
+  else
+  {
+    std::snprintf(buffer, sizeof(buffer), "%.1f ev/s", eventsPerSecond);
+  }
+  return buffer;
+}
+
+/**
+ * @return duration in the h:mm:ss format
+ */
+std::string JPetProgressReporter::formatDuration(double seconds)
+{
+  long long total = static_cast<long long>(seconds + 0.5);
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%lld:%02lld:%02lld", total / 3600, (total / 60) % 60, total % 60);
+  return buffer;
+}
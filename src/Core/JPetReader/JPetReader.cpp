@@ -14,6 +14,7 @@
  */
 
 #include "JPetReader/JPetReader.h"
+#include "JPetTracer/JPetTracer.h"
 #include "JPetUserInfoStructure/JPetUserInfoStructure.h"
 #include <cassert>
 
@@ -87,6 +88,11 @@ long long JPetReader::getCurrentEntryNumber() const { return fCurrentEntryNumber
 
 long long JPetReader::getNbOfAllEntries() const { return fTree ? fTree->GetEntries() : 0; }
 
+/**
+ * @return number of the uncompressed bytes of the last loaded entry
+ */
+long long JPetReader::getCurrentEntrySize() const { return fCurrentEntrySize; }
+
 bool JPetReader::openFileAndLoadData(const char* filename, const char* treename)
 {
   if (openFile(filename))
@@ -105,10 +111,12 @@ void JPetReader::closeFile()
   fEntry = 0;
   fTree = 0;
   fCurrentEntryNumber = -1;
+  fCurrentEntrySize = 0;
 }
 
 bool JPetReader::openFile(const char* filename)
 {
+  JPetTracer::Scope scope("io", "JPetReader::openFile");
   closeFile();
   fFile = new TFile(filename);
   if ((!isOpen()) || fFile->IsZombie())
@@ -190,9 +198,11 @@ bool JPetReader::isOpen() const
 
 bool JPetReader::loadCurrentEntry()
 {
+  JPetTracer::Scope scope("io", "JPetReader::loadCurrentEntry");
   if (fTree)
   {
     int entryCode = fTree->GetEntry(fCurrentEntryNumber);
+    fCurrentEntrySize = entryCode > 0 ? entryCode : 0;
     return isCorrectTreeEntryCode(entryCode);
   }
   return false;
@@ -17,4 +17,13 @@
 
 JPetScopeData::JPetScopeData(const std::pair<int, std::map<std::string, int>>& event) : fEvent(event) {}
 
+JPetScopeData::JPetScopeData(const std::pair<int, std::map<std::string, int>>& event, std::vector<JPetRecoSignal>&& decodedSignals)
+    : fEvent(event), fDecodedSignals(std::move(decodedSignals))
+{
+}
+
 std::pair<int, std::map<std::string, int>> JPetScopeData::getEvent() const { return fEvent; }
+
+const std::vector<JPetRecoSignal>& JPetScopeData::getDecodedSignals() const { return fDecodedSignals; }
+
+bool JPetScopeData::hasDecodedSignals() const { return !fDecodedSignals.empty() && fDecodedSignals.size() == fEvent.second.size(); }
@@ -17,6 +17,7 @@
 #include "JPetLoggerInclude.h"
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
 #include "JPetParamsFactory/JPetParamsFactory.h"
+#include "JPetTracer/JPetTracer.h"
 
 #include <cassert>
 #include <memory>
@@ -40,6 +41,7 @@ bool JPetTaskChainExecutor::process()
   JPetTimer timer;
   JPetDataInterface nullDataObject;
   JPetParams controlParams; /// Parameters used to control the input file type and event range.
+  JPetTracer::Scope chainScope("chain", "chain " + std::to_string(fInputSeqId));
 
   /// We iterate over both tasks and parameters
   for (const auto& currentTask : fTasks)
@@ -50,24 +52,42 @@ bool JPetTaskChainExecutor::process()
     /// the previous task.
     currParams = jpet_params_factory::generateParams(currParams, controlParams);
     jpet_options_tools::printOptionsToLog(currParams.getOptions(), std::string("Options for ") + taskName);
-    timer.startMeasurement();
     INFO(Form("Starting task: %s", taskName.c_str()));
-    if (!currentTask->init(currParams))
+    JPetTracer::Scope taskScope("task", taskName);
+    timer.startMeasurement();
+    bool isOK = false;
+    {
+      JPetTracer::Scope initScope("task", taskName + " init");
+      isOK = currentTask->init(currParams);
+    }
+    if (!isOK)
     {
       ERROR("In task " + taskName + " init()");
       return false;
     }
-    if (!currentTask->run(nullDataObject))
+    timer.stopMeasurement("task " + taskName + " init");
+    timer.startMeasurement();
+    {
+      JPetTracer::Scope runScope("task", taskName + " run");
+      isOK = currentTask->run(nullDataObject);
+    }
+    if (!isOK)
     {
       ERROR("In task " + taskName + " run()");
       return false;
     }
-    if (!currentTask->terminate(controlParams))
-    { /// Here controParams can be modified by the current task.
+    timer.stopMeasurement("task " + taskName + " run");
+    timer.startMeasurement();
+    {
+      JPetTracer::Scope terminateScope("task", taskName + " terminate");
+      isOK = currentTask->terminate(controlParams); /// Here controParams can be modified by the current task.
+    }
+    if (!isOK)
+    {
       ERROR("In task " + taskName + " terminate()");
       return false;
     }
-    timer.stopMeasurement("task " + taskName);
+    timer.stopMeasurement("task " + taskName + " terminate");
   }
   INFO(timer.getAllMeasuredTimes());
   INFO(timer.getTotalMeasuredTime());
@@ -77,6 +97,10 @@ bool JPetTaskChainExecutor::process()
 void* JPetTaskChainExecutor::processProxy(void* runner)
 {
   assert(runner);
+  if (JPetTracer::isEnabled())
+  {
+    JPetTracer::setThreadName("chain " + std::to_string(static_cast<JPetTaskChainExecutor*>(runner)->fInputSeqId));
+  }
   static_cast<JPetTaskChainExecutor*>(runner)->process();
   return 0;
 }
@@ -14,8 +14,10 @@
  */
 
 #include "JPetTaskFactory/JPetTaskFactory.h"
+#include "JPetHLDLoader/JPetHLDLoader.h"
 #include "JPetParamBankHandlerTask/JPetParamBankHandlerTask.h"
 #include "JPetScopeLoader/JPetScopeLoader.h"
+#include "JPetTaskIO/JPetFusedTaskIO.h"
 #include "JPetTaskIO/JPetTaskIO.h"
 #include "JPetTaskLooper/JPetTaskLooper.h"
 #include "JPetUnzipAndUnpackTask/JPetUnzipAndUnpackTask.h"
@@ -60,12 +62,39 @@ void JPetTaskFactory::clear()
 TaskGeneratorChain generateTaskGeneratorChain(const std::vector<TaskInfo>& taskInfoVect, const std::map<std::string, TaskGenerator>& generatorsMap,
                                               const std::map<std::string, boost::any>& options)
 {
+  using namespace jpet_options_tools;
   TaskGeneratorChain chain;
   addDefaultTasksFromOptions(options, generatorsMap, chain);
 
-  for (const auto& taskInfo : taskInfoVect)
+  auto taskInfo = taskInfoVect.begin();
+  if (taskInfo != taskInfoVect.end() && JPetHLDLoader::isNativeDecodingOn(options))
+  {
+    addHLDLoaderToChain(generatorsMap, *taskInfo, chain);
+    taskInfo++;
+  }
+  /// the pipelined execution is possible only for the fused tasks
+  bool isFusing = (isOptionSet(options, kFuseTasksOptionName) && getOptionAsBool(options, kFuseTasksOptionName)) ||
+                  (isOptionSet(options, JPetFusedTaskIO::kPipelineKey) && getOptionAsBool(options, JPetFusedTaskIO::kPipelineKey));
+  while (taskInfo != taskInfoVect.end())
   {
-    addTaskToChain(generatorsMap, taskInfo, chain);
+    /// consecutive tasks executed once, reading the output of the previous one, are fused
+    auto groupEnd = taskInfo + 1;
+    if (isFusing && taskInfo->numOfIterations == 1)
+    {
+      while (groupEnd != taskInfoVect.end() && groupEnd->numOfIterations == 1 && groupEnd->inputFileType == (groupEnd - 1)->outputFileType)
+      {
+        groupEnd++;
+      }
+    }
+    if (groupEnd - taskInfo > 1)
+    {
+      addFusedTasksToChain(generatorsMap, std::vector<TaskInfo>(taskInfo, groupEnd), chain);
+    }
+    else
+    {
+      addTaskToChain(generatorsMap, *taskInfo, chain);
+    }
+    taskInfo = groupEnd;
   }
   return chain;
 }
@@ -135,6 +164,7 @@ void addTaskToChain(const std::map<std::string, TaskGenerator>& generatorsMap, c
           task->addSubTask(std::unique_ptr<JPetTaskInterface>(userTaskGen()));
           auto looperTask = jpet_common_tools::make_unique<JPetTaskLooper>(name.c_str(), std::move(task),
                                                                            JPetTaskLooper::getMaxIterationPredicate(numOfIterations));
+          looperTask->setNumberOfIterations(numOfIterations);
           return looperTask;
         });
       }
@@ -147,4 +177,64 @@ void addTaskToChain(const std::map<std::string, TaskGenerator>& generatorsMap, c
   }
 }
 
+/**
+ * The first user task reads the hld file directly via JPetHLDLoader,
+ * in place of the JPetTaskIO reading the hld.root file produced by the unpacker.
+ */
+void addHLDLoaderToChain(const std::map<std::string, TaskGenerator>& generatorsMap, const TaskInfo& info, TaskGeneratorChain& outChain)
+{
+  auto name = info.name;
+  auto outT = info.outputFileType;
+  if (generatorsMap.find(name) == generatorsMap.end())
+  {
+    ERROR(Form("The requested task %s is not registered! The output chain might be broken!", name.c_str()));
+    return;
+  }
+  if (info.numOfIterations != 1)
+  {
+    WARNING("The first task " + name + " reading the hld file directly is always executed once.");
+  }
+  TaskGenerator userTaskGen = generatorsMap.at(name);
+  outChain.push_back([name, outT, userTaskGen]() {
+    auto task = jpet_common_tools::make_unique<JPetHLDLoader>(name.c_str(), outT.c_str());
+    task->addSubTask(std::unique_ptr<JPetTaskInterface>(userTaskGen()));
+    return task;
+  });
+}
+
+/**
+ * The tasks are executed as the stages of a single JPetFusedTaskIO named after all of them,
+ * which reads the input file of the first task and writes the output file of the last one.
+ */
+void addFusedTasksToChain(const std::map<std::string, TaskGenerator>& generatorsMap, const std::vector<TaskInfo>& infos, TaskGeneratorChain& outChain)
+{
+  if (infos.empty())
+  {
+    return;
+  }
+  std::string name;
+  std::vector<TaskGenerator> userTaskGens;
+  std::vector<std::string> outTypes;
+  for (const auto& info : infos)
+  {
+    if (generatorsMap.find(info.name) == generatorsMap.end())
+    {
+      ERROR(Form("The requested task %s is not registered! The output chain might be broken!", info.name.c_str()));
+      return;
+    }
+    name += (name.empty() ? "" : "+") + info.name;
+    userTaskGens.push_back(generatorsMap.at(info.name));
+    outTypes.push_back(info.outputFileType);
+  }
+  auto inT = infos.front().inputFileType;
+  outChain.push_back([name, inT, outTypes, userTaskGens]() {
+    auto task = jpet_common_tools::make_unique<JPetFusedTaskIO>(name.c_str(), inT.c_str(), outTypes);
+    for (const auto& userTaskGen : userTaskGens)
+    {
+      task->addSubTask(std::unique_ptr<JPetTaskInterface>(userTaskGen()));
+    }
+    return task;
+  });
+}
+
 } // namespace jpet_task_factory
@@ -0,0 +1,440 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetFusedTaskIO.cpp
+ */
+
+#include "JPetTaskIO/JPetFusedTaskIO.h"
+#include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetData/JPetData.h"
+#include "JPetLoggerInclude.h"
+#include "JPetTimeWindowMC/JPetTimeWindowMC.h"
+#include "JPetTracer/JPetTracer.h"
+#include "JPetTreeHeader/JPetTreeHeader.h"
+#include "JPetUserTask/JPetUserTask.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+const std::string JPetFusedTaskIO::kCheckpointsKey = "JPetFusedTaskIO_Checkpoints_std::vector<std::string>";
+const std::string JPetFusedTaskIO::kPipelineKey = "JPetFusedTaskIO_Pipeline_bool";
+const std::string JPetFusedTaskIO::kPipelineQueueSizeKey = "JPetFusedTaskIO_PipelineQueueSize_int";
+
+JPetFusedTaskIO::JPetFusedTaskIO(const char* name, const char* in_file_type, const std::vector<std::string>& stage_out_file_types)
+    : JPetTaskIO(name, in_file_type, stage_out_file_types.empty() ? "" : stage_out_file_types.back().c_str()),
+      fStageOutFileTypes(stage_out_file_types)
+{
+}
+
+JPetFusedTaskIO::~JPetFusedTaskIO() {}
+
+bool JPetFusedTaskIO::run(const JPetDataInterface&)
+{
+  using namespace jpet_options_tools;
+  if (fSubTasks.empty())
+  {
+    ERROR("No subTask set");
+    return false;
+  }
+  if (fSubTasks.size() != fStageOutFileTypes.size())
+  {
+    ERROR("The number of subtasks does not match the number of the output file types of the stages");
+    return false;
+  }
+  if (!isInput() || !fInputHandler)
+  {
+    ERROR("No inputHandler set");
+    return false;
+  }
+
+  auto cacheDirectoryScope = startCacheDirectoryScope();
+  std::vector<JPetProfiler*> profilers;
+  for (std::size_t i = 0; i < fSubTasks.size(); i++)
+  {
+    const auto& pTask = fSubTasks[i];
+    JPetTracer::Scope subTaskScope("subtask", pTask->getName());
+    JPetTracer::Scope initTraceScope("subtask", "init");
+    profilers.push_back(startProfiling(i));
+    JPetProfiler::Scope initScope(profilers.back(), JPetProfiler::kInit);
+    if (!pTask->init(fParams))
+    {
+      ERROR("In init() of:" + pTask->getName() + ". The fused stages cannot be executed without it.");
+      return false;
+    }
+  }
+
+  if (!fInputHandler->setEntryRange(fParams.getOptions()))
+  {
+    ERROR("Some error occured in setEntryRange");
+    return false;
+  }
+  auto lastEvent = fInputHandler->getLastEntryNumber();
+  assert(lastEvent >= 0);
+  auto firstEvent = fInputHandler->getCurrentEntryNumber();
+  if (isProgressBar(fParams.getOptions()))
+  {
+    auto inputFile = JPetCommonTools::extractFileNameFromFullPath(getInputFile(fParams.getOptions()));
+    fProgressBar.startJob(getName() + " " + inputFile, lastEvent - firstEvent + 1);
+  }
+  bool isPipelined = isOptionSet(fParams.getOptions(), kPipelineKey) && getOptionAsBool(fParams.getOptions(), kPipelineKey);
+  fStageMCWindows.clear();
+  fStageMCWindows.resize(fSubTasks.size());
+  bool isOK = true;
+  {
+    JPetTracer::Scope runTraceScope("subtask", "run");
+    auto runStart = JPetProfiler::Clock::now();
+    isOK = isPipelined ? runPipeline(profilers, firstEvent) : runSequentially(profilers, firstEvent);
+    /// every stage processes the entries during the whole loop, so the loop time is the run time of each of them
+    auto runTime = JPetProfiler::Clock::now() - runStart;
+    for (auto profiler : profilers)
+    {
+      if (profiler)
+      {
+        profiler->add(JPetProfiler::kRun, runTime);
+      }
+    }
+  }
+  fProgressBar.finishJob();
+  fStageMCWindows.clear();
+  if (!isOK)
+  {
+    return false;
+  }
+  /// the stages after the first one do not see the empty windows, their number is taken from the input
+  auto numberOfWindows = fInputHandler->getNumberOfWindows();
+  if (fOutputHandler)
+  {
+    fOutputHandler->setNumberOfWindows(numberOfWindows);
+  }
+  for (const auto& checkpoint : fCheckpoints)
+  {
+    if (checkpoint)
+    {
+      checkpoint->setNumberOfWindows(numberOfWindows);
+    }
+  }
+
+  for (std::size_t i = 0; i < fSubTasks.size(); i++)
+  {
+    const auto& pTask = fSubTasks[i];
+    JPetTracer::Scope subTaskScope("subtask", pTask->getName());
+    JPetTracer::Scope terminateTraceScope("subtask", "terminate");
+    JPetParams subTaskParams;
+    {
+      JPetProfiler::Scope terminateScope(profilers[i], JPetProfiler::kTerminate);
+      if (!pTask->terminate(subTaskParams))
+      {
+        ERROR("In terminate() of:" + pTask->getName() + ". ");
+        return false;
+      }
+    }
+    fParams = mergeWithExtraParams(fParams, subTaskParams);
+  }
+  return true;
+}
+
+bool JPetFusedTaskIO::terminate(JPetParams& output_params)
+{
+  /// the checkpoints must be saved first, since saving the main output clears the parameter bank
+  saveCheckpoints();
+  return JPetTaskIO::terminate(output_params);
+}
+
+/**
+ * The checkpoint files are opened before the main output file, so that the main output file
+ * is the current ROOT directory while the stages are executed, as in JPetTaskIO.
+ */
+bool JPetFusedTaskIO::createOutputObjects(const char* outputFilename)
+{
+  using namespace jpet_options_tools;
+  const auto& options = fParams.getOptions();
+  std::vector<std::string> checkpointTypes;
+  if (isOptionSet(options, kCheckpointsKey))
+  {
+    checkpointTypes = getOptionAsVectorOfStrings(options, kCheckpointsKey);
+  }
+  fCheckpoints.clear();
+  fCheckpoints.resize(fSubTasks.size());
+  for (const auto& type : checkpointTypes)
+  {
+    auto stage = std::find(fStageOutFileTypes.begin(), fStageOutFileTypes.end(), type);
+    if (stage == fStageOutFileTypes.end() || stage + 1 == fStageOutFileTypes.end())
+    {
+      continue;
+    }
+    auto index = stage - fStageOutFileTypes.begin();
+    auto checkpointFile = JPetCommonTools::replaceDataTypeInFileName(outputFilename, type);
+    INFO("Output of " + fSubTasks[index]->getName() + " is saved in the checkpoint file " + checkpointFile);
+    fCheckpoints[index] = jpet_common_tools::make_unique<JPetOutputHandler>(checkpointFile.c_str());
+  }
+  return JPetTaskIO::createOutputObjects(outputFilename);
+}
+
+/**
+ * Every entry is passed through all the stages before the next one is read.
+ * @return false if any of the stages failed
+ */
+bool JPetFusedTaskIO::runSequentially(const std::vector<JPetProfiler*>& profilers, long long firstEvent)
+{
+  bool hasNextEntry = fInputHandler->hasEntry();
+  while (hasNextEntry)
+  {
+    JPetProfiler::Clock::time_point eventStart;
+    if (fIsProfiling)
+    {
+      eventStart = JPetProfiler::Clock::now();
+    }
+    TObject* stageInput = &fInputHandler->getEntry();
+    auto windowNumber = fInputHandler->getWindowNumber();
+    for (std::size_t i = 0; i < fSubTasks.size() && stageInput; i++)
+    {
+      TObject* stageOutput = nullptr;
+      if (!runStage(i, *stageInput, windowNumber, profilers[i], stageOutput))
+      {
+        return false;
+      }
+      stageInput = stageOutput;
+    }
+    fProgressBar.update(fInputHandler->getCurrentEntryNumber() - firstEvent + 1);
+    {
+      JPetProfiler::Scope readScope(profilers.front(), JPetProfiler::kRead);
+      hasNextEntry = fInputHandler->nextEntry();
+    }
+    if (!fIsProfiling)
+    {
+      continue;
+    }
+    auto eventTime = JPetProfiler::Clock::now() - eventStart;
+    for (auto profiler : profilers)
+    {
+      if (profiler)
+      {
+        profiler->add(JPetProfiler::kEvent, eventTime);
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * The first stage is executed in this thread together with the reading of the input,
+ * every other stage in its own thread. Each stage receives the copies of the time windows
+ * produced by the previous stage through a bounded queue, so it works on the earlier windows
+ * while the previous stage produces the next ones, and the previous stage waits if it is
+ * too far ahead. Since every stage is executed by a single thread and the queues keep the order,
+ * the user tasks need not be thread-safe and the order of the output is the same as of the input.
+ * The thread safety of ROOT must be enabled before, see JPetManager.
+ * @return false if any of the stages failed
+ */
+bool JPetFusedTaskIO::runPipeline(const std::vector<JPetProfiler*>& profilers, long long firstEvent)
+{
+  using namespace jpet_options_tools;
+  const auto& options = fParams.getOptions();
+  int queueSize = kDefaultPipelineQueueSize;
+  if (isOptionSet(options, kPipelineQueueSizeKey))
+  {
+    queueSize = std::max(1, getOptionAsInt(options, kPipelineQueueSizeKey));
+  }
+
+  std::vector<std::unique_ptr<StageQueue>> queues;
+  for (std::size_t i = 0; i + 1 < fSubTasks.size(); i++)
+  {
+    queues.push_back(jpet_common_tools::make_unique<StageQueue>(queueSize));
+  }
+  std::atomic<bool> isOK{true};
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < fSubTasks.size(); i++)
+  {
+    threads.emplace_back([this, i, &queues, &profilers, &isOK]() {
+      JPetTracer::setThreadName(fSubTasks[i]->getName());
+      auto cacheDirectoryScope = startCacheDirectoryScope();
+      auto& input = *queues[i - 1];
+      auto output = i < queues.size() ? queues[i].get() : nullptr;
+      StageWindow window;
+      while (input.pop(window))
+      {
+        JPetProfiler::Clock::time_point eventStart;
+        if (profilers[i])
+        {
+          eventStart = JPetProfiler::Clock::now();
+        }
+        if (!runPipelineStage(i, *window.fWindow, window.fWindowNumber, profilers[i], output))
+        {
+          /// stop the previous stages
+          isOK = false;
+          input.close();
+          break;
+        }
+        if (profilers[i])
+        {
+          profilers[i]->add(JPetProfiler::kEvent, JPetProfiler::Clock::now() - eventStart);
+        }
+      }
+      if (output)
+      {
+        output->close();
+      }
+    });
+  }
+
+  auto output = queues.empty() ? nullptr : queues.front().get();
+  bool hasNextEntry = fInputHandler->hasEntry();
+  while (hasNextEntry)
+  {
+    JPetProfiler::Clock::time_point eventStart;
+    if (profilers.front())
+    {
+      eventStart = JPetProfiler::Clock::now();
+    }
+    if (!runPipelineStage(0, fInputHandler->getEntry(), fInputHandler->getWindowNumber(), profilers.front(), output))
+    {
+      isOK = false;
+      break;
+    }
+    fProgressBar.update(fInputHandler->getCurrentEntryNumber() - firstEvent + 1);
+    {
+      JPetProfiler::Scope readScope(profilers.front(), JPetProfiler::kRead);
+      hasNextEntry = fInputHandler->nextEntry();
+    }
+    if (profilers.front())
+    {
+      profilers.front()->add(JPetProfiler::kEvent, JPetProfiler::Clock::now() - eventStart);
+    }
+  }
+  if (output)
+  {
+    output->close();
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  return isOK;
+}
+
+/**
+ * Execute the stage and write its output, if it is the last stage or the checkpoint is set for it.
+ * @param output the time window to be passed to the next stage, valid until the next execution of the stage,
+ * or nullptr if there is no window to pass (the last stage or the empty time window)
+ * @return false if the stage failed
+ */
+bool JPetFusedTaskIO::runStage(std::size_t i, TObject& input, ULong64_t windowNumber, JPetProfiler* profiler, TObject*& output)
+{
+  output = nullptr;
+  auto pTask = dynamic_cast<JPetUserTask*>(fSubTasks[i].get());
+  assert(pTask);
+  {
+    JPetProfiler::Scope execScope(profiler, JPetProfiler::kExec);
+    JPetData event(input);
+    if (!pTask->run(event))
+    {
+      ERROR("In run() of:" + pTask->getName() + ". ");
+      return false;
+    }
+  }
+  bool isLastStage = i + 1 == fSubTasks.size();
+  const auto& outputHandler = isLastStage ? fOutputHandler : fCheckpoints[i];
+  if (outputHandler)
+  {
+    JPetProfiler::Scope writeScope(profiler, JPetProfiler::kWrite);
+    outputHandler->setWindowNumber(windowNumber);
+    if (!outputHandler->writeEventToFile(pTask))
+    {
+      ERROR("Some problems occured, while writing the event to file.");
+      return false;
+    }
+  }
+  if (isLastStage)
+  {
+    return true;
+  }
+  auto pOutputEntry = pTask->getOutputEvents();
+  if (!pOutputEntry)
+  {
+    ERROR("No proper timeWindow object returned to pass to the next stage, returning from subtask " + pTask->getName());
+    return false;
+  }
+  /// the same time window as would be written by JPetOutputHandler is passed to the next stage
+  auto pInputEvent = dynamic_cast<JPetTimeWindowMC*>(pTask->getInputEvents());
+  if (pInputEvent)
+  {
+    fStageMCWindows[i] = jpet_common_tools::make_unique<JPetTimeWindowMC>(*pInputEvent, *pOutputEntry);
+    output = fStageMCWindows[i].get();
+  }
+  else if (pOutputEntry->getNumberOfEvents() > 0)
+  {
+    output = pOutputEntry;
+  }
+  return true;
+}
+
+/**
+ * Execute the stage and pass the copy of its output to the next stage,
+ * since the output time window of the user task is cleared in the next execution.
+ * @return false if the stage failed or the next stage was stopped
+ */
+bool JPetFusedTaskIO::runPipelineStage(std::size_t i, TObject& input, ULong64_t windowNumber, JPetProfiler* profiler, StageQueue* queue)
+{
+  TObject* output = nullptr;
+  if (!runStage(i, input, windowNumber, profiler, output))
+  {
+    return false;
+  }
+  if (!output || !queue)
+  {
+    return true;
+  }
+  StageWindow window;
+  window.fWindowNumber = windowNumber;
+  if (output == fStageMCWindows[i].get())
+  {
+    window.fWindow = std::move(fStageMCWindows[i]);
+  }
+  else
+  {
+    window.fWindow = jpet_common_tools::make_unique<JPetTimeWindow>(*static_cast<JPetTimeWindow*>(output));
+  }
+  return queue->push(std::move(window));
+}
+
+void JPetFusedTaskIO::saveCheckpoints()
+{
+  for (std::size_t i = 0; i < fCheckpoints.size(); i++)
+  {
+    if (!fCheckpoints[i])
+    {
+      continue;
+    }
+    auto header = createHeader();
+    if (!header || !fStatistics)
+    {
+      ERROR("Unable to save the checkpoint of the subtask " + fSubTasks[i]->getName());
+      continue;
+    }
+    std::map<std::string, std::unique_ptr<JPetStatistics>> stagesStatistics;
+    for (std::size_t stage = 0; stage <= i; stage++)
+    {
+      const auto& name = fSubTasks[stage]->getName();
+      header->addStageInfo(name, "", 0, JPetCommonTools::getTimeString());
+      auto statisticsName = name + " subtask " + std::to_string(stage) + " stats";
+      auto statistics = fSubTasksStatistics.find(statisticsName);
+      if (statistics != fSubTasksStatistics.end() && statistics->second)
+      {
+        stagesStatistics[statisticsName] = jpet_common_tools::make_unique<JPetStatistics>(*statistics->second);
+      }
+    }
+    fCheckpoints[i]->saveAndCloseOutput(getParamManager(), header, fStatistics.get(), stagesStatistics, false);
+  }
+  fCheckpoints.clear();
+}
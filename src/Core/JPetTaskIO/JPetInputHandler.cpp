@@ -17,13 +17,21 @@
 #include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
 #include "JPetTaskIO/JPetTaskIOTools.h"
+#include <TTree.h>
+#include <algorithm>
 
 JPetInputHandler::JPetInputHandler() { fReader = jpet_common_tools::make_unique<JPetReader>(); }
 
 bool JPetInputHandler::openInput(const char* inputFilename, const JPetParams& params)
 {
   using namespace jpet_options_tools;
-  auto options = params.getOptions();
+  const auto& options = params.getOptions();
+  if (fInputFileName != inputFilename)
+  {
+    clearCache();
+    fInputFileName = inputFilename;
+  }
+  fIsReaderAtCurrentEntry = true;
   if (fReader->openFileAndLoadData(inputFilename, JPetReader::kRootTreeName.c_str()))
   {
     /// For all types of files which has not hld format we assume
@@ -40,6 +48,7 @@ bool JPetInputHandler::openInput(const char* inputFilename, const JPetParams& pa
       }
       assert(paramManager->getParamBank().getPMsSize() > 0);
     }
+    fIsIndexLoaded = loadIndex();
   }
   else
   {
@@ -55,6 +64,43 @@ void JPetInputHandler::closeInput()
   {
     fReader->closeFile();
   }
+  fIndex.clear();
+  fIsIndexLoaded = false;
+}
+
+/**
+ * Sets the predicate selecting the entries to be read, an empty one turns the filter off.
+ * It is applied to the files opened afterwards, which contain the window index.
+ */
+void JPetInputHandler::setEntryFilter(const JPetWindowIndex::Predicate& filter) { fEntryFilter = filter; }
+
+bool JPetInputHandler::isEntryFilterActive() const { return fEntryFilter && fIsIndexLoaded; }
+
+/**
+ * The index is used only if it describes all entries of the input tree.
+ */
+bool JPetInputHandler::loadIndex()
+{
+  fIndex.clear();
+  auto reader = dynamic_cast<JPetReader*>(fReader.get());
+  auto tree = reader ? dynamic_cast<TTree*>(reader->getObjectFromFile(JPetWindowIndex::kIndexTreeName.c_str())) : nullptr;
+  if (!tree)
+  {
+    if (fEntryFilter)
+    {
+      WARNING(fInputFileName + ": no window index in the input file, the entry filter is ignored");
+    }
+    return false;
+  }
+  bool isOK = fIndex.read(*tree);
+  delete tree;
+  if (!isOK || fIndex.size() != fReader->getNbOfAllEntries())
+  {
+    WARNING(fInputFileName + ": the window index does not match the input tree and is ignored");
+    fIndex.clear();
+    return false;
+  }
+  return true;
 }
 
 EntryRange JPetInputHandler::getEntryRange() const { return fEntryRange; }
@@ -72,9 +118,37 @@ bool JPetInputHandler::setEntryRange(const jpet_options_tools::OptsStrAny& optio
   }
   fEntryRange.firstEntry = firstEntry;
   fEntryRange.lastEntry = lastEntry;
-  fEntryRange.currentEntry = firstEntry;
+  fHasEntry = true;
+  if (isEntryFilterActive())
+  {
+    auto matching = fIndex.findNext(firstEntry, lastEntry, fEntryFilter);
+    if (matching < 0)
+    {
+      INFO(fInputFileName + ": no entry matches the entry filter");
+      fHasEntry = false;
+      fEntryRange.currentEntry = lastEntry;
+      fIsReaderAtCurrentEntry = false;
+      return true;
+    }
+    firstEntry = matching;
+  }
+  return moveTo(firstEntry);
+}
+
+/**
+ * Moves to the given entry, the reader is moved only if the entry is not cached.
+ */
+bool JPetInputHandler::moveTo(long long entry)
+{
+  fEntryRange.currentEntry = entry;
+  if (isCached(entry))
+  {
+    fIsReaderAtCurrentEntry = false;
+    return true;
+  }
+  fIsReaderAtCurrentEntry = true;
   assert(fReader);
-  return fReader->nthEntry(fEntryRange.currentEntry);
+  return fReader->nthEntry(entry);
 }
 
 std::tuple<bool, long long, long long> JPetInputHandler::calculateEntryRange(const jpet_options_tools::OptsStrAny& options) const
@@ -94,24 +168,114 @@ std::tuple<bool, long long, long long> JPetInputHandler::calculateEntryRange(con
 
 TObject& JPetInputHandler::getEntry()
 {
+  auto current = fEntryRange.currentEntry;
+  if (isCached(current))
+  {
+    return *fCache[current - fFirstCachedEntry];
+  }
   assert(fReader);
+  if (!fIsReaderAtCurrentEntry)
+  {
+    fReader->nthEntry(current);
+    fIsReaderAtCurrentEntry = true;
+  }
   auto& ob = fReader->getCurrentEntry();
+  if (fCacheSize > 0)
+  {
+    addToCache(current, ob);
+  }
   return ob;
 }
 
 bool JPetInputHandler::nextEntry()
 {
-  if (fEntryRange.currentEntry == fEntryRange.lastEntry)
+  if (!fHasEntry || fEntryRange.currentEntry == fEntryRange.lastEntry)
   {
     return false;
   }
+  if (isEntryFilterActive())
+  {
+    auto matching = fIndex.findNext(fEntryRange.currentEntry + 1, fEntryRange.lastEntry, fEntryFilter);
+    if (matching < 0)
+    {
+      return false;
+    }
+    if (matching != fEntryRange.currentEntry + 1)
+    {
+      return moveTo(matching);
+    }
+  }
   fEntryRange.currentEntry++;
+  if (isCached(fEntryRange.currentEntry))
+  {
+    fIsReaderAtCurrentEntry = false;
+    return true;
+  }
   assert(fReader);
+  if (!fIsReaderAtCurrentEntry)
+  {
+    fIsReaderAtCurrentEntry = true;
+    return fReader->nthEntry(fEntryRange.currentEntry);
+  }
   return fReader->nextEntry();
 }
 
+bool JPetInputHandler::hasEntry() const { return fHasEntry; }
+
+/**
+ * @return the number of the current time window in the original data, taken from the window index,
+ * or the number of the current entry, if the input file has no index, e.g. it is the unpacked data
+ */
+ULong64_t JPetInputHandler::getWindowNumber() const
+{
+  auto current = fEntryRange.currentEntry;
+  if (fIsIndexLoaded && current >= 0 && current < fIndex.size())
+  {
+    return fIndex[current].fWindowNumber;
+  }
+  return current < 0 ? 0 : current;
+}
+
+/**
+ * @return the total number of time windows in the original data, taken from the window index,
+ * or the number of entries, if the input file has no index
+ */
+ULong64_t JPetInputHandler::getNumberOfWindows() const
+{
+  if (fIsIndexLoaded)
+  {
+    return fIndex.getNumberOfWindows();
+  }
+  assert(fReader);
+  return std::max(0ll, fReader->getNbOfAllEntries());
+}
+
+/**
+ * Moves to the entry with the given time window or, if it was not written, e.g. since it was empty,
+ * to the first entry after it. The following nextEntry() calls continue from there.
+ * @return false if there is no such entry in the entry range
+ */
+bool JPetInputHandler::seekWindow(ULong64_t windowNumber)
+{
+  auto entry = fIsIndexLoaded ? fIndex.findWindow(windowNumber) : static_cast<long long>(windowNumber);
+  if (isEntryFilterActive() && entry >= 0)
+  {
+    entry = fIndex.findNext(entry, fEntryRange.lastEntry, fEntryFilter);
+  }
+  if (entry < fEntryRange.firstEntry || entry > fEntryRange.lastEntry)
+  {
+    return false;
+  }
+  fHasEntry = true;
+  return moveTo(entry);
+}
+
 long long JPetInputHandler::getCurrentEntryNumber() const
 {
+  if (!fIsReaderAtCurrentEntry)
+  {
+    return fEntryRange.currentEntry;
+  }
   assert(fReader);
   return fReader->getCurrentEntryNumber();
 }
@@ -125,3 +289,65 @@ JPetTreeHeader* JPetInputHandler::getHeaderClone()
   assert(fReader);
   return dynamic_cast<JPetReader*>(fReader.get())->getHeaderClone();
 }
+
+/**
+ * Set the maximal total size of the cached entries in bytes, 0 turns the cache off.
+ */
+void JPetInputHandler::setCacheSize(std::size_t bytes)
+{
+  if (bytes < fCachedBytes)
+  {
+    clearCache();
+  }
+  fCacheSize = bytes;
+  fIsCacheFull = false;
+}
+
+void JPetInputHandler::clearCache()
+{
+  fCache.clear();
+  fCachedBytes = 0;
+  fFirstCachedEntry = 0;
+  fIsCacheFull = false;
+}
+
+std::size_t JPetInputHandler::getCacheSize() const { return fCacheSize; }
+
+std::size_t JPetInputHandler::getCachedBytes() const { return fCachedBytes; }
+
+long long JPetInputHandler::getNumberOfCachedEntries() const { return fCache.size(); }
+
+bool JPetInputHandler::isCached(long long entry) const
+{
+  return entry >= fFirstCachedEntry && entry < fFirstCachedEntry + static_cast<long long>(fCache.size());
+}
+
+/**
+ * Only the entry following the already cached ones is added, so that the cache
+ * contains the continuous range of entries, which is not extended after the size limit is reached.
+ */
+void JPetInputHandler::addToCache(long long entry, TObject& object)
+{
+  if (fIsCacheFull)
+  {
+    return;
+  }
+  if (fCache.empty())
+  {
+    fFirstCachedEntry = entry;
+  }
+  if (entry != fFirstCachedEntry + static_cast<long long>(fCache.size()))
+  {
+    return;
+  }
+  auto reader = dynamic_cast<JPetReader*>(fReader.get());
+  std::size_t size = reader ? reader->getCurrentEntrySize() : sizeof(TObject);
+  if (fCachedBytes + size > fCacheSize)
+  {
+    fIsCacheFull = true;
+    INFO("The input cache is full after " + std::to_string(fCache.size()) + " entries, the following entries are read from the file.");
+    return;
+  }
+  fCache.emplace_back(object.Clone());
+  fCachedBytes += size;
+}
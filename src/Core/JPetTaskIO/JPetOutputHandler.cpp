@@ -26,7 +26,7 @@ JPetOutputHandler::JPetOutputHandler() : fWriter("defaultOutput.root") {}
 JPetOutputHandler::JPetOutputHandler(const char* outputFilename) : fWriter(outputFilename) {}
 
 void JPetOutputHandler::saveOutput(JPetParamManager& manager, JPetTreeHeader* fHeader, JPetStatistics* fStatistics,
-                                   std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics)
+                                   std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics, bool clearParameters)
 {
   assert(fHeader);
   assert(fStatistics);
@@ -40,7 +40,10 @@ void JPetOutputHandler::saveOutput(JPetParamManager& manager, JPetTreeHeader* fH
   }
   // store the parametric objects in the ouptut ROOT file
   manager.saveParametersToFile(&fWriter);
-  manager.clearParameters();
+  if (clearParameters)
+  {
+    manager.clearParameters();
+  }
 }
 
 bool JPetOutputHandler::writeEventToFile(JPetTaskInterface* task)
@@ -50,6 +53,9 @@ bool JPetOutputHandler::writeEventToFile(JPetTaskInterface* task)
   auto pOutputEntry = pUserTask->getOutputEvents();
   if (pOutputEntry != nullptr)
   {
+    fWriter.setIndexFlags(pUserTask->getWindowFlags());
+    fWriter.setIndexWindowNumber(fWindowNumber++);
+    fWriter.setIndexNumberOfWindows(fWindowNumber);
     auto pInputEvent = dynamic_cast<JPetTimeWindowMC*>(pUserTask->getInputEvents());
     if ((pInputEvent != nullptr))
     {
@@ -70,10 +76,14 @@ bool JPetOutputHandler::writeEventToFile(JPetTaskInterface* task)
   return true;
 }
 
+void JPetOutputHandler::setWindowNumber(ULong64_t windowNumber) { fWindowNumber = windowNumber; }
+
+void JPetOutputHandler::setNumberOfWindows(ULong64_t numberOfWindows) { fWriter.setIndexNumberOfWindows(numberOfWindows); }
+
 /// @todo change it!!!
 void JPetOutputHandler::saveAndCloseOutput(JPetParamManager& manager, JPetTreeHeader* fHeader, JPetStatistics* fStatistics,
-                                           std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics)
+                                           std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics, bool clearParameters)
 {
-  saveOutput(manager, fHeader, fStatistics, fSubTasksStatistics);
+  saveOutput(manager, fHeader, fStatistics, fSubTasksStatistics, clearParameters);
   fWriter.closeFile();
 }
@@ -14,6 +14,7 @@
  */
 
 #include "JPetTaskIO/JPetTaskIO.h"
+#include "JPetCachedFunction/JPetCachedFunction.h"
 #include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetData/JPetData.h"
 #include "JPetLoggerInclude.h"
@@ -21,12 +22,26 @@
 #include "JPetTask/JPetTask.h"
 #include "JPetTaskIO/JPetTaskIOTools.h"
 #include "JPetTaskIO/version.h"
+#include "JPetTracer/JPetTracer.h"
 #include "JPetTreeHeader/JPetTreeHeader.h"
 #include "JPetUserTask/JPetUserTask.h"
 
+#include <TH1D.h>
+#include <algorithm>
 #include <cassert>
+#include <fstream>
+#include <limits>
 #include <memory>
 
+const std::string JPetTaskIO::kProfilingKey = "JPetTaskIO_Profiling_bool";
+const std::string JPetTaskIO::kInputCacheKey = "JPetTaskIO_InputCacheSizeMB_int";
+const std::string JPetTaskIO::kSkipOutputEventsKey = "JPetTaskIO_SkipOutputEvents_bool";
+const std::string JPetTaskIO::kIndexMinEventsKey = "JPetTaskIO_IndexMinEvents_int";
+const std::string JPetTaskIO::kIndexMinTimeKey = "JPetTaskIO_IndexMinTime_double";
+const std::string JPetTaskIO::kIndexMaxTimeKey = "JPetTaskIO_IndexMaxTime_double";
+const std::string JPetTaskIO::kIndexFlagsKey = "JPetTaskIO_IndexFlags_int";
+const std::string JPetTaskIO::kCacheDirectoryKey = "JPetCachedFunction_CacheDirectory_std::string";
+
 JPetTaskIO::JPetTaskIO(const char* name, const char* in_file_type, const char* out_file_type)
     : JPetTask(name), fTaskInfo(in_file_type, out_file_type, "", false)
 {
@@ -46,7 +61,12 @@ bool JPetTaskIO::init(const JPetParams& params)
 {
   using namespace jpet_options_tools;
   setParams(params);
-  auto opts = fParams.getOptions();
+  const auto& opts = fParams.getOptions();
+  static const JPetOptions::Key profilingKey(kProfilingKey);
+  static const JPetOptions::Key skipOutputEventsKey(kSkipOutputEventsKey);
+  fIsProfiling = fParams.getSharedOptions()->get(profilingKey, false);
+  fIsSkippingOutputEvents = fParams.getSharedOptions()->get(skipOutputEventsKey, false);
+  fCacheDirectory = isOptionSet(opts, kCacheDirectoryKey) ? getOptionAsString(opts, kCacheDirectoryKey) : "";
 
   bool isOK = false;
   std::string inputFilename;
@@ -100,10 +120,19 @@ bool JPetTaskIO::run(const JPetDataInterface&)
       return false;
     }
   }
-  for (const auto& pTask : fSubTasks)
+  auto cacheDirectoryScope = startCacheDirectoryScope();
+  for (std::size_t i = 0; i < fSubTasks.size(); i++)
   {
+    const auto& pTask = fSubTasks[i];
     auto subTaskName = pTask->getName();
-    bool isOK = pTask->init(fParams);
+    JPetTracer::Scope subTaskScope("subtask", subTaskName);
+    auto profiler = startProfiling(i);
+    bool isOK = false;
+    {
+      JPetTracer::Scope initTraceScope("subtask", "init");
+      JPetProfiler::Scope initScope(profiler, JPetProfiler::kInit);
+      isOK = pTask->init(fParams);
+    }
 
     if (!isOK)
     {
@@ -123,37 +152,72 @@ bool JPetTaskIO::run(const JPetDataInterface&)
       }
       auto lastEvent = fInputHandler->getLastEntryNumber();
       assert(lastEvent >= 0);
-      do
+      auto firstEvent = fInputHandler->getCurrentEntryNumber();
+      if (isProgressBarOn)
+      {
+        auto inputFile = JPetCommonTools::extractFileNameFromFullPath(getInputFile(fParams.getOptions()));
+        fProgressBar.startJob(subTaskName + " " + inputFile, lastEvent - firstEvent + 1);
+      }
+      JPetTracer::Scope runTraceScope("subtask", "run");
+      JPetProfiler::Scope runScope(profiler, JPetProfiler::kRun);
+      bool hasNextEntry = fInputHandler->hasEntry();
+      while (hasNextEntry)
       {
-        if (isProgressBarOn)
+        JPetProfiler::Clock::time_point eventStart;
+        if (profiler)
         {
-          displayProgressBar(subTaskName, fInputHandler->getCurrentEntryNumber(), lastEvent);
+          eventStart = JPetProfiler::Clock::now();
         }
         JPetData event(fInputHandler->getEntry());
-        isOK = pTask->run(event);
+        {
+          JPetProfiler::Scope execScope(profiler, JPetProfiler::kExec);
+          isOK = pTask->run(event);
+        }
         if (!isOK)
         {
           ERROR("In run() of:" + subTaskName + ". ");
           return false;
         }
-        if (isOutput())
+        if (isOutput() && !fIsSkippingOutputEvents)
         {
+          JPetProfiler::Scope writeScope(profiler, JPetProfiler::kWrite);
+          fOutputHandler->setWindowNumber(fInputHandler->getWindowNumber());
           if (!fOutputHandler->writeEventToFile(pTask.get()))
           {
             ERROR("Some problems occured, while writing the event to file.");
             return false;
           }
         }
-      } while (fInputHandler->nextEntry());
+        fProgressBar.update(fInputHandler->getCurrentEntryNumber() - firstEvent + 1);
+        {
+          JPetProfiler::Scope readScope(profiler, JPetProfiler::kRead);
+          hasNextEntry = fInputHandler->nextEntry();
+        }
+        if (profiler)
+        {
+          profiler->add(JPetProfiler::kEvent, JPetProfiler::Clock::now() - eventStart);
+        }
+      }
+      if (isOutput() && !fIsSkippingOutputEvents)
+      {
+        fOutputHandler->setNumberOfWindows(fInputHandler->getNumberOfWindows());
+      }
+      fProgressBar.finishJob();
     }
     else
     {
+      JPetTracer::Scope runTraceScope("subtask", "run");
+      JPetProfiler::Scope runScope(profiler, JPetProfiler::kRun);
       JPetDataInterface dummyEvent;
       pTask->run(dummyEvent);
     }
 
     JPetParams subTaskParams;
-    isOK = pTask->terminate(subTaskParams);
+    {
+      JPetTracer::Scope terminateTraceScope("subtask", "terminate");
+      JPetProfiler::Scope terminateScope(profiler, JPetProfiler::kTerminate);
+      isOK = pTask->terminate(subTaskParams);
+    }
     if (!isOK)
     {
       ERROR("In terminate() of:" + subTaskName + ". ");
@@ -191,8 +255,13 @@ bool JPetTaskIO::terminate(JPetParams& output_params)
       ERROR("Subtask name:" + subTaskName);
       return false;
     }
+    saveProfiles(fTaskInfo.fOutFileFullPath);
     fOutputHandler->saveAndCloseOutput(getParamManager(), fHeader, fStatistics.get(), fSubTasksStatistics);
   }
+  else
+  {
+    saveProfiles(jpet_options_tools::getInputFile(fParams.getOptions()));
+  }
   if (isInput())
   {
     if (!fInputHandler)
@@ -228,7 +297,7 @@ JPetParams JPetTaskIO::mergeWithExtraParams(const JPetParams& oldParams, const J
   using namespace jpet_options_tools;
   using namespace jpet_options_generator_tools;
   auto oldOpts = oldParams.getOptions();
-  auto extraOpts = extraParams.getOptions();
+  const auto& extraOpts = extraParams.getOptions();
   // @todo this is hardcoded and should be moved somewhere.
   const std::string stopIterationOptName = "StopIteration_bool";
   if (isOptionSet(extraOpts, stopIterationOptName))
@@ -258,10 +327,49 @@ std::tuple<bool, std::string, std::string, bool> JPetTaskIO::setInputAndOutputFi
 
 bool JPetTaskIO::createInputObjects(const char* inputFilename)
 {
-  fInputHandler = jpet_common_tools::make_unique<JPetInputHandler>();
+  static const JPetOptions::Key inputCacheKey(kInputCacheKey);
+  auto cacheSizeMB = fParams.getSharedOptions()->get(inputCacheKey, 0);
+  /// The input handler with the cache is kept, so the next init() of this task
+  /// with the same input file, e.g. in JPetTaskLooper, reads the cached entries.
+  if (!fInputHandler || cacheSizeMB <= 0)
+  {
+    fInputHandler = jpet_common_tools::make_unique<JPetInputHandler>();
+  }
+  fInputHandler->setCacheSize(cacheSizeMB > 0 ? static_cast<std::size_t>(cacheSizeMB) * 1024 * 1024 : 0);
+  fInputHandler->setEntryFilter(createEntryFilter(fParams.getOptions()));
   return fInputHandler->openInput(inputFilename, fParams);
 }
 
+/**
+ * Builds the filter of the input entries based on the window index (see JPetWindowIndex) from the options:
+ * the minimal number of events in the window, the time range [min, max] the window must overlap with,
+ * and the flags which must be all set. If none of the options is set, the returned filter is empty.
+ */
+JPetWindowIndex::Predicate JPetTaskIO::createEntryFilter(const OptsStrAny& options)
+{
+  using namespace jpet_options_tools;
+  std::vector<JPetWindowIndex::Predicate> predicates;
+  if (isOptionSet(options, kIndexMinEventsKey))
+  {
+    predicates.push_back(JPetWindowIndex::minNumberOfEvents(std::max(0, getOptionAsInt(options, kIndexMinEventsKey))));
+  }
+  if (isOptionSet(options, kIndexMinTimeKey) || isOptionSet(options, kIndexMaxTimeKey))
+  {
+    auto minTime = isOptionSet(options, kIndexMinTimeKey) ? getOptionAsDouble(options, kIndexMinTimeKey) : -std::numeric_limits<double>::max();
+    auto maxTime = isOptionSet(options, kIndexMaxTimeKey) ? getOptionAsDouble(options, kIndexMaxTimeKey) : std::numeric_limits<double>::max();
+    predicates.push_back(JPetWindowIndex::timeRange(minTime, maxTime));
+  }
+  if (isOptionSet(options, kIndexFlagsKey))
+  {
+    predicates.push_back(JPetWindowIndex::allFlags(static_cast<ULong64_t>(getOptionAsInt(options, kIndexFlagsKey))));
+  }
+  if (predicates.empty())
+  {
+    return JPetWindowIndex::Predicate();
+  }
+  return predicates.size() == 1 ? predicates.front() : JPetWindowIndex::allOf(predicates);
+}
+
 bool JPetTaskIO::createOutputObjects(const char* outputFilename)
 {
   if (!isOutput())
@@ -275,32 +383,10 @@ bool JPetTaskIO::createOutputObjects(const char* outputFilename)
     ERROR("OutputHandler is not set, cannot creat output file.");
     return false;
   }
-  using namespace jpet_options_tools;
-  auto options = fParams.getOptions();
-
-  if (FileTypeChecker::getInputFileType(options) == FileTypeChecker::kHldRoot ||
-      FileTypeChecker::getInputFileType(options) == FileTypeChecker::kMCGeant)
+  fHeader = createHeader();
+  if (!fHeader)
   {
-
-    fHeader = new JPetTreeHeader(getRunNumber(options));
-    fHeader->setFrameworkVersion(FRAMEWORK_VERSION);
-    fHeader->setFrameworkRevision(FRAMEWORK_REVISION);
-
-    // add general info to the Tree header
-    fHeader->setBaseFileName(getInputFile(options).c_str());
-  }
-  else
-  {
-    if (isInput())
-    {
-      // read the header from the previous analysis stage
-      fHeader = fInputHandler->getHeaderClone();
-    }
-    else
-    {
-      ERROR("We are trying to load Tree Header from the input file, and no input is set.");
-      return false;
-    }
+    return false;
   }
 
   fStatistics = jpet_common_tools::make_unique<JPetStatistics>();
@@ -331,6 +417,51 @@ bool JPetTaskIO::createOutputObjects(const char* outputFilename)
   return true;
 }
 
+/**
+ * @return header of the output file without the information about the subtasks of this task:
+ * a new one for the raw data, otherwise the copy of the header read from the input file.
+ * The shard processed by this task is stored in the header, so the partial outputs
+ * can be merged by JPetMerger. nullptr is returned if the header cannot be created.
+ */
+JPetTreeHeader* JPetTaskIO::createHeader()
+{
+  using namespace jpet_options_tools;
+  const auto& options = fParams.getOptions();
+
+  JPetTreeHeader* header = nullptr;
+  /// The raw data (also decoded directly by JPetHLDLoader) do not contain the tree header
+  if (FileTypeChecker::getInputFileType(options) == FileTypeChecker::kHldRoot ||
+      FileTypeChecker::getInputFileType(options) == FileTypeChecker::kMCGeant || FileTypeChecker::getInputFileType(options) == FileTypeChecker::kHld ||
+      FileTypeChecker::getInputFileType(options) == FileTypeChecker::kZip)
+  {
+
+    header = new JPetTreeHeader(getRunNumber(options));
+    header->setFrameworkVersion(FRAMEWORK_VERSION);
+    header->setFrameworkRevision(FRAMEWORK_REVISION);
+
+    // add general info to the Tree header
+    header->setBaseFileName(getInputFile(options).c_str());
+  }
+  else
+  {
+    if (isInput())
+    {
+      // read the header from the previous analysis stage
+      header = fInputHandler->getHeaderClone();
+    }
+    else
+    {
+      ERROR("We are trying to load Tree Header from the input file, and no input is set.");
+      return nullptr;
+    }
+  }
+  if (header && getNumberOfShards(options) > 1)
+  {
+    header->setVariable(JPetTaskIOTools::kShardHeaderVariable, std::to_string(getShardIndex(options)) + "/" + std::to_string(getNumberOfShards(options)));
+  }
+  return header;
+}
+
 const JPetParamBank& JPetTaskIO::getParamBank()
 {
   DEBUG("from JPetTaskIO");
@@ -370,3 +501,89 @@ std::string JPetTaskIO::getFirstSubTaskName() const
   }
   return subTaskName;
 }
+
+/**
+ * Sets the cache directory of the tabulated functions in the current thread,
+ * until the returned scope is destroyed.
+ * @return nullptr if the directory is not given in the options
+ */
+std::unique_ptr<jpet_common_tools::JPetCachedFunctionStore::DirectoryScope> JPetTaskIO::startCacheDirectoryScope() const
+{
+  if (fCacheDirectory.empty())
+  {
+    return nullptr;
+  }
+  return jpet_common_tools::make_unique<jpet_common_tools::JPetCachedFunctionStore::DirectoryScope>(fCacheDirectory);
+}
+
+/**
+ * @return profiler for the subtask with the given index, or nullptr if the profiling is off
+ */
+JPetProfiler* JPetTaskIO::startProfiling(std::size_t subTaskIndex)
+{
+  if (!fIsProfiling)
+  {
+    return nullptr;
+  }
+  if (fProfilers.size() <= subTaskIndex)
+  {
+    fProfilers.resize(subTaskIndex + 1);
+  }
+  fProfilers[subTaskIndex] = jpet_common_tools::make_unique<JPetProfiler>(fSubTasks[subTaskIndex]->getName());
+  return fProfilers[subTaskIndex].get();
+}
+
+/**
+ * Add the latency histograms of every measured stage to the statistics of the subtasks
+ * (saved later in the output file) and write the summary of all subtasks to fileName.profile.json.
+ */
+void JPetTaskIO::saveProfiles(const std::string& fileName)
+{
+  if (!fIsProfiling)
+  {
+    return;
+  }
+  const auto edges = JPetProfiler::getBinEdges();
+  std::string json = "{\"task\": \"" + getName() + "\", \"subtasks\": [";
+  bool isFirst = true;
+  for (std::size_t i = 0; i < fProfilers.size(); i++)
+  {
+    if (!fProfilers[i])
+    {
+      continue;
+    }
+    const auto& profiler = *fProfilers[i];
+    json += (isFirst ? "" : ", ") + profiler.toJSON();
+    isFirst = false;
+    auto statistics = fSubTasksStatistics.find(profiler.getName() + " subtask " + std::to_string(i) + " stats");
+    if (statistics == fSubTasksStatistics.end())
+    {
+      continue;
+    }
+    for (int stage = 0; stage < JPetProfiler::kNumberOfStages; stage++)
+    {
+      const auto& stageStats = profiler.getStage(static_cast<JPetProfiler::Stage>(stage));
+      if (stageStats.count == 0)
+      {
+        continue;
+      }
+      std::string name = std::string("profile_") + JPetProfiler::getStageName(static_cast<JPetProfiler::Stage>(stage));
+      auto histogram = new TH1D(name.c_str(), (name + ";time [s];entries").c_str(), JPetProfiler::kNumberOfBins, edges.data());
+      histogram->SetDirectory(nullptr);
+      for (int bin = 0; bin < JPetProfiler::kNumberOfBins + 2; bin++)
+      {
+        histogram->SetBinContent(bin, stageStats.histogram[bin]);
+      }
+      histogram->SetEntries(stageStats.count);
+      statistics->second->createHistogram(histogram);
+    }
+  }
+  json += "]}\n";
+
+  std::ofstream out(fileName + ".profile.json");
+  out << json;
+  if (!out)
+  {
+    WARNING("Unable to write the profiling summary to " + fileName + ".profile.json");
+  }
+}
@@ -69,12 +69,40 @@ std::tuple<bool, long long, long long> setUserLimits(const OptsStrAny& opts, con
     ERROR("first > last");
     return std::make_tuple(false, -1, -1);
   }
+  const auto kNumberOfShards = getNumberOfShards(opts);
+  if (kNumberOfShards > 1)
+  {
+    const auto kShardIndex = getShardIndex(opts);
+    std::tie(first, last) = getShardLimits(first, last, kShardIndex, kNumberOfShards);
+    if (first > last)
+    {
+      ERROR(Form("The shard %d of %d is empty", kShardIndex, kNumberOfShards));
+      return std::make_tuple(false, -1, -1);
+    }
+  }
   assert(first >= 0);
   assert(last >= 0);
   assert(first <= last);
   return std::make_tuple(true, first, last);
 }
 
+std::pair<long long, long long> getShardLimits(long long first, long long last, int shardIndex, int numberOfShards)
+{
+  assert(numberOfShards > 0);
+  assert(shardIndex >= 0 && shardIndex < numberOfShards);
+  const auto kSize = last - first + 1;
+  return std::make_pair(first + kSize * shardIndex / numberOfShards, first + kSize * (shardIndex + 1) / numberOfShards - 1);
+}
+
+std::string addShardToFileName(const std::string& fileName, int shardIndex, int numberOfShards)
+{
+  auto path = JPetCommonTools::extractPathFromFile(fileName);
+  auto file = JPetCommonTools::extractFileNameFromFullPath(fileName);
+  auto pos = file.find(".");
+  file.insert(pos != std::string::npos ? pos : file.size(), Form("_shard%dof%d", shardIndex, numberOfShards));
+  return path.empty() ? file : path + "/" + file;
+}
+
 std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(const OptsStrAny& opts, bool prevResetOutputPath,
                                                                        const std::string& inFileType, const std::string& outFileType)
 {
@@ -105,20 +133,27 @@ std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(const Opt
     }
   }
   outFileFullPath = JPetCommonTools::replaceDataTypeInFileName(outFileFullPath, outFileType);
+  if (getNumberOfShards(opts) > 1)
+  {
+    outFileFullPath = addShardToFileName(outFileFullPath, getShardIndex(opts), getNumberOfShards(opts));
+  }
   return std::make_tuple(true, inputFilename, outFileFullPath, resetOutputPath);
 }
 
 OptsStrAny setOutputOptions(const JPetParams& oldParams, bool resetOutputPath, const std::string& fullOutPath)
 {
   OptsStrAny new_opts = oldParams.getOptions();
-  if (FileTypeChecker::getInputFileType(oldParams.getOptions()) == FileTypeChecker::kHldRoot ||
-      FileTypeChecker::getInputFileType(oldParams.getOptions()) == FileTypeChecker::kMCGeant)
+  const auto inputFileType = FileTypeChecker::getInputFileType(oldParams.getOptions());
+  if (inputFileType == FileTypeChecker::kHldRoot || inputFileType == FileTypeChecker::kMCGeant || inputFileType == FileTypeChecker::kHld ||
+      inputFileType == FileTypeChecker::kZip)
   {
     jpet_options_generator_tools::setOutputFileType(new_opts, "root");
   }
 
-  if (jpet_options_tools::getOptionAsInt(oldParams.getOptions(), "firstEvent_int") != -1 &&
-      jpet_options_tools::getOptionAsInt(oldParams.getOptions(), "lastEvent_int") != -1)
+  /// the output of the shard contains only its events, so the next task processes the whole file
+  if ((jpet_options_tools::getOptionAsInt(oldParams.getOptions(), "firstEvent_int") != -1 &&
+       jpet_options_tools::getOptionAsInt(oldParams.getOptions(), "lastEvent_int") != -1) ||
+      getNumberOfShards(oldParams.getOptions()) > 1)
   {
     jpet_options_generator_tools::setResetEventRangeOption(new_opts, true);
   }
@@ -17,6 +17,7 @@
 #include "JPetData/JPetData.h"
 #include "JPetLoggerInclude.h"
 #include "JPetParams/JPetParams.h"
+#include "JPetTaskIO/JPetTaskIO.h"
 
 JPetTaskLooper::JPetTaskLooper(const char* name, std::unique_ptr<JPetTask> subtask, Predicate isCondition) : JPetTask(name), fIsCondition(isCondition)
 {
@@ -47,8 +48,11 @@ bool JPetTaskLooper::run(const JPetDataInterface&)
   }
   JPetParams inParams = fParams;
   JPetParams outParams;
+  int iteration = 0;
   while (fIsCondition(inParams))
   {
+    inParams = getIterationParams(inParams, iteration);
+    iteration++;
     for (const auto& subTask : subTasks)
     {
       auto isOk = subTask->init(inParams);
@@ -77,6 +81,24 @@ bool JPetTaskLooper::terminate(JPetParams& paramsO)
 
 void JPetTaskLooper::setConditionFunction(Predicate isCondition) { fIsCondition = isCondition; }
 
+void JPetTaskLooper::setNumberOfIterations(int numberOfIterations) { fNumberOfIterations = numberOfIterations; }
+
+/**
+ * The output of the iterations other than the last one is overwritten by the next iteration,
+ * so if the input is cached, writing the events is skipped to avoid the disk operations.
+ */
+JPetParams JPetTaskLooper::getIterationParams(const JPetParams& params, int iteration) const
+{
+  static const JPetOptions::Key inputCacheKey(JPetTaskIO::kInputCacheKey);
+  if (fNumberOfIterations <= 0 || params.getSharedOptions()->get(inputCacheKey, 0) <= 0)
+  {
+    return params;
+  }
+  auto options = params.getOptions();
+  options[JPetTaskIO::kSkipOutputEventsKey] = iteration + 1 < fNumberOfIterations;
+  return JPetParams(options, params.getParamManagerAsShared());
+}
+
 Predicate JPetTaskLooper::getMaxIterationPredicate(int maxIteration)
 {
   assert(maxIteration >= 0);
@@ -97,10 +119,10 @@ Predicate JPetTaskLooper::getMaxIterationPredicate(int maxIteration)
 
 Predicate JPetTaskLooper::getStopOnOptionPredicate(const std::string stopIterationOptName)
 {
-  auto stopFunction = [stopIterationOptName](const JPetParams& params) -> bool {
-    using namespace jpet_options_tools;
-    auto options = params.getOptions();
-    bool continueIteration = isOptionSet(options, stopIterationOptName) && (!getOptionAsBool(options, stopIterationOptName));
+  JPetOptions::Key stopIterationKey(stopIterationOptName);
+  auto stopFunction = [stopIterationKey](const JPetParams& params) -> bool {
+    auto stopIteration = params.getSharedOptions()->getIf<bool>(stopIterationKey);
+    bool continueIteration = stopIteration && !*stopIteration;
     return continueIteration;
   };
   return stopFunction;
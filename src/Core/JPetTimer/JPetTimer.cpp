@@ -14,6 +14,7 @@
  */
 
 #include "JPetTimer/JPetTimer.h"
+#include <cstdio>
 
 /**
  * Constructor
@@ -25,12 +26,12 @@ JPetTimer::JPetTimer() {}
  */
 JPetTimer::~JPetTimer() {}
 
-void JPetTimer::startMeasurement() { fStartTime = std::chrono::system_clock::now(); }
+void JPetTimer::startMeasurement() { fStartTime = std::chrono::steady_clock::now(); }
 
 void JPetTimer::stopMeasurement(std::string measurementName)
 {
   fElapsedTimes.push_back(
-      make_pair(measurementName, std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - fStartTime)));
+      make_pair(measurementName, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - fStartTime)));
 }
 
 std::string JPetTimer::getAllMeasuredTimes()
@@ -38,24 +39,49 @@ std::string JPetTimer::getAllMeasuredTimes()
   std::string tmp;
   for (auto& el : fElapsedTimes)
   {
-    tmp += "Elapsed time for " + el.first + ":" + std::to_string(el.second.count()) + " [s]\n";
+    tmp += "Elapsed time for " + el.first + ":" + formatSeconds(el.second) + " [s]\n";
   }
   return tmp;
 }
 
 std::string JPetTimer::getTotalMeasuredTime()
 {
-  return std::string("Total elapsed time:") + std::to_string(getTotalMeasuredTimeInSeconds()) + " [s]\n";
+  return std::string("Total elapsed time:") + formatSeconds(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                   std::chrono::duration<double>(getTotalMeasuredTimeInPreciseSeconds()))) +
+         " [s]\n";
 }
 
-long int JPetTimer::getTotalMeasuredTimeInSeconds()
+long int JPetTimer::getTotalMeasuredTimeInSeconds() { return static_cast<long int>(getTotalMeasuredTimeInPreciseSeconds()); }
+
+double JPetTimer::getTotalMeasuredTimeInPreciseSeconds()
+{
+  auto total = std::accumulate(fElapsedTimes.begin(), fElapsedTimes.end(), std::chrono::nanoseconds(0),
+                               [](const std::chrono::nanoseconds prev, const std::pair<std::string, std::chrono::nanoseconds>& el) {
+                                 return prev + el.second;
+                               });
+  return std::chrono::duration<double>(total).count();
+}
+
+JPetTimer::vectorElapsedTimes JPetTimer::getVectorOfMeasuredTimes()
 {
-  auto total =
-      std::accumulate(fElapsedTimes.begin(), fElapsedTimes.end(), std::chrono::seconds(0),
-                      [](const std::chrono::seconds prev, const std::pair<std::string, std::chrono::seconds>& el) { return prev + el.second; });
-  return total.count();
+  vectorElapsedTimes times;
+  for (const auto& el : fElapsedTimes)
+  {
+    times.push_back(make_pair(el.first, std::chrono::duration_cast<std::chrono::seconds>(el.second)));
+  }
+  return times;
 }
 
-JPetTimer::vectorElapsedTimes JPetTimer::getVectorOfMeasuredTimes() { return fElapsedTimes; }
+JPetTimer::vectorPreciseElapsedTimes JPetTimer::getVectorOfPreciseMeasuredTimes() { return fElapsedTimes; }
 
 JPetTimer::startTimeType JPetTimer::getCurrentStartTime() { return fStartTime; }
+
+/**
+ * Time in seconds with the millisecond precision
+ */
+std::string JPetTimer::formatSeconds(std::chrono::nanoseconds time)
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3f", std::chrono::duration<double>(time).count());
+  return buffer;
+}
@@ -0,0 +1,208 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTracer.cpp
+ */
+
+#include "JPetTracer/JPetTracer.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+struct TraceEvent
+{
+  const char* category;
+  std::string name;
+  JPetTracer::Clock::time_point start;
+  JPetTracer::Clock::duration duration;
+};
+
+struct ThreadBuffer
+{
+  int threadId = 0;
+  std::string threadName;
+  std::vector<TraceEvent> events;
+  long long dropped = 0;
+};
+
+/// The buffers are never removed, so the thread-local pointers stay valid after stop().
+struct TraceRegistry
+{
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  JPetTracer::Clock::time_point origin = JPetTracer::Clock::now();
+};
+
+TraceRegistry& getRegistry()
+{
+  static TraceRegistry registry;
+  return registry;
+}
+
+ThreadBuffer& getThreadBuffer()
+{
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (!buffer)
+  {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+    buffer = registry.buffers.back().get();
+    buffer->threadId = registry.buffers.size();
+  }
+  return *buffer;
+}
+
+std::string escape(const std::string& text)
+{
+  std::string escaped;
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      escaped += '\\';
+      escaped += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      char code[8];
+      std::snprintf(code, sizeof(code), "\\u%04x", c);
+      escaped += code;
+    }
+    else
+    {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+}
+
+const std::size_t JPetTracer::kMaxEventsPerThread = 1 << 20;
+std::atomic<bool> JPetTracer::sIsEnabled(false);
+
+/**
+ * Clear the previously recorded events and start the recording.
+ */
+void JPetTracer::start()
+{
+  auto& registry = getRegistry();
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& buffer : registry.buffers)
+    {
+      buffer->events.clear();
+      buffer->dropped = 0;
+    }
+    registry.origin = Clock::now();
+  }
+  sIsEnabled.store(true);
+}
+
+/**
+ * Stop the recording and write the trace to the file.
+ *
+ * @return false if the file could not be written
+ */
+bool JPetTracer::stop(const std::string& fileName)
+{
+  sIsEnabled.store(false);
+  std::ofstream out(fileName);
+  out << toJSON();
+  return static_cast<bool>(out);
+}
+
+/**
+ * Name of the calling thread shown in the trace viewer.
+ */
+void JPetTracer::setThreadName(const std::string& name)
+{
+  auto& buffer = getThreadBuffer();
+  std::lock_guard<std::mutex> lock(getRegistry().mutex);
+  buffer.threadName = name;
+}
+
+void JPetTracer::record(const char* category, const std::string& name, Clock::time_point start, Clock::time_point end)
+{
+  if (!isEnabled())
+  {
+    return;
+  }
+  auto& buffer = getThreadBuffer();
+  if (buffer.events.size() >= kMaxEventsPerThread)
+  {
+    buffer.dropped++;
+    return;
+  }
+  buffer.events.push_back(TraceEvent{category, name, start, end - start});
+}
+
+/**
+ * Trace in the Chrome trace event format, with the spans stored as the complete ("X") events
+ * and the thread names as the metadata events. Times are in microseconds from start().
+ */
+std::string JPetTracer::toJSON()
+{
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::ostringstream out;
+  out.precision(3);
+  out << std::fixed;
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool isFirst = true;
+  for (const auto& buffer : registry.buffers)
+  {
+    std::string threadName = buffer->threadName.empty() ? "thread " + std::to_string(buffer->threadId) : buffer->threadName;
+    out << (isFirst ? "" : ",") << "\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->threadId
+        << ", \"args\": {\"name\": \"" << escape(threadName) << "\"}}";
+    isFirst = false;
+    for (const auto& event : buffer->events)
+    {
+      double timestamp = std::chrono::duration<double, std::micro>(event.start - registry.origin).count();
+      double duration = std::chrono::duration<double, std::micro>(event.duration).count();
+      out << ",\n{\"name\": \"" << escape(event.name) << "\", \"cat\": \"" << event.category << "\", \"ph\": \"X\", \"ts\": " << timestamp
+          << ", \"dur\": " << duration << ", \"pid\": 1, \"tid\": " << buffer->threadId << "}";
+    }
+  }
+  out << "\n]}\n";
+  return out.str();
+}
+
+long long JPetTracer::getNumberOfEvents()
+{
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  long long events = 0;
+  for (const auto& buffer : registry.buffers)
+  {
+    events += buffer->events.size();
+  }
+  return events;
+}
+
+long long JPetTracer::getNumberOfDroppedEvents()
+{
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  long long dropped = 0;
+  for (const auto& buffer : registry.buffers)
+  {
+    dropped += buffer->dropped;
+  }
+  return dropped;
+}
@@ -131,3 +131,8 @@ std::string JPetTreeHeader::getVariable(std::string name) const
   else
     return "";
 }
+
+/**
+ * @brief Removes a variable from the dictionary of the TreeHeader (see the setVariable method)
+ */
+void JPetTreeHeader::removeVariable(std::string name) { fDictionary.erase(name); }
@@ -29,7 +29,7 @@ bool JPetUserTask::run(const JPetDataInterface& inData)
   clearOutputEvents();
   try
   {
-    auto event = dynamic_cast<const JPetData&>(inData);
+    const auto& event = dynamic_cast<const JPetData&>(inData);
     setEvent(&(event.getEvent()));
   }
   catch (const std::bad_cast& ex)
@@ -66,12 +66,17 @@ void JPetUserTask::setEvent(TObject* ev) { fEvent = ev; }
 
 JPetTimeWindow* JPetUserTask::getInputEvents() { return dynamic_cast<JPetTimeWindow*>(fEvent); }
 
-jpet_options_tools::OptsStrAny JPetUserTask::getOptions() const { return fParams.getOptions(); }
+const jpet_options_tools::OptsStrAny& JPetUserTask::getOptions() const { return fParams.getOptions(); }
 
 JPetTimeWindow* JPetUserTask::getOutputEvents() { return fOutputEvents; }
 
+void JPetUserTask::setWindowFlags(ULong64_t flags) { fWindowFlags = flags; }
+
+ULong64_t JPetUserTask::getWindowFlags() const { return fWindowFlags; }
+
 void JPetUserTask::clearOutputEvents()
 {
+  fWindowFlags = 0;
   if (fOutputEvents)
   {
     fOutputEvents->Clear();
@@ -0,0 +1,176 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetRunTimeIndex.cpp
+ */
+
+#include "JPetWindowIndex/JPetRunTimeIndex.h"
+#include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetLoggerInclude.h"
+#include "JPetReader/JPetReader.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <algorithm>
+#include <cmath>
+
+JPetRunTimeIndex::JPetRunTimeIndex(double windowLength) : fWindowLength(windowLength)
+{
+  if (fWindowLength <= 0.0)
+  {
+    ERROR("The length of the time window must be positive, given: " + std::to_string(windowLength));
+  }
+}
+
+JPetRunTimeIndex::~JPetRunTimeIndex() {}
+
+/**
+ * Reads the window index of the file, which is placed after the files added before.
+ * @return false if the file cannot be opened or it has no window index
+ */
+bool JPetRunTimeIndex::addFile(const std::string& fileName)
+{
+  TFile file(fileName.c_str(), "READ");
+  if (!file.IsOpen() || file.IsZombie())
+  {
+    ERROR("Could not open the file: " + fileName);
+    return false;
+  }
+  File added;
+  added.fName = fileName;
+  auto tree = dynamic_cast<TTree*>(file.Get(JPetWindowIndex::kIndexTreeName.c_str()));
+  if (!tree || !added.fIndex.read(*tree))
+  {
+    ERROR("No window index in the file: " + fileName);
+    return false;
+  }
+  /// also the empty windows at the end of the file, which are not written, are counted
+  added.fNumberOfWindows = added.fIndex.getNumberOfWindows();
+  if (!fFiles.empty())
+  {
+    added.fFirstWindow = fFiles.back().fFirstWindow + fFiles.back().fNumberOfWindows;
+  }
+  fFiles.push_back(std::move(added));
+  return true;
+}
+
+std::size_t JPetRunTimeIndex::getNumberOfFiles() const { return fFiles.size(); }
+
+const std::string& JPetRunTimeIndex::getFileName(std::size_t fileIndex) const { return fFiles.at(fileIndex).fName; }
+
+double JPetRunTimeIndex::getWindowLength() const { return fWindowLength; }
+
+double JPetRunTimeIndex::getEndTime() const
+{
+  return fFiles.empty() ? 0.0 : (fFiles.back().fFirstWindow + fFiles.back().fNumberOfWindows) * fWindowLength;
+}
+
+double JPetRunTimeIndex::getStartTime(const Location& location) const { return location.fWindowNumber * fWindowLength; }
+
+/**
+ * Finds the window containing the given time or, if it was not written, e.g. since it was empty,
+ * the first written window after it.
+ * @return false if there is no such window in the run
+ */
+bool JPetRunTimeIndex::locate(double time, Location& location) const
+{
+  if (fFiles.empty() || fWindowLength <= 0.0 || !(time >= 0.0) || time >= getEndTime())
+  {
+    return false;
+  }
+  auto windowNumber = static_cast<ULong64_t>(std::floor(time / fWindowLength));
+  auto next = std::upper_bound(fFiles.begin(), fFiles.end(), windowNumber,
+                               [](ULong64_t number, const File& file) { return number < file.fFirstWindow; });
+  return findFrom(next - fFiles.begin() - 1, windowNumber, location);
+}
+
+/**
+ * Searches the files starting from the given one for the first entry with the window number not less than the given one.
+ */
+bool JPetRunTimeIndex::findFrom(std::size_t fileIndex, ULong64_t windowNumber, Location& location) const
+{
+  for (; fileIndex < fFiles.size(); fileIndex++)
+  {
+    const auto& file = fFiles[fileIndex];
+    auto entry = file.fIndex.findWindow(windowNumber > file.fFirstWindow ? windowNumber - file.fFirstWindow : 0);
+    if (entry >= 0)
+    {
+      location.fFileIndex = fileIndex;
+      location.fEntry = entry;
+      location.fWindowNumber = file.fFirstWindow + file.fIndex[entry].fWindowNumber;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @return the window containing the given time, see locate(), or nullptr if there is none.
+ * The window is owned by the reader and valid until the next fetch.
+ */
+TObject* JPetRunTimeIndex::fetch(double time)
+{
+  Location location;
+  if (!locate(time, location))
+  {
+    return nullptr;
+  }
+  return read(location);
+}
+
+/**
+ * @return the window following the last fetched one, also from the next file, or nullptr at the end of the run
+ */
+TObject* JPetRunTimeIndex::fetchNext()
+{
+  if (fLocation.fEntry < 0)
+  {
+    return nullptr;
+  }
+  Location location;
+  if (!findFrom(fLocation.fFileIndex, fLocation.fWindowNumber + 1, location))
+  {
+    return nullptr;
+  }
+  return read(location);
+}
+
+const JPetRunTimeIndex::Location& JPetRunTimeIndex::getLocation() const { return fLocation; }
+
+/**
+ * Opens the file of the location, unless it is already open, and reads the entry.
+ */
+TObject* JPetRunTimeIndex::read(const Location& location)
+{
+  if (!fIsFileOpened || fOpenedFile != location.fFileIndex)
+  {
+    if (!fReader)
+    {
+      fReader = jpet_common_tools::make_unique<JPetReader>();
+    }
+    fIsFileOpened = fReader->openFileAndLoadData(fFiles[location.fFileIndex].fName.c_str(), JPetReader::kRootTreeName.c_str());
+    fOpenedFile = location.fFileIndex;
+    if (!fIsFileOpened)
+    {
+      ERROR("Could not read the tree from the file: " + fFiles[location.fFileIndex].fName);
+      fLocation = Location();
+      return nullptr;
+    }
+  }
+  if (!fReader->nthEntry(location.fEntry))
+  {
+    ERROR("Could not read the entry " + std::to_string(location.fEntry) + " from the file: " + fFiles[location.fFileIndex].fName);
+    fLocation = Location();
+    return nullptr;
+  }
+  fLocation = location;
+  return &fReader->getCurrentEntry();
+}
@@ -0,0 +1,230 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWindowIndex.cpp
+ */
+
+#include "JPetWindowIndex/JPetWindowIndex.h"
+#include "JPetCompactHit/JPetCompactHit.h"
+#include "JPetEvent/JPetEvent.h"
+#include "JPetHit/JPetHit.h"
+#include "JPetPhysSignal/JPetPhysSignal.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include <TParameter.h>
+#include <TTree.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+const std::string JPetWindowIndex::kIndexTreeName = "WindowIndex";
+
+namespace
+{
+const char* const kNumberOfWindowsName = "numberOfWindows";
+}
+
+namespace
+{
+template <typename T, typename Getter>
+void fillTimes(const JPetTimeWindow& window, Getter getTime, JPetWindowIndex::Entry& entry)
+{
+  for (const auto& event : window.getEvents<T>())
+  {
+    getTime(event, entry);
+  }
+}
+
+void addTime(double time, JPetWindowIndex::Entry& entry)
+{
+  entry.fMinTime = std::min(entry.fMinTime, time);
+  entry.fMaxTime = std::max(entry.fMaxTime, time);
+}
+}
+
+/**
+ * The type of the events is checked once per window, the times are then read with the typed range.
+ */
+JPetWindowIndex::Entry JPetWindowIndex::createEntry(const JPetTimeWindow& window, ULong64_t flags, ULong64_t windowNumber)
+{
+  Entry entry;
+  entry.fNumberOfEvents = window.getNumberOfEvents();
+  entry.fFlags = flags;
+  entry.fWindowNumber = windowNumber;
+  entry.fMinTime = std::numeric_limits<double>::infinity();
+  entry.fMaxTime = -std::numeric_limits<double>::infinity();
+  auto eventClass = window.getEventClass();
+  if (entry.fNumberOfEvents == 0 || !eventClass)
+  {
+    entry.fMinTime = entry.fMaxTime = std::numeric_limits<double>::quiet_NaN();
+  }
+  else if (eventClass->InheritsFrom(JPetHit::Class()))
+  {
+    fillTimes<JPetHit>(window, [](const JPetHit& hit, Entry& e) { addTime(hit.getTime(), e); }, entry);
+  }
+  else if (eventClass->InheritsFrom(JPetCompactHit::Class()))
+  {
+    fillTimes<JPetCompactHit>(window, [](const JPetCompactHit& hit, Entry& e) { addTime(hit.getTime(), e); }, entry);
+  }
+  else if (eventClass->InheritsFrom(JPetEvent::Class()))
+  {
+    fillTimes<JPetEvent>(window,
+                         [](const JPetEvent& event, Entry& e) {
+                           for (const auto& hit : event.getHits())
+                           {
+                             addTime(hit.getTime(), e);
+                           }
+                         },
+                         entry);
+  }
+  else if (eventClass->InheritsFrom(JPetPhysSignal::Class()))
+  {
+    fillTimes<JPetPhysSignal>(window, [](const JPetPhysSignal& signal, Entry& e) { addTime(signal.getTime(), e); }, entry);
+  }
+  else if (eventClass->InheritsFrom(JPetSigCh::Class()))
+  {
+    fillTimes<JPetSigCh>(window, [](const JPetSigCh& sigCh, Entry& e) { addTime(sigCh.getValue(), e); }, entry);
+  }
+  if (entry.fMinTime > entry.fMaxTime)
+  {
+    entry.fMinTime = entry.fMaxTime = std::numeric_limits<double>::quiet_NaN();
+  }
+  return entry;
+}
+
+/**
+ * Creates the index tree in the current directory, with the branches filled from the buffer.
+ */
+TTree* JPetWindowIndex::createTree(Entry& buffer)
+{
+  auto tree = new TTree(kIndexTreeName.c_str(), kIndexTreeName.c_str());
+  tree->Branch("numberOfEvents", &buffer.fNumberOfEvents, "numberOfEvents/i");
+  tree->Branch("minTime", &buffer.fMinTime, "minTime/D");
+  tree->Branch("maxTime", &buffer.fMaxTime, "maxTime/D");
+  tree->Branch("flags", &buffer.fFlags, "flags/l");
+  tree->Branch("windowNumber", &buffer.fWindowNumber, "windowNumber/l");
+  return tree;
+}
+
+/**
+ * Stores the total number of the windows of the original data in the user info of the index tree.
+ */
+void JPetWindowIndex::setNumberOfWindows(TTree& tree, ULong64_t numberOfWindows)
+{
+  auto userInfo = tree.GetUserInfo();
+  if (auto previous = userInfo->FindObject(kNumberOfWindowsName))
+  {
+    userInfo->Remove(previous);
+    delete previous;
+  }
+  userInfo->Add(new TParameter<Long64_t>(kNumberOfWindowsName, numberOfWindows));
+}
+
+JPetWindowIndex::Predicate JPetWindowIndex::minNumberOfEvents(unsigned int numberOfEvents)
+{
+  return [numberOfEvents](const Entry& entry) { return entry.fNumberOfEvents >= numberOfEvents; };
+}
+
+/**
+ * Windows overlapping with [minTime, maxTime] and the windows with unknown time match.
+ */
+JPetWindowIndex::Predicate JPetWindowIndex::timeRange(double minTime, double maxTime)
+{
+  return [minTime, maxTime](const Entry& entry) {
+    if (std::isnan(entry.fMinTime))
+    {
+      return true;
+    }
+    return entry.fMaxTime >= minTime && entry.fMinTime <= maxTime;
+  };
+}
+
+JPetWindowIndex::Predicate JPetWindowIndex::allFlags(ULong64_t flags)
+{
+  return [flags](const Entry& entry) { return (entry.fFlags & flags) == flags; };
+}
+
+JPetWindowIndex::Predicate JPetWindowIndex::allOf(const std::vector<Predicate>& predicates)
+{
+  return [predicates](const Entry& entry) {
+    return std::all_of(predicates.begin(), predicates.end(), [&entry](const Predicate& predicate) { return predicate(entry); });
+  };
+}
+
+/**
+ * Loads all entries of the index tree in memory.
+ */
+bool JPetWindowIndex::read(TTree& tree)
+{
+  clear();
+  Entry buffer;
+  if (tree.SetBranchAddress("numberOfEvents", &buffer.fNumberOfEvents) < 0 || tree.SetBranchAddress("minTime", &buffer.fMinTime) < 0 ||
+      tree.SetBranchAddress("maxTime", &buffer.fMaxTime) < 0 || tree.SetBranchAddress("flags", &buffer.fFlags) < 0 ||
+      tree.SetBranchAddress("windowNumber", &buffer.fWindowNumber) < 0)
+  {
+    tree.ResetBranchAddresses();
+    return false;
+  }
+  auto numberOfEntries = tree.GetEntries();
+  fEntries.reserve(numberOfEntries);
+  for (long long i = 0; i < numberOfEntries; i++)
+  {
+    if (tree.GetEntry(i) <= 0)
+    {
+      tree.ResetBranchAddresses();
+      clear();
+      return false;
+    }
+    fEntries.push_back(buffer);
+  }
+  tree.ResetBranchAddresses();
+  fNumberOfWindows = fEntries.empty() ? 0 : fEntries.back().fWindowNumber + 1;
+  if (auto numberOfWindows = dynamic_cast<TParameter<Long64_t>*>(tree.GetUserInfo()->FindObject(kNumberOfWindowsName)))
+  {
+    fNumberOfWindows = std::max<ULong64_t>(fNumberOfWindows, numberOfWindows->GetVal());
+  }
+  return true;
+}
+
+void JPetWindowIndex::clear()
+{
+  fEntries.clear();
+  fNumberOfWindows = 0;
+}
+
+/**
+ * @return the number of the first entry in [first, last] matching the predicate, or -1 if there is none
+ */
+long long JPetWindowIndex::findNext(long long first, long long last, const Predicate& predicate) const
+{
+  last = std::min(last, size() - 1);
+  for (auto entry = std::max(first, 0ll); entry <= last; entry++)
+  {
+    if (predicate(fEntries[entry]))
+    {
+      return entry;
+    }
+  }
+  return -1;
+}
+
+/**
+ * The window numbers grow with the entries, since the windows are written in the order of the data.
+ * @return the number of the entry with the given window or, if the window was not written,
+ * of the first entry after it, -1 if there is none
+ */
+long long JPetWindowIndex::findWindow(ULong64_t windowNumber) const
+{
+  auto found = std::lower_bound(fEntries.begin(), fEntries.end(), windowNumber,
+                                [](const Entry& entry, ULong64_t number) { return entry.fWindowNumber < number; });
+  return found == fEntries.end() ? -1 : found - fEntries.begin();
+}
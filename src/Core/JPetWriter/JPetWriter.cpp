@@ -41,27 +41,63 @@ JPetWriter::~JPetWriter()
   DEBUG("destructor of JPetWriter");
   if (isOpen())
   {
-    fTree->AutoSave("SaveSelf");
+    saveTrees();
     if (fFile)
     {
       delete fFile;
       fFile = 0;
     }
     fTree = 0;
+    fIndexTree = nullptr;
   }
   DEBUG("exiting destructor of JPetWriter");
 }
 
 void JPetWriter::closeFile()
 {
+  JPetTracer::Scope scope("io", "JPetWriter::closeFile");
   if (isOpen())
   {
-    fTree->AutoSave("SaveSelf");
+    saveTrees();
     delete fFile;
     fFile = 0;
+    fIndexTree = nullptr;
   }
   fFileName.clear();
   fIsBranchCreated = false;
+  fIndexWindowNumber = 0;
+  fIndexNumberOfWindows = 0;
+}
+
+/**
+ * Fills the entry of the window index corresponding to the just filled entry of the tree.
+ * The index tree is created with the first time window, so the files with other objects do not contain it.
+ */
+void JPetWriter::fillIndex(const JPetTimeWindow& window)
+{
+  if (!fIndexTree)
+  {
+    if (fTree->GetEntries() != 1)
+    {
+      return;
+    }
+    fIndexTree = JPetWindowIndex::createTree(fIndexEntry);
+    fIndexTree->SetAutoSave(JPetWriter::kTreeBufferSize);
+  }
+  fIndexEntry = JPetWindowIndex::createEntry(window, fIndexFlags, fIndexWindowNumber);
+  fIndexTree->Fill();
+  fIndexFlags = 0;
+  fIndexWindowNumber++;
+}
+
+void JPetWriter::saveTrees()
+{
+  fTree->AutoSave("SaveSelf");
+  if (fIndexTree)
+  {
+    JPetWindowIndex::setNumberOfWindows(*fIndexTree, fIndexNumberOfWindows);
+    fIndexTree->AutoSave("SaveSelf");
+  }
 }
 
 void JPetWriter::writeHeader(TObject* header)
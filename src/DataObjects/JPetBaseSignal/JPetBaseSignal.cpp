@@ -48,4 +48,6 @@ void JPetBaseSignal::Clear(Option_t*)
 {
   fBarrelSlot = NULL;
   fPM = NULL;
+  fFlag = JPetBaseSignal::Unknown;
+  fIsNullObject = false;
 }
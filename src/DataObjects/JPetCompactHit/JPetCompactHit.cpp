@@ -0,0 +1,72 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetCompactHit.cpp
+ */
+
+#include "JPetCompactHit/JPetCompactHit.h"
+
+ClassImp(JPetCompactHit);
+
+JPetCompactHit::JPetCompactHit() : TObject() {}
+
+/**
+ * Constructor copying the reconstructed properties of the hit,
+ * the signals are referenced by the given indices in JPetCompactHitWindow.
+ */
+JPetCompactHit::JPetCompactHit(const JPetHit& hit, int signalAIndex, int signalBIndex)
+    : TObject(), fFlag(hit.getRecoFlag()), fEnergy(hit.getEnergy()), fQualityOfEnergy(hit.getQualityOfEnergy()), fTime(hit.getTime()),
+      fQualityOfTime(hit.getQualityOfTime()), fTimeDiff(hit.getTimeDiff()), fQualityOfTimeDiff(hit.getQualityOfTimeDiff()),
+      fPosX(hit.getPosX()), fPosY(hit.getPosY()), fPosZ(hit.getPosZ()), fScintillatorID(hit.getScintillator().getID()),
+      fBarrelSlotID(hit.getBarrelSlot().getID()), fMCindex(hit.getMCindex()), fSignalAIndex(signalAIndex), fSignalBIndex(signalBIndex)
+{
+}
+
+JPetCompactHit::~JPetCompactHit() {}
+
+/**
+ * Set the position of the hit in [cm]
+ */
+void JPetCompactHit::setPos(float x, float y, float z)
+{
+  fPosX = x;
+  fPosY = y;
+  fPosZ = z;
+}
+
+/**
+ * Set the indices of the signals in the side array of JPetCompactHitWindow, kNoSignal if not stored.
+ */
+void JPetCompactHit::setSignalIndices(int signalAIndex, int signalBIndex)
+{
+  fSignalAIndex = signalAIndex;
+  fSignalBIndex = signalBIndex;
+}
+
+/**
+ * Set values of the hit to zero/unknown and remove the signal indices
+ */
+void JPetCompactHit::Clear(Option_t*)
+{
+  fFlag = JPetHit::Unknown;
+  fEnergy = 0.0f;
+  fQualityOfEnergy = 0.0f;
+  fTime = 0.0f;
+  fQualityOfTime = 0.0f;
+  fTimeDiff = 0.0f;
+  fQualityOfTimeDiff = 0.0f;
+  setPos(0.0f, 0.0f, 0.0f);
+  fScintillatorID = -1;
+  fBarrelSlotID = -1;
+  fMCindex = JPetHit::kMCindexError;
+  setSignalIndices(kNoSignal, kNoSignal);
+}
@@ -0,0 +1,40 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetCompactHitWindow.cpp
+ */
+
+#include "JPetCompactHit/JPetCompactHitWindow.h"
+#include "JPetLoggerInclude.h"
+
+ClassImp(JPetCompactHitWindow);
+
+/**
+ * Get the signal from side A of the hit, a null signal is returned if it was not stored.
+ */
+const JPetPhysSignal& JPetCompactHitWindow::getSignalA(const JPetCompactHit& hit) const { return getSignalOrNull(hit.getSignalAIndex()); }
+
+/**
+ * Get the signal from side B of the hit, a null signal is returned if it was not stored.
+ */
+const JPetPhysSignal& JPetCompactHitWindow::getSignalB(const JPetCompactHit& hit) const { return getSignalOrNull(hit.getSignalBIndex()); }
+
+const JPetPhysSignal& JPetCompactHitWindow::getSignalOrNull(int i) const
+{
+  if (i >= 0 && static_cast<unsigned int>(i) < fSignalCount)
+  {
+    return getSignal(i);
+  }
+  ERROR("No signal stored for the hit, Null object will be returned");
+  static JPetPhysSignal dummyResult(true);
+  return dummyResult;
+}
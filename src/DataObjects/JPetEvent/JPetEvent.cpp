@@ -14,7 +14,7 @@
  */
 
 #include "JPetEvent/JPetEvent.h"
-#include "JPetAnalysisTools/JPetAnalysisTools.h"
+#include <algorithm>
 
 ClassImp(JPetEvent);
 
@@ -25,6 +25,44 @@ JPetEvent::JPetEvent(const std::vector<JPetHit>& hits, JPetEventType eventType,
   setHits(hits, orderedByTime);
 }
 
+/**
+ * Copy constructor, the pool of the recycled hits is not copied.
+ */
+JPetEvent::JPetEvent(const JPetEvent& event) : TObject(event), fHits(event.fHits), fType(event.fType), fFlag(event.fFlag) {}
+
+/**
+ * Assignment reuses the hits of this event (and their signals) instead of
+ * allocating new ones, e.g. when the event is stored in a time window slot.
+ */
+JPetEvent& JPetEvent::operator=(const JPetEvent& event)
+{
+  if (this != &event)
+  {
+    TObject::operator=(event);
+    fType = event.fType;
+    fFlag = event.fFlag;
+    setHits(event.fHits, false);
+  }
+  return *this;
+}
+
+/**
+ * Move assignment takes the hits of the other event and keeps the pool
+ * of this one, to which the previous hits of this event are added.
+ */
+JPetEvent& JPetEvent::operator=(JPetEvent&& event)
+{
+  if (this != &event)
+  {
+    TObject::operator=(event);
+    fType = event.fType;
+    fFlag = event.fFlag;
+    recycleHits();
+    fHits.swap(event.fHits);
+  }
+  return *this;
+}
+
 void JPetEvent::setRecoFlag(JPetEvent::RecoFlag flag) { fFlag = flag; }
 
 JPetEvent::RecoFlag JPetEvent::getRecoFlag() const { return fFlag; }
@@ -35,20 +73,36 @@ JPetEvent::RecoFlag JPetEvent::getRecoFlag() const { return fFlag; }
  */
 void JPetEvent::setHits(const std::vector<JPetHit>& hits, bool orderedByTime)
 {
-  if (orderedByTime)
+  if (&hits != &fHits)
   {
-    fHits = JPetAnalysisTools::getHitsOrderedByTime(hits);
+    recycleHits();
+    fHits.reserve(hits.size());
+    for (const auto& hit : hits)
+    {
+      addHit(hit);
+    }
   }
-  else
+  if (orderedByTime)
   {
-    fHits = hits;
+    std::sort(fHits.begin(), fHits.end(), [](const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); });
   }
 }
 
 /**
  * Adding hit to the event, this method does not sort nor order added hits by time.
+ * A hit recycled by Clear is overwritten if available, so its signals keep their storage.
  */
-void JPetEvent::addHit(const JPetHit& hit) { fHits.push_back(hit); }
+void JPetEvent::addHit(const JPetHit& hit)
+{
+  if (fRecycledHits.empty())
+  {
+    fHits.push_back(hit);
+    return;
+  }
+  fRecycledHits.back() = hit;
+  fHits.push_back(std::move(fRecycledHits.back()));
+  fRecycledHits.pop_back();
+}
 
 /**
  * Get vector of hits from this event.
@@ -98,5 +152,17 @@ void JPetEvent::addEventType(JPetEventType type)
 void JPetEvent::Clear(Option_t*)
 {
   fType = kUnknown;
+  recycleHits();
+}
+
+/**
+ * Moves the hits of the event to the pool of the recycled hits.
+ */
+void JPetEvent::recycleHits()
+{
+  for (auto& hit : fHits)
+  {
+    fRecycledHits.push_back(std::move(hit));
+  }
   fHits.clear();
 }
@@ -351,8 +351,8 @@ void JPetHit::Clear(Option_t*)
   fTimeDiff = 0.0f;
   fQualityOfTimeDiff = 0.0f;
   fPos = TVector3();
-  fSignalA = JPetPhysSignal();
-  fSignalB = JPetPhysSignal();
+  fSignalA.Clear();
+  fSignalB.Clear();
   fIsSignalAset = false;
   fIsSignalBset = false;
   fBarrelSlot = NULL;
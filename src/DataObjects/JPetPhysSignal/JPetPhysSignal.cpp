@@ -52,9 +52,11 @@ void JPetPhysSignal::setRecoSignal(const JPetRecoSignal& recoSignal)
  */
 void JPetPhysSignal::Clear(Option_t*)
 {
+  JPetBaseSignal::Clear();
   fTime = 0.;
   fQualityOfTime = 0.;
   fPhe = 0.;
   fQualityOfPhe = 0.;
-  fRecoSignal = JPetRecoSignal();
+  fRecoSignal.Clear();
+  fIsNullObject = false;
 }
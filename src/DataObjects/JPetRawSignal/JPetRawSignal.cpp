@@ -187,6 +187,7 @@ std::map<int, double> JPetRawSignal::getTOTsVsThresholdValue() const
 
 void JPetRawSignal::Clear(Option_t*)
 {
+  JPetBaseSignal::Clear();
   fLeadingPoints.clear();
   fTrailingPoints.clear();
 }
@@ -90,11 +90,12 @@ void JPetRecoSignal::setRawSignal(const JPetRawSignal& rawSignal)
  */
 void JPetRecoSignal::Clear(Option_t*)
 {
+  JPetBaseSignal::Clear();
   fShape.clear();
   fDelay = 0.;
   fAmplitude = 0.;
   fOffset = 0.;
   fCharge = 0.;
-  fRawSignal = JPetRawSignal();
+  fRawSignal.Clear();
   fRecoTimesAtThreshold.clear();
 }
@@ -0,0 +1,256 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWaveformBatch.cpp
+ */
+
+#include "JPetWaveformBatch/JPetWaveformBatch.h"
+
+#include <algorithm>
+#include <limits>
+
+const float JPetWaveformBatch::Unset = -std::numeric_limits<float>::infinity();
+const std::size_t JPetWaveformBatch::kLaneWidth;
+
+void JPetWaveformBatch::clear()
+{
+  fTimes.clear();
+  fAmplitudes.clear();
+  fOffsets.assign(1, 0);
+}
+
+void JPetWaveformBatch::reserve(std::size_t nSignals, std::size_t nPointsPerSignal)
+{
+  fTimes.reserve(nSignals * nPointsPerSignal);
+  fAmplitudes.reserve(nSignals * nPointsPerSignal);
+  fOffsets.reserve(nSignals + 1);
+}
+
+/**
+ * Copy the shape of the signal to the batch.
+ *
+ * @return index of the signal in the batch
+ */
+std::size_t JPetWaveformBatch::addSignal(const JPetRecoSignal& signal)
+{
+  const auto& shape = signal.getShape();
+  for (const auto& point : shape)
+  {
+    fTimes.push_back(static_cast<float>(point.time));
+    fAmplitudes.push_back(static_cast<float>(point.amplitude));
+  }
+  fOffsets.push_back(fTimes.size());
+  return getNumberOfSignals() - 1;
+}
+
+/**
+ * Copy the shapes of all JPetRecoSignal objects stored in the time window.
+ */
+void JPetWaveformBatch::addSignals(const JPetTimeWindow& window)
+{
+  const auto nEvents = window.getNumberOfEvents();
+  for (std::size_t i = 0; i < nEvents; i++)
+  {
+    addSignal(window.getEvent<JPetRecoSignal>(i));
+  }
+}
+
+/**
+ * Baseline of every signal, as the mean of its first nBaselinePoints samples.
+ */
+void JPetWaveformBatch::calculateBaselines(std::size_t nBaselinePoints, std::vector<float>& baselines) const
+{
+  const auto nSignals = getNumberOfSignals();
+  baselines.resize(nSignals);
+  for (std::size_t i = 0; i < nSignals; i++)
+  {
+    baselines[i] = mean(getAmplitudes(i), std::min(nBaselinePoints, getNumberOfPoints(i)));
+  }
+}
+
+/**
+ * Amplitude of every signal, as the largest depth below its baseline.
+ */
+void JPetWaveformBatch::calculateAmplitudes(const std::vector<float>& baselines, std::vector<float>& amplitudes) const
+{
+  const auto nSignals = getNumberOfSignals();
+  amplitudes.resize(nSignals);
+  for (std::size_t i = 0; i < nSignals; i++)
+  {
+    amplitudes[i] = maxDepth(getAmplitudes(i), getNumberOfPoints(i), baselines[i]);
+  }
+}
+
+/**
+ * Charge of every signal, as the trapezoidal integral of its depth below the baseline,
+ * in [mV*ps].
+ */
+void JPetWaveformBatch::calculateCharges(const std::vector<float>& baselines, std::vector<float>& charges) const
+{
+  const auto nSignals = getNumberOfSignals();
+  charges.resize(nSignals);
+  for (std::size_t i = 0; i < nSignals; i++)
+  {
+    charges[i] = integrateDepth(getTimes(i), getAmplitudes(i), getNumberOfPoints(i), baselines[i]);
+  }
+}
+
+/**
+ * Time at which every signal first crosses the given threshold [mV] below its baseline.
+ */
+void JPetWaveformBatch::calculateThresholdTimes(const std::vector<float>& baselines, float threshold, std::vector<float>& times) const
+{
+  const auto nSignals = getNumberOfSignals();
+  times.resize(nSignals);
+  for (std::size_t i = 0; i < nSignals; i++)
+  {
+    times[i] = crossingTime(getTimes(i), getAmplitudes(i), getNumberOfPoints(i), baselines[i] - threshold);
+  }
+}
+
+/**
+ * Time at which every signal first reaches the given fraction of its amplitude.
+ */
+void JPetWaveformBatch::calculateConstantFractionTimes(const std::vector<float>& baselines, const std::vector<float>& amplitudes,
+                                                       float fraction, std::vector<float>& times) const
+{
+  const auto nSignals = getNumberOfSignals();
+  times.resize(nSignals);
+  for (std::size_t i = 0; i < nSignals; i++)
+  {
+    if (amplitudes[i] <= 0.0f)
+    {
+      times[i] = Unset;
+      continue;
+    }
+    times[i] = crossingTime(getTimes(i), getAmplitudes(i), getNumberOfPoints(i), baselines[i] - fraction * amplitudes[i]);
+  }
+}
+
+float JPetWaveformBatch::mean(const float* values, std::size_t size)
+{
+  if (size == 0)
+  {
+    return 0.0f;
+  }
+  float lanes[kLaneWidth] = {0.0f};
+  std::size_t i = 0;
+  for (; i + kLaneWidth <= size; i += kLaneWidth)
+  {
+    for (std::size_t l = 0; l < kLaneWidth; l++)
+    {
+      lanes[l] += values[i + l];
+    }
+  }
+  float sum = 0.0f;
+  for (std::size_t l = 0; l < kLaneWidth; l++)
+  {
+    sum += lanes[l];
+  }
+  for (; i < size; i++)
+  {
+    sum += values[i];
+  }
+  return sum / size;
+}
+
+float JPetWaveformBatch::maxDepth(const float* amplitudes, std::size_t size, float baseline)
+{
+  if (size == 0)
+  {
+    return 0.0f;
+  }
+  float lanes[kLaneWidth];
+  std::fill(lanes, lanes + kLaneWidth, amplitudes[0]);
+  std::size_t i = 0;
+  for (; i + kLaneWidth <= size; i += kLaneWidth)
+  {
+    for (std::size_t l = 0; l < kLaneWidth; l++)
+    {
+      lanes[l] = std::min(lanes[l], amplitudes[i + l]);
+    }
+  }
+  float minimum = *std::min_element(lanes, lanes + kLaneWidth);
+  for (; i < size; i++)
+  {
+    minimum = std::min(minimum, amplitudes[i]);
+  }
+  return baseline - minimum;
+}
+
+float JPetWaveformBatch::integrateDepth(const float* times, const float* amplitudes, std::size_t size, float baseline)
+{
+  if (size < 2)
+  {
+    return 0.0f;
+  }
+  const std::size_t nIntervals = size - 1;
+  float lanes[kLaneWidth] = {0.0f};
+  std::size_t i = 0;
+  for (; i + kLaneWidth <= nIntervals; i += kLaneWidth)
+  {
+    for (std::size_t l = 0; l < kLaneWidth; l++)
+    {
+      const std::size_t k = i + l;
+      lanes[l] += (times[k + 1] - times[k]) * (2.0f * baseline - amplitudes[k] - amplitudes[k + 1]);
+    }
+  }
+  float sum = 0.0f;
+  for (std::size_t l = 0; l < kLaneWidth; l++)
+  {
+    sum += lanes[l];
+  }
+  for (; i < nIntervals; i++)
+  {
+    sum += (times[i + 1] - times[i]) * (2.0f * baseline - amplitudes[i] - amplitudes[i + 1]);
+  }
+  return 0.5f * sum;
+}
+
+/**
+ * Time of the first sample at or below the given level, linearly interpolated
+ * with the preceding sample. The search tests a whole lane of samples at once
+ * and only resolves the exact sample in the lane that contains the crossing.
+ */
+float JPetWaveformBatch::crossingTime(const float* times, const float* amplitudes, std::size_t size, float level)
+{
+  std::size_t i = 0;
+  for (; i + kLaneWidth <= size; i += kLaneWidth)
+  {
+    int below = 0;
+    for (std::size_t l = 0; l < kLaneWidth; l++)
+    {
+      below |= amplitudes[i + l] <= level;
+    }
+    if (below)
+    {
+      break;
+    }
+  }
+  for (; i < size; i++)
+  {
+    if (amplitudes[i] <= level)
+    {
+      if (i == 0)
+      {
+        return times[0];
+      }
+      const float da = amplitudes[i] - amplitudes[i - 1];
+      if (da == 0.0f)
+      {
+        return times[i];
+      }
+      return times[i - 1] + (level - amplitudes[i - 1]) * (times[i] - times[i - 1]) / da;
+    }
+  }
+  return Unset;
+}
@@ -39,7 +39,7 @@ bool JPetGeantParser::init()
   std::unique_ptr<JPetGeomMapping> fDetectorMap(new JPetGeomMapping(getParamBank()));
 
   fOutputEvents = new JPetTimeWindowMC("JPetHit", "JPetMCHit", "JPetMCDecayTree");
-  auto opts = getOptions();
+  const auto& opts = getOptions();
 
   if (isOptionSet(fParams.getOptions(), kMaxTimeWindowParamKey))
   {
@@ -172,7 +172,7 @@ void JPetGeantParser::processMCEvent(JPetGeantEventPack* evPack)
       if (fMakeHisto)
         fillHistoMCRec(recHit);
     }
-    fStoredMCHits.push_back(mcHit);
+    fStoredMCHits.push_back(std::move(mcHit));
 
   }
 
@@ -235,7 +235,7 @@ void JPetGeantParser::processMCEvent(JPetGeantEventPack* evPack)
 void JPetGeantParser::saveReconstructedHit(JPetHit recHit)
 {
   recHit.setMCindex(fStoredMCHits.size());
-  fStoredHits.push_back(recHit);
+  fStoredHits.push_back(std::move(recHit));
 }
 
 void JPetGeantParser::fillHistoGenInfo(JPetGeantEventInformation* evInfo)
@@ -277,16 +277,8 @@ void JPetGeantParser::fillHistoGenInfo(JPetGeantEventInformation* evInfo)
 
 void JPetGeantParser::saveHits()
 {
-
-  for (const auto& hit : fStoredHits)
-  {
-    fOutputEvents->add<JPetHit>(hit);
-  }
-
-  for (const auto& mcHit : fStoredMCHits)
-  {
-    dynamic_cast<JPetTimeWindowMC*>(fOutputEvents)->addMCHit<JPetMCHit>(mcHit);
-  }
+  fOutputEvents->addAll<JPetHit>(std::move(fStoredHits));
+  dynamic_cast<JPetTimeWindowMC*>(fOutputEvents)->addMCHits<JPetMCHit>(std::move(fStoredMCHits));
 
   if (fMakeHisto)
   {
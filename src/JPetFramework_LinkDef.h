@@ -35,6 +35,8 @@
 #pragma link C++ class JPetSigCh + ;
 #pragma link C++ class JPetTreeHeader + ;
 #pragma link C++ class JPetHit + ;
+#pragma link C++ class JPetCompactHit + ;
+#pragma link C++ class JPetCompactHitWindow + ;
 #pragma link C++ class JPetTimeWindowMC + ;
 #pragma link C++ class JPetFrame + ;
 #pragma link C++ class JPetPM + ;
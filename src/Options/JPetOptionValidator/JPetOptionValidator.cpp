@@ -69,6 +69,7 @@ std::map<std::string, std::vector<bool (*)(std::pair<std::string, boost::any>)>>
   std::map<std::string, std::vector<bool (*)(std::pair<std::string, boost::any>)>> validationMap;
   validationMap["range_std::vector<int>"].push_back(&isNumberBoundsInRangeValid);
   validationMap["range_std::vector<int>"].push_back(&isRangeOfEventsValid);
+  validationMap["shard_std::vector<int>"].push_back(&isShardValid);
   validationMap["type_std::string"].push_back(&isCorrectFileType);
   validationMap["file_std::vector<std::string>"].push_back(&areFilesValid);
   validationMap["type_std::string, file_std::vector<std::string>"].push_back(&isFileTypeMatchingExtensions);
@@ -103,6 +104,22 @@ bool JPetOptionValidator::isRangeOfEventsValid(std::pair<std::string, boost::any
   return true;
 }
 
+bool JPetOptionValidator::isShardValid(std::pair<std::string, boost::any> option)
+{
+  auto shard = any_cast<std::vector<int>>(option.second);
+  if (shard.size() != 2)
+  {
+    ERROR("Wrong number of values in shard: " + std::to_string(shard.size()) + ", the shard index and the number of shards are expected");
+    return false;
+  }
+  if (shard[1] < 1 || shard[0] < 0 || shard[0] >= shard[1])
+  {
+    ERROR("Wrong shard: " + std::to_string(shard[0]) + " of " + std::to_string(shard[1]));
+    return false;
+  }
+  return true;
+}
+
 bool JPetOptionValidator::isCorrectFileType(std::pair<std::string, boost::any> option)
 {
   std::string type = any_cast<std::string>(option.second);
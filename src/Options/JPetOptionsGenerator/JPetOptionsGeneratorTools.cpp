@@ -38,6 +38,7 @@ std::map<std::string, std::string> kOptCmdLineNameToExtendedName = {{"type", "ty
                                                                     {"file", "file_std::vector<std::string>"},
                                                                     {"outputPath", "outputPath_std::string"},
                                                                     {"range", "range_std::vector<int>"},
+                                                                    {"shard", "shard_std::vector<int>"},
                                                                     {"unpackerConfigFile", "unpackerConfigFile_std::string"},
                                                                     {"unpackerCalibFile", "unpackerCalibFile_std::string"},
                                                                     {"runId", "runId_int"},
@@ -69,7 +70,7 @@ std::map<std::string, boost::any> transformOptions(const TransformersMap& transf
  * If no special options are present in the control settings, the inOptions
  * are just passed further. Currenty if controlSettings contain option:
  * 1. "resetEventRange_bool"->true then, the generated inOptions will contain
- * the first and the last event values set to -1, which means
+ * the first and the last event values set to -1 and no shard, which means
  * 'process all available events'.
  * 2. option 'outputFileType_std::string'->value set, then the generated
  * inOptions will contain inputFileType_str::string set to value
@@ -132,6 +133,8 @@ std::map<std::string, std::vector<Transformer>> generateTransformationMap(OptsSt
   transformationMap["outputPath_std::string"].push_back(appendSlash);
   transformationMap["range_std::vector<int>"].push_back(generateLowerEventBound);
   transformationMap["range_std::vector<int>"].push_back(generateHigherEventBound);
+  transformationMap["shard_std::vector<int>"].push_back(generateShardIndex);
+  transformationMap["shard_std::vector<int>"].push_back(generateNumberOfShards);
   addTransformFunction(transformationMap, "type_std::string", jpet_options_tools::generateSetFileTypeTransformator(options));
   return transformationMap;
 }
@@ -141,6 +144,9 @@ OptsStrAny resetEventRange(const OptsStrAny& srcOpts)
   OptsStrAny opts(srcOpts);
   opts.at("firstEvent_int") = -1;
   opts.at("lastEvent_int") = -1;
+  /// the shard is selected only from the input of the first task
+  opts.erase("shardIndex_int");
+  opts.erase("numberOfShards_int");
   return opts;
 }
 
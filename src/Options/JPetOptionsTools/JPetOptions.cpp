@@ -0,0 +1,62 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetOptions.cpp
+ */
+
+#include "JPetOptionsTools/JPetOptions.h"
+#include <mutex>
+#include <unordered_map>
+
+JPetOptions::Key::Key(const std::string& name) : fName(name), fId(intern(name)) {}
+
+/**
+ * The keys created after the options were constructed get the ids greater than
+ * the size of fValues, which is correct, since their names are not in the options.
+ */
+std::size_t JPetOptions::intern(const std::string& name)
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::size_t> ids;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto found = ids.find(name);
+  if (found != ids.end())
+  {
+    return found->second;
+  }
+  auto id = ids.size();
+  ids.emplace(name, id);
+  return id;
+}
+
+JPetOptions::Ptr JPetOptions::create(const OptsStrAny& options) { return std::make_shared<const JPetOptions>(options); }
+
+JPetOptions::Ptr JPetOptions::create(OptsStrAny&& options) { return std::make_shared<const JPetOptions>(std::move(options)); }
+
+JPetOptions::Ptr JPetOptions::getEmpty()
+{
+  static const Ptr empty = create(OptsStrAny());
+  return empty;
+}
+
+JPetOptions::JPetOptions(OptsStrAny options) : fOptions(std::move(options))
+{
+  for (const auto& option : fOptions)
+  {
+    auto id = intern(option.first);
+    if (fValues.size() <= id)
+    {
+      fValues.resize(id + 1, nullptr);
+    }
+    fValues[id] = &option.second;
+  }
+}
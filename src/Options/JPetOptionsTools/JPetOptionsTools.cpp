@@ -169,6 +169,19 @@ long long getFirstEvent(const std::map<std::string, boost::any>& opts) { return
 
 long long getLastEvent(const std::map<std::string, boost::any>& opts) { return any_cast<int>(opts.at("lastEvent_int")); }
 
+/**
+ * The shard is set with the -s option, by default the whole input is a single shard 0.
+ */
+int getShardIndex(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "shardIndex_int") ? any_cast<int>(opts.at("shardIndex_int")) : 0;
+}
+
+int getNumberOfShards(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "numberOfShards_int") ? any_cast<int>(opts.at("numberOfShards_int")) : 1;
+}
+
 /**
  * It returns the total number of events calculated from the first and the last
  * event given in the range of events to calculate. If first or last event is
@@ -54,6 +54,29 @@ std::pair<std::string, boost::any> generateHigherEventBound(boost::any option)
     return std::make_pair("wrongLastEvent_int", -1);
 }
 
+/// The shard is validated after the transformation, so the wrong number of values must be handled here
+std::pair<std::string, boost::any> generateShardIndex(boost::any option)
+{
+  auto shard = any_cast<std::vector<int>>(option);
+  if (shard.size() == 2)
+  {
+    return std::make_pair("shardIndex_int", shard[0]);
+  }
+  else
+    return std::make_pair("wrongShardIndex_int", -1);
+}
+
+std::pair<std::string, boost::any> generateNumberOfShards(boost::any option)
+{
+  auto shard = any_cast<std::vector<int>>(option);
+  if (shard.size() == 2)
+  {
+    return std::make_pair("numberOfShards_int", shard[1]);
+  }
+  else
+    return std::make_pair("wrongNumberOfShards_int", -1);
+}
+
 /**
  * Function generates transformation function for file type if the input file
  * name terminates with hld.root and the file type value is set to root then
@@ -16,12 +16,14 @@
 #include "JPetParamManager/JPetParamManager.h"
 #include "JPetOptionsTools/JPetOptionsTools.h"
 #include "JPetParamGetterAscii/JPetParamGetterAscii.h"
+#include "JPetTracer/JPetTracer.h"
 
 #include <TFile.h>
 #include <boost/property_tree/xml_parser.hpp>
 
 std::shared_ptr<JPetParamManager> JPetParamManager::generateParamManager(const std::map<std::string, boost::any>& options)
 {
+  JPetTracer::Scope scope("params", "JPetParamManager::generateParamManager");
   using namespace jpet_options_tools;
   if (isLocalDB(options))
   {
@@ -153,6 +155,7 @@ JPetTOMBChannelFactory& JPetParamManager::getTOMBChannelFactory(const int runId)
 
 void JPetParamManager::fillParameterBank(const int run)
 {
+  JPetTracer::Scope scope("params", "JPetParamManager::fillParameterBank");
   if (fBank)
   {
     delete fBank;
@@ -243,6 +246,7 @@ void JPetParamManager::fillParameterBank(const int run)
 
 bool JPetParamManager::readParametersFromFile(JPetReader* reader)
 {
+  JPetTracer::Scope scope("params", "JPetParamManager::readParametersFromFile");
   assert(reader);
   if (!reader->isOpen())
   {
@@ -269,6 +273,7 @@ bool JPetParamManager::saveParametersToFile(JPetWriter* writer)
 
 bool JPetParamManager::readParametersFromFile(std::string filename)
 {
+  JPetTracer::Scope scope("params", "JPetParamManager::readParametersFromFile");
   TFile file(filename.c_str(), "READ");
   if (!file.IsOpen())
   {
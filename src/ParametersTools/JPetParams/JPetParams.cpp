@@ -17,11 +17,18 @@
 
 using namespace jpet_options_tools;
 
-JPetParams::JPetParams() : fParamManager(0) {}
+JPetParams::JPetParams() : fOptions(JPetOptions::getEmpty()), fParamManager(0) {}
 
-JPetParams::JPetParams(const OptsStrAny& opts, std::shared_ptr<JPetParamManager> mgr) : fOptions(opts), fParamManager(mgr) {}
+JPetParams::JPetParams(const OptsStrAny& opts, std::shared_ptr<JPetParamManager> mgr) : fOptions(JPetOptions::create(opts)), fParamManager(mgr) {}
 
-OptsStrAny JPetParams::getOptions() const { return fOptions; }
+JPetParams::JPetParams(JPetOptions::Ptr opts, std::shared_ptr<JPetParamManager> mgr)
+    : fOptions(opts ? opts : JPetOptions::getEmpty()), fParamManager(mgr)
+{
+}
+
+const OptsStrAny& JPetParams::getOptions() const { return fOptions->getMap(); }
+
+JPetOptions::Ptr JPetParams::getSharedOptions() const { return fOptions; }
 
 JPetParamManager* JPetParams::getParamManager() const { return fParamManager.get(); }
 
@@ -0,0 +1,76 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetCompactHitConverter.cpp
+ */
+
+#include "JPetCompactHitConverter/JPetCompactHitConverter.h"
+#include "JPetOptionsTools/JPetOptionsTools.h"
+
+using namespace jpet_options_tools;
+
+const std::string JPetCompactHitConverter::kKeepSignalsKey = "JPetCompactHitConverter_KeepSignals_bool";
+
+JPetCompactHitConverter::JPetCompactHitConverter(const char* name) : JPetUserTask(name) {}
+
+JPetCompactHitConverter::~JPetCompactHitConverter() {}
+
+bool JPetCompactHitConverter::init()
+{
+  fKeepSignals = isOptionSet(fParams.getOptions(), kKeepSignalsKey) && getOptionAsBool(fParams.getOptions(), kKeepSignalsKey);
+  if (fKeepSignals)
+  {
+    fOutputEvents = new JPetCompactHitWindow("JPetCompactHit");
+  }
+  else
+  {
+    fOutputEvents = new JPetTimeWindow("JPetCompactHit");
+  }
+  return true;
+}
+
+bool JPetCompactHitConverter::exec()
+{
+  if (auto timeWindow = dynamic_cast<const JPetTimeWindow*>(fEvent))
+  {
+    auto signals = fKeepSignals ? static_cast<JPetCompactHitWindow*>(fOutputEvents) : nullptr;
+    for (size_t i = 0; i < timeWindow->getNumberOfEvents(); i++)
+    {
+      fOutputEvents->add<JPetCompactHit>(convert(timeWindow->getEvent<JPetHit>(i), signals));
+    }
+  }
+  return true;
+}
+
+bool JPetCompactHitConverter::terminate() { return true; }
+
+/**
+ * Creates the compact version of the hit. If the window is given, the signals set in the hit
+ * are added to its side array and referenced by the returned compact hit.
+ */
+JPetCompactHit JPetCompactHitConverter::convert(const JPetHit& hit, JPetCompactHitWindow* signals)
+{
+  int signalAIndex = JPetCompactHit::kNoSignal;
+  int signalBIndex = JPetCompactHit::kNoSignal;
+  if (signals)
+  {
+    if (hit.isSignalASet())
+    {
+      signalAIndex = signals->addSignal(hit.getSignalA());
+    }
+    if (hit.isSignalBSet())
+    {
+      signalBIndex = signals->addSignal(hit.getSignalB());
+    }
+  }
+  return JPetCompactHit(hit, signalAIndex, signalBIndex);
+}
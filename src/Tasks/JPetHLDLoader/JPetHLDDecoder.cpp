@@ -0,0 +1,443 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDDecoder.cpp
+ */
+
+#include "JPetHLDLoader/JPetHLDDecoder.h"
+#include "JPetLoggerInclude.h"
+#include "JPetUnzipAndUnpackTask/JPetStreamDecompressor.h"
+
+#include <algorithm>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <cstring>
+#include <functional>
+
+namespace
+{
+/// The words of HLD headers and TRB data are stored either in the byte order of the machine,
+/// or swapped. The decoding word is a small number, so a large value means swapped order.
+const std::uint32_t kMaxDecodingWord = 0xffffff;
+const std::uint64_t kCoarseCounterRange = std::uint64_t(1) << 39;
+
+std::uint32_t readWord(const char* data, bool swapped)
+{
+  std::uint32_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return swapped ? __builtin_bswap32(word) : word;
+}
+
+bool isSwapped(const char* header) { return readWord(header + 4, false) > kMaxDecodingWord; }
+
+std::size_t align8(std::size_t size) { return (size + 7) & ~std::size_t(7); }
+}
+
+const std::size_t JPetHLDDecoder::kEventHeaderSize;
+const std::size_t JPetHLDDecoder::kSubEventHeaderSize;
+const std::size_t JPetHLDDecoder::kMaxEventSize;
+const unsigned int JPetHLDDecoder::kDefaultFineTimeMin;
+const unsigned int JPetHLDDecoder::kDefaultFineTimeMax;
+const double JPetHLDDecoder::kCoarseTimeUnit = 5000.0;
+
+JPetHLDDecoder::JPetHLDDecoder() {}
+
+JPetHLDDecoder::~JPetHLDDecoder() { close(); }
+
+/**
+ * Read the TDC endpoints and hubs from the Unpacker2 XML configuration file.
+ */
+bool JPetHLDDecoder::loadConfig(const std::string& configFileName)
+{
+  using boost::property_tree::ptree;
+  ptree tree;
+  try
+  {
+    boost::property_tree::read_xml(configFileName, tree);
+  }
+  catch (const boost::property_tree::xml_parser_error& e)
+  {
+    ERROR("Unable to read the unpacker configuration file " + configFileName + ": " + e.what());
+    return false;
+  }
+  auto parseAddress = [](const ptree& node) { return static_cast<unsigned int>(std::stoul(node.get<std::string>("TRBNET_ADDRESS"), nullptr, 16)); };
+  std::function<void(const ptree&)> parseNode = [&](const ptree& node) {
+    for (const auto& child : node)
+    {
+      try
+      {
+        if (child.first == "DATA_SOURCE" && child.second.count("TRBNET_ADDRESS"))
+        {
+          addHub(parseAddress(child.second));
+        }
+        else if (child.first == "MODULE" && child.second.count("TRBNET_ADDRESS") && child.second.count("CHANNEL_OFFSET"))
+        {
+          addTDC(parseAddress(child.second), child.second.get<unsigned int>("CHANNEL_OFFSET"),
+                 child.second.get<unsigned int>("NUMBER_OF_CHANNELS", 0));
+        }
+      }
+      catch (const std::exception& e)
+      {
+        WARNING("Skipping incorrect " + child.first + " entry in " + configFileName + ": " + e.what());
+      }
+      parseNode(child.second);
+    }
+  };
+  parseNode(tree);
+  if (fTDCs.empty())
+  {
+    ERROR("No TDC modules found in the unpacker configuration file " + configFileName);
+    return false;
+  }
+  return true;
+}
+
+void JPetHLDDecoder::addTDC(unsigned int address, unsigned int channelOffset, unsigned int numberOfChannels)
+{
+  fTDCs[address] = TDCModule{channelOffset, numberOfChannels};
+}
+
+void JPetHLDDecoder::addHub(unsigned int address) { fHubs.insert(address); }
+
+void JPetHLDDecoder::setFineTimeRange(unsigned int min, unsigned int max)
+{
+  if (min >= max)
+  {
+    WARNING("Incorrect fine time range, keeping the previous one");
+    return;
+  }
+  fFineTimeMin = min;
+  fFineTimeMax = max;
+}
+
+/**
+ * Use the same TDC endpoints, hubs and fine time calibration as the other decoder.
+ */
+void JPetHLDDecoder::setConfiguration(const JPetHLDDecoder& other)
+{
+  fTDCs = other.fTDCs;
+  fHubs = other.fHubs;
+  fFineTimeMin = other.fFineTimeMin;
+  fFineTimeMax = other.fFineTimeMax;
+}
+
+/**
+ * Open the plain or compressed HLD file. nThreads is used for the decompression of .xz files.
+ */
+bool JPetHLDDecoder::open(const std::string& fileName, unsigned int nThreads)
+{
+  close();
+  fFileName = fileName;
+  fError = false;
+  fNumberOfReadEvents = 0;
+  fOffset = 0;
+  fEndOffset = 0;
+  if (JPetStreamDecompressor::getFormat(fileName) != JPetStreamDecompressor::kUnknown)
+  {
+    fDecompressor.reset(new JPetStreamDecompressor(fileName, nThreads));
+    if (!fDecompressor->isOpen())
+    {
+      fDecompressor.reset();
+      fError = true;
+      return false;
+    }
+    return true;
+  }
+  fFile = std::fopen(fileName.c_str(), "rb");
+  if (!fFile)
+  {
+    setError("Cannot open the hld file");
+    return false;
+  }
+  return true;
+}
+
+void JPetHLDDecoder::close()
+{
+  if (fFile)
+  {
+    std::fclose(fFile);
+    fFile = nullptr;
+  }
+  fDecompressor.reset();
+}
+
+/**
+ * Move to the event starting at the given offset of the plain file;
+ * eventNumber is the number of events preceding it.
+ */
+bool JPetHLDDecoder::seek(std::uint64_t offset, long long eventNumber)
+{
+  if (!fFile)
+  {
+    ERROR("Seeking is possible only in plain hld files: " + fFileName);
+    return false;
+  }
+  if (fseeko(fFile, static_cast<off_t>(offset), SEEK_SET) != 0)
+  {
+    setError("Cannot seek to offset " + std::to_string(offset));
+    return false;
+  }
+  fOffset = offset;
+  fNumberOfReadEvents = eventNumber;
+  return true;
+}
+
+/**
+ * Read and decode the next event.
+ *
+ * @return false at the end of the file or on a read error (check with hasError())
+ */
+bool JPetHLDDecoder::nextEvent(JPetHLDEvent& event)
+{
+  while (readEvent())
+  {
+    if (fBuffer.size() > kEventHeaderSize)
+    {
+      fNumberOfReadEvents++;
+      return decodeEvent(fBuffer.data(), fBuffer.size(), event);
+    }
+  }
+  return false;
+}
+
+/**
+ * Skip nEvents events without decoding them.
+ *
+ * @return number of skipped events
+ */
+long long JPetHLDDecoder::skipEvents(long long nEvents)
+{
+  long long skipped = 0;
+  while (skipped < nEvents && readEvent())
+  {
+    if (fBuffer.size() > kEventHeaderSize)
+    {
+      fNumberOfReadEvents++;
+      skipped++;
+    }
+  }
+  return skipped;
+}
+
+/**
+ * Decode the event stored in data, including the event header.
+ */
+bool JPetHLDDecoder::decodeEvent(const char* data, std::size_t size, JPetHLDEvent& event)
+{
+  event.clear();
+  if (size < kEventHeaderSize)
+  {
+    return false;
+  }
+  const bool swapped = isSwapped(data);
+  const std::size_t eventSize = std::min<std::size_t>(readWord(data, swapped), size);
+  event.sequenceNumber = readWord(data + 12, swapped);
+  event.runNumber = readWord(data + 24, swapped);
+
+  std::size_t offset = kEventHeaderSize;
+  while (offset + kSubEventHeaderSize <= eventSize)
+  {
+    const char* subEvent = data + offset;
+    const bool subSwapped = isSwapped(subEvent);
+    const std::size_t subSize = readWord(subEvent, subSwapped);
+    if (subSize < kSubEventHeaderSize || offset + subSize > eventSize)
+    {
+      WARNING("Corrupted subevent in event " + std::to_string(event.sequenceNumber) + " of file " + fFileName);
+      break;
+    }
+    decodeBlocks(subEvent + kSubEventHeaderSize, (subSize - kSubEventHeaderSize) / 4, subSwapped, event);
+    offset += align8(subSize);
+  }
+  return true;
+}
+
+/**
+ * The subevent data consist of blocks of the TRB endpoints, each starting
+ * with a word containing the block length (upper 16 bits) and the endpoint address.
+ */
+void JPetHLDDecoder::decodeBlocks(const char* data, std::size_t nWords, bool swapped, JPetHLDEvent& event)
+{
+  std::size_t i = 0;
+  while (i < nWords)
+  {
+    const auto header = readWord(data + 4 * i, swapped);
+    const unsigned int address = header & 0xffff;
+    const std::size_t length = std::min<std::size_t>(header >> 16, nWords - i - 1);
+    const char* block = data + 4 * (i + 1);
+    auto tdc = fTDCs.find(address);
+    if (tdc != fTDCs.end())
+    {
+      decodeTDC(block, length, swapped, tdc->second, event);
+    }
+    else if (fHubs.count(address))
+    {
+      decodeBlocks(block, length, swapped, event);
+    }
+    i += length + 1;
+  }
+}
+
+/**
+ * Decode the TRB3 TDC words: epoch counter (bits 31-29 = 011) and time data (bit 31 set)
+ * with the channel number (bits 28-22), fine time (21-12), edge (11) and coarse time (10-0).
+ * Times are calculated relative to the first hit in the reference channel 0.
+ */
+void JPetHLDDecoder::decodeTDC(const char* data, std::size_t nWords, bool swapped, const TDCModule& tdc, JPetHLDEvent& event)
+{
+  fRawHits.clear();
+  std::uint64_t epoch = 0;
+  bool hasReference = false;
+  RawHit reference{0, 0, 0, true};
+  for (std::size_t i = 0; i < nWords; i++)
+  {
+    const auto word = readWord(data + 4 * i, swapped);
+    if ((word >> 29) == 0x3)
+    {
+      epoch = word & 0x0fffffff;
+    }
+    else if (word >> 31)
+    {
+      RawHit hit;
+      hit.channel = (word >> 22) & 0x7f;
+      hit.fine = (word >> 12) & 0x3ff;
+      hit.isLeading = (word >> 11) & 0x1;
+      hit.coarse = (epoch << 11) | (word & 0x7ff);
+      if (hit.fine == 0x3ff)
+      {
+        continue;
+      }
+      if (hit.channel == 0)
+      {
+        if (!hasReference)
+        {
+          reference = hit;
+          hasReference = true;
+        }
+      }
+      else if (tdc.numberOfChannels == 0 || hit.channel < tdc.numberOfChannels)
+      {
+        fRawHits.push_back(hit);
+      }
+    }
+  }
+  if (!hasReference)
+  {
+    event.hitsWithoutReference += fRawHits.size();
+    return;
+  }
+  const double referenceFineTime = getFineTime(reference.fine);
+  for (const auto& raw : fRawHits)
+  {
+    auto coarseDiff = static_cast<std::int64_t>((raw.coarse - reference.coarse) & (kCoarseCounterRange - 1));
+    if (coarseDiff >= static_cast<std::int64_t>(kCoarseCounterRange / 2))
+    {
+      coarseDiff -= kCoarseCounterRange;
+    }
+    JPetHLDChannelHit hit;
+    hit.channel = tdc.channelOffset + raw.channel;
+    hit.time = coarseDiff * kCoarseTimeUnit - (getFineTime(raw.fine) - referenceFineTime);
+    hit.isLeading = raw.isLeading;
+    event.hits.push_back(hit);
+  }
+}
+
+/**
+ * Linear fine time calibration: the fine counter measures the time from the hit
+ * to the next edge of the coarse counter clock.
+ */
+double JPetHLDDecoder::getFineTime(unsigned int fine) const
+{
+  const auto clamped = std::min(std::max(fine, fFineTimeMin), fFineTimeMax);
+  return (clamped - fFineTimeMin) * kCoarseTimeUnit / (fFineTimeMax - fFineTimeMin);
+}
+
+/**
+ * Read the next event (header and data) to the buffer.
+ */
+bool JPetHLDDecoder::readEvent()
+{
+  if (fError || (!fFile && !fDecompressor))
+  {
+    return false;
+  }
+  if (fEndOffset > 0 && fOffset >= fEndOffset)
+  {
+    return false;
+  }
+  fBuffer.resize(kEventHeaderSize);
+  auto nRead = readBytes(fBuffer.data(), kEventHeaderSize);
+  if (nRead == 0)
+  {
+    return false;
+  }
+  if (nRead < kEventHeaderSize)
+  {
+    setError("Truncated event header");
+    return false;
+  }
+  std::size_t eventSize = 0;
+  if (!readEventSize(fBuffer.data(), eventSize))
+  {
+    setError("Incorrect event size " + std::to_string(eventSize));
+    return false;
+  }
+  const auto paddedSize = align8(eventSize);
+  fBuffer.resize(paddedSize);
+  nRead = readBytes(fBuffer.data() + kEventHeaderSize, paddedSize - kEventHeaderSize);
+  /// the padding of the last event may be missing
+  if (kEventHeaderSize + nRead < eventSize)
+  {
+    setError("Truncated event");
+    return false;
+  }
+  fBuffer.resize(eventSize);
+  return true;
+}
+
+/**
+ * Get the size of the event from its header.
+ *
+ * @return false if the size is not correct
+ */
+bool JPetHLDDecoder::readEventSize(const char* header, std::size_t& size)
+{
+  size = readWord(header, isSwapped(header));
+  return size >= kEventHeaderSize && size <= kMaxEventSize;
+}
+
+std::size_t JPetHLDDecoder::readBytes(char* buffer, std::size_t size)
+{
+  if (fDecompressor)
+  {
+    std::size_t nRead = 0;
+    while (nRead < size && !fDecompressor->isFinished() && !fDecompressor->hasError())
+    {
+      nRead += fDecompressor->read(buffer + nRead, size - nRead);
+    }
+    if (fDecompressor->hasError())
+    {
+      fError = true;
+    }
+    fOffset += nRead;
+    return nRead;
+  }
+  auto nRead = std::fread(buffer, 1, size, fFile);
+  fOffset += nRead;
+  return nRead;
+}
+
+void JPetHLDDecoder::setError(const std::string& message)
+{
+  fError = true;
+  ERROR(message + " in file: " + fFileName);
+}
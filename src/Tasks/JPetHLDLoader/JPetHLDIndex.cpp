@@ -0,0 +1,251 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDIndex.cpp
+ */
+
+#include "JPetHLDLoader/JPetHLDIndex.h"
+#include "JPetHLDLoader/JPetHLDDecoder.h"
+#include "JPetLoggerInclude.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+const char kIndexMagic[8] = {'J', 'P', 'E', 'T', 'H', 'L', 'D', '1'};
+
+/// Layout of the index file: header and the table of event offsets.
+struct IndexFileHeader
+{
+  char fMagic[8];
+  std::uint64_t fFileSize;
+  std::int64_t fModificationTime;
+  std::uint64_t fNumberOfEvents;
+};
+
+bool readFileStatus(const std::string& fileName, std::uint64_t& size, std::int64_t& modificationTime)
+{
+  boost::system::error_code ec;
+  size = boost::filesystem::file_size(fileName, ec);
+  if (ec)
+  {
+    return false;
+  }
+  modificationTime = boost::filesystem::last_write_time(fileName, ec);
+  return !ec;
+}
+}
+
+std::string JPetHLDIndex::getIndexFileName(const std::string& hldFileName) { return hldFileName + ".idx"; }
+
+/**
+ * Load the index from the sidecar file, or build it and store it for the later runs.
+ * A failure of storing the index is not an error, the index is then built again next time.
+ */
+bool JPetHLDIndex::loadOrBuild(const std::string& hldFileName)
+{
+  if (load(hldFileName))
+  {
+    return true;
+  }
+  if (!build(hldFileName))
+  {
+    return false;
+  }
+  save(hldFileName);
+  return true;
+}
+
+/**
+ * Scan the event headers of the plain HLD file. If the file ends with an incomplete
+ * or corrupted event, the index contains the events preceding it.
+ */
+bool JPetHLDIndex::build(const std::string& hldFileName)
+{
+  fOffsets.clear();
+  if (!readFileStatus(hldFileName, fFileSize, fModificationTime))
+  {
+    ERROR("Unable to read the status of the hld file: " + hldFileName);
+    return false;
+  }
+  std::FILE* file = std::fopen(hldFileName.c_str(), "rb");
+  if (!file)
+  {
+    ERROR("Unable to open the hld file: " + hldFileName);
+    return false;
+  }
+  char header[JPetHLDDecoder::kEventHeaderSize];
+  std::uint64_t offset = 0;
+  while (offset < fFileSize)
+  {
+    if (fseeko(file, static_cast<off_t>(offset), SEEK_SET) != 0 || std::fread(header, 1, sizeof(header), file) != sizeof(header))
+    {
+      WARNING("Truncated event header at offset " + std::to_string(offset) + " in file: " + hldFileName);
+      break;
+    }
+    std::size_t eventSize = 0;
+    if (!JPetHLDDecoder::readEventSize(header, eventSize))
+    {
+      WARNING("Incorrect event size at offset " + std::to_string(offset) + " in file: " + hldFileName);
+      break;
+    }
+    if (offset + eventSize > fFileSize)
+    {
+      WARNING("Truncated event at offset " + std::to_string(offset) + " in file: " + hldFileName);
+      break;
+    }
+    if (eventSize > JPetHLDDecoder::kEventHeaderSize)
+    {
+      fOffsets.push_back(offset);
+    }
+    offset += (eventSize + 7) & ~std::uint64_t(7);
+  }
+  std::fclose(file);
+  INFO("Indexed " + std::to_string(fOffsets.size()) + " events of the hld file: " + hldFileName);
+  return true;
+}
+
+/**
+ * @return false if the index file does not exist, is corrupted or was created for the other version of the HLD file
+ */
+bool JPetHLDIndex::load(const std::string& hldFileName)
+{
+  fOffsets.clear();
+  auto indexFileName = getIndexFileName(hldFileName);
+  boost::system::error_code ec;
+  if (!boost::filesystem::exists(indexFileName, ec))
+  {
+    return false;
+  }
+  std::uint64_t fileSize = 0;
+  std::int64_t modificationTime = 0;
+  if (!readFileStatus(hldFileName, fileSize, modificationTime))
+  {
+    return false;
+  }
+  std::ifstream in(indexFileName, std::ios::binary);
+  IndexFileHeader header;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.fMagic, kIndexMagic, sizeof(kIndexMagic)) != 0)
+  {
+    WARNING("Hld index file: " + indexFileName + " is corrupted, the index will be recreated.");
+    return false;
+  }
+  if (header.fFileSize != fileSize || header.fModificationTime != modificationTime)
+  {
+    INFO("Hld index file: " + indexFileName + " does not match the hld file, the index will be recreated.");
+    return false;
+  }
+  std::vector<std::uint64_t> offsets(header.fNumberOfEvents);
+  if (!in.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(std::uint64_t)) || in.peek() != std::ifstream::traits_type::eof())
+  {
+    WARNING("Hld index file: " + indexFileName + " is corrupted, the index will be recreated.");
+    return false;
+  }
+  fOffsets.swap(offsets);
+  fFileSize = fileSize;
+  fModificationTime = modificationTime;
+  return true;
+}
+
+/**
+ * The file is first written under a temporary name and then renamed, so jobs
+ * reading the same HLD file never see a partially written index.
+ */
+bool JPetHLDIndex::save(const std::string& hldFileName) const
+{
+  auto indexFileName = getIndexFileName(hldFileName);
+  auto tmpFileName = indexFileName + "." + boost::filesystem::unique_path().string() + ".tmp";
+  boost::system::error_code ec;
+  {
+    std::ofstream out(tmpFileName, std::ios::binary);
+    if (!out)
+    {
+      WARNING("Unable to create hld index file: " + tmpFileName);
+      return false;
+    }
+    IndexFileHeader header;
+    std::memcpy(header.fMagic, kIndexMagic, sizeof(kIndexMagic));
+    header.fFileSize = fFileSize;
+    header.fModificationTime = fModificationTime;
+    header.fNumberOfEvents = fOffsets.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(fOffsets.data()), fOffsets.size() * sizeof(std::uint64_t));
+    if (!out)
+    {
+      WARNING("Unable to write hld index file: " + tmpFileName);
+      out.close();
+      boost::filesystem::remove(tmpFileName, ec);
+      return false;
+    }
+  }
+  boost::filesystem::rename(tmpFileName, indexFileName, ec);
+  if (ec)
+  {
+    WARNING("Unable to store hld index file: " + indexFileName + " " + ec.message());
+    boost::filesystem::remove(tmpFileName, ec);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @return offset of the given event, or the file size for the events past the last one
+ */
+std::uint64_t JPetHLDIndex::getEventOffset(long long event) const
+{
+  if (event < 0)
+  {
+    return 0;
+  }
+  return event < getNumberOfEvents() ? fOffsets[event] : fFileSize;
+}
+
+/**
+ * Byte range containing the events from firstEvent to lastEvent (inclusive),
+ * limited to the events present in the file. A negative lastEvent means the last event of the file.
+ */
+JPetHLDIndex::Range JPetHLDIndex::getRange(long long firstEvent, long long lastEvent) const
+{
+  firstEvent = std::max(0LL, firstEvent);
+  if (lastEvent < 0 || lastEvent >= getNumberOfEvents())
+  {
+    lastEvent = getNumberOfEvents() - 1;
+  }
+  return Range{firstEvent, lastEvent, getEventOffset(firstEvent), getEventOffset(lastEvent + 1)};
+}
+
+/**
+ * Split the range of events into at most nParts consecutive ranges
+ * with a similar number of events, which can be decoded independently.
+ */
+std::vector<JPetHLDIndex::Range> JPetHLDIndex::split(long long firstEvent, long long lastEvent, unsigned int nParts) const
+{
+  std::vector<Range> ranges;
+  auto whole = getRange(firstEvent, lastEvent);
+  long long nEvents = whole.lastEvent - whole.firstEvent + 1;
+  if (nEvents <= 0 || nParts == 0)
+  {
+    return ranges;
+  }
+  long long parts = std::min<long long>(nParts, nEvents);
+  for (long long i = 0; i < parts; i++)
+  {
+    long long first = whole.firstEvent + nEvents * i / parts;
+    long long last = whole.firstEvent + nEvents * (i + 1) / parts - 1;
+    ranges.push_back(getRange(first, last));
+  }
+  return ranges;
+}
@@ -0,0 +1,402 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDLoader.cpp
+ */
+
+#include "JPetHLDLoader/JPetHLDLoader.h"
+#include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetData/JPetData.h"
+#include "JPetOptionsTools/JPetOptionsTools.h"
+#include "JPetParamBank/JPetParamBank.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTaskIO/JPetTaskIOTools.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetTracer/JPetTracer.h"
+#include "JPetUnzipAndUnpackTask/JPetStreamDecompressor.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace jpet_options_tools;
+
+const std::string JPetHLDLoader::kNativeDecodingKey = "JPetHLDLoader_NativeDecoding_bool";
+const std::string JPetHLDLoader::kFineTimeMinKey = "JPetHLDLoader_FineTimeMin_int";
+const std::string JPetHLDLoader::kFineTimeMaxKey = "JPetHLDLoader_FineTimeMax_int";
+const std::string JPetHLDLoader::kDecompressionThreadsKey = "JPetUnzipAndUnpackTask_DecompressionThreads_int";
+const std::string JPetHLDLoader::kDecodingThreadsKey = "JPetHLDLoader_DecodingThreads_int";
+const std::string JPetHLDLoader::kUseIndexKey = "JPetUnzipAndUnpackTask_HLDIndex_bool";
+const long long JPetHLDLoader::kEventsPerBatch;
+
+JPetHLDLoader::JPetHLDLoader(const char* name, const char* out_file_type) : JPetTaskIO(name, "hld", out_file_type) {}
+
+JPetHLDLoader::~JPetHLDLoader() {}
+
+/**
+ * Native decoding is used only if requested by the user and the input file
+ * is an hld file, either plain or compressed in a format supported by JPetStreamDecompressor.
+ */
+bool JPetHLDLoader::isNativeDecodingOn(const OptsStrAny& options)
+{
+  if (!isOptionSet(options, kNativeDecodingKey) || !getOptionAsBool(options, kNativeDecodingKey))
+  {
+    return false;
+  }
+  auto fileType = FileTypeChecker::getInputFileType(options);
+  if (fileType == FileTypeChecker::kHld)
+  {
+    return true;
+  }
+  return fileType == FileTypeChecker::kZip && JPetStreamDecompressor::getFormat(getInputFile(options)) != JPetStreamDecompressor::kUnknown;
+}
+
+/**
+ * The output file name is created as for the hld file, also for the compressed input.
+ */
+std::tuple<bool, std::string, std::string, bool> JPetHLDLoader::setInputAndOutputFile(const OptsStrAny options) const
+{
+  auto opts = options;
+  const auto inputFile = getInputFile(options);
+  if (JPetStreamDecompressor::getFormat(inputFile) != JPetStreamDecompressor::kUnknown)
+  {
+    opts["inputFile_std::string"] = JPetCommonTools::stripFileNameSuffix(inputFile);
+  }
+  bool isOK = false;
+  std::string hldFile;
+  std::string outFileFullPath;
+  bool resetOutputPath = false;
+  std::tie(isOK, hldFile, outFileFullPath, resetOutputPath) =
+    JPetTaskIOTools::setInputAndOutputFile(opts, fTaskInfo.fResetOutputPath, fTaskInfo.fInFileType, fTaskInfo.fOutFileType);
+  return std::make_tuple(isOK, inputFile, outFileFullPath, resetOutputPath);
+}
+
+bool JPetHLDLoader::createInputObjects(const char* inputFilename)
+{
+  const auto& opts = fParams.getOptions();
+  if (!fDecoder.loadConfig(getUnpackerConfigFile(opts)))
+  {
+    return false;
+  }
+  if (isOptionSet(opts, kFineTimeMinKey) || isOptionSet(opts, kFineTimeMaxKey))
+  {
+    int min = isOptionSet(opts, kFineTimeMinKey) ? getOptionAsInt(opts, kFineTimeMinKey) : JPetHLDDecoder::kDefaultFineTimeMin;
+    int max = isOptionSet(opts, kFineTimeMaxKey) ? getOptionAsInt(opts, kFineTimeMaxKey) : JPetHLDDecoder::kDefaultFineTimeMax;
+    if (min < 0 || max < 0)
+    {
+      ERROR("The fine time range must not be negative");
+      return false;
+    }
+    fDecoder.setFineTimeRange(min, max);
+  }
+  if (isOptionSet(opts, "Unpacker_TDCnonlinearityCalib_std::string"))
+  {
+    WARNING("TDC nonlinearity calibration is not supported by the native hld decoding, linear fine time calibration is used.");
+  }
+  unsigned int nThreads = std::max(1u, std::thread::hardware_concurrency());
+  if (isOptionSet(opts, kDecompressionThreadsKey))
+  {
+    nThreads = std::max(1, getOptionAsInt(opts, kDecompressionThreadsKey));
+  }
+  if (!fDecoder.open(inputFilename, nThreads))
+  {
+    return false;
+  }
+  fInputFileName = inputFilename;
+  if (isOptionSet(opts, kDecodingThreadsKey))
+  {
+    fDecodingThreads = std::max(1, getOptionAsInt(opts, kDecodingThreadsKey));
+  }
+  /// the index is needed only to start from the given event, to split the file between threads
+  /// or to find the events of the shard
+  bool useIndex = !isOptionSet(opts, kUseIndexKey) || getOptionAsBool(opts, kUseIndexKey);
+  bool isIndexNeeded = fDecodingThreads > 1 || (isOptionSet(opts, "firstEvent_int") && getFirstEvent(opts) > 0) || getNumberOfShards(opts) > 1;
+  if (fDecoder.isSeekable() && useIndex && isIndexNeeded)
+  {
+    fHasIndex = fIndex.loadOrBuild(inputFilename);
+  }
+  if (fDecodingThreads > 1 && !fHasIndex)
+  {
+    WARNING("Parallel decoding requires the index of a plain hld file, the file will be decoded in a single thread");
+    fDecodingThreads = 1;
+  }
+  return true;
+}
+
+bool JPetHLDLoader::run(const JPetDataInterface&)
+{
+  if (fSubTasks.size() != 1)
+  {
+    ERROR("JPetHLDLoader requires exactly one subtask");
+    return false;
+  }
+  auto& subTask = fSubTasks.front();
+  auto subTaskName = subTask->getName();
+  auto cacheDirectoryScope = startCacheDirectoryScope();
+  auto profiler = startProfiling(0);
+  bool isOK = false;
+  {
+    JPetProfiler::Scope initScope(profiler, JPetProfiler::kInit);
+    isOK = subTask->init(fParams);
+  }
+  if (!isOK)
+  {
+    WARNING("In init() of:" + subTaskName + ". run()  and terminate() of this task will be skipped.");
+    return true;
+  }
+
+  const auto& opts = fParams.getOptions();
+  auto firstEvent = isOptionSet(opts, "firstEvent_int") ? getFirstEvent(opts) : -1;
+  auto lastEvent = isOptionSet(opts, "lastEvent_int") ? getLastEvent(opts) : -1;
+  if (getNumberOfShards(opts) > 1)
+  {
+    if (!fHasIndex)
+    {
+      ERROR("Processing a shard of the hld file requires its index, which is available only for the plain hld files");
+      return false;
+    }
+    bool isRangeOK = false;
+    std::tie(isRangeOK, firstEvent, lastEvent) = JPetTaskIOTools::setUserLimits(opts, fIndex.getNumberOfEvents());
+    if (!isRangeOK)
+    {
+      return false;
+    }
+  }
+  bool isProgressBarOn = isProgressBar(opts);
+  auto startEvent = std::max(0LL, static_cast<long long>(firstEvent));
+  if (isProgressBarOn)
+  {
+    /// the number of events is unknown for a file without the index, only the rate is shown then
+    long long numberOfEvents = lastEvent >= 0 ? lastEvent - startEvent + 1 : (fHasIndex ? fIndex.getNumberOfEvents() - startEvent : 0);
+    fProgressBar.startJob(subTaskName + " " + JPetCommonTools::extractFileNameFromFullPath(fInputFileName), numberOfEvents);
+  }
+
+  JPetTimeWindow timeWindow("JPetSigCh");
+  const auto& bank = getParamBank();
+  auto processEvent = [&](const JPetHLDEvent& event, long long eventNumber) {
+    JPetProfiler::Scope eventScope(profiler, JPetProfiler::kEvent);
+    fProgressBar.update(eventNumber - startEvent + 1);
+    timeWindow.Clear();
+    fillTimeWindow(event, bank, timeWindow);
+    JPetData data(timeWindow);
+    {
+      JPetProfiler::Scope execScope(profiler, JPetProfiler::kExec);
+      if (!subTask->run(data))
+      {
+        ERROR("In run() of:" + subTaskName + ". ");
+        return false;
+      }
+    }
+    if (isOutput())
+    {
+      JPetProfiler::Scope writeScope(profiler, JPetProfiler::kWrite);
+      fOutputHandler->setWindowNumber(eventNumber);
+      if (!fOutputHandler->writeEventToFile(subTask.get()))
+      {
+        ERROR("Some problems occured, while writing the event to file.");
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto runStart = JPetProfiler::Clock::now();
+
+  if (fHasIndex && firstEvent >= fIndex.getNumberOfEvents())
+  {
+    WARNING("The hld file contains less events than the first requested event");
+  }
+  else if (fDecodingThreads > 1)
+  {
+    if (!runParallel(firstEvent, lastEvent, processEvent))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    if (firstEvent > 0)
+    {
+      if (fHasIndex)
+      {
+        if (!fDecoder.seek(fIndex.getEventOffset(firstEvent), firstEvent))
+        {
+          ERROR("Cannot seek to the event " + std::to_string(firstEvent) + " of the hld file " + fInputFileName);
+          return false;
+        }
+      }
+      else if (fDecoder.skipEvents(firstEvent) < firstEvent)
+      {
+        WARNING("The hld file contains less events than the first requested event");
+      }
+    }
+    JPetHLDEvent event;
+    auto readEvent = [&]() {
+      JPetTracer::Scope traceScope("io", "JPetHLDDecoder::nextEvent");
+      JPetProfiler::Scope readScope(profiler, JPetProfiler::kRead);
+      return fDecoder.nextEvent(event);
+    };
+    while ((lastEvent < 0 || fDecoder.getNumberOfReadEvents() <= lastEvent) && readEvent())
+    {
+      if (!processEvent(event, fDecoder.getNumberOfReadEvents() - 1))
+      {
+        return false;
+      }
+    }
+    if (fDecoder.hasError())
+    {
+      return false;
+    }
+  }
+  fProgressBar.finishJob();
+  if (profiler)
+  {
+    profiler->add(JPetProfiler::kRun, JPetProfiler::Clock::now() - runStart);
+  }
+  if (fHitsWithoutReference > 0)
+  {
+    WARNING(std::to_string(fHitsWithoutReference) + " TDC hits were skipped because of the missing reference time.");
+  }
+
+  JPetParams subTaskParams;
+  {
+    JPetProfiler::Scope terminateScope(profiler, JPetProfiler::kTerminate);
+    isOK = subTask->terminate(subTaskParams);
+  }
+  if (!isOK)
+  {
+    ERROR("In terminate() of:" + subTaskName + ". ");
+    return false;
+  }
+  fParams = mergeWithExtraParams(fParams, subTaskParams);
+  return true;
+}
+
+/**
+ * The events are decoded in batches: every batch is split into independent byte ranges
+ * decoded concurrently by separate decoders, then the events are passed to the user task in order.
+ */
+bool JPetHLDLoader::runParallel(long long firstEvent, long long lastEvent,
+                                const std::function<bool(const JPetHLDEvent&, long long)>& processEvent)
+{
+  auto whole = fIndex.getRange(firstEvent, lastEvent);
+  const long long batchSize = kEventsPerBatch * fDecodingThreads;
+  std::vector<std::vector<JPetHLDEvent>> decoded(fDecodingThreads);
+  for (long long batchFirst = whole.firstEvent; batchFirst <= whole.lastEvent; batchFirst += batchSize)
+  {
+    auto ranges = fIndex.split(batchFirst, std::min(whole.lastEvent, batchFirst + batchSize - 1), fDecodingThreads);
+    std::vector<char> statuses(ranges.size(), false);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < ranges.size(); i++)
+    {
+      threads.emplace_back([this, &ranges, &decoded, &statuses, i]() { statuses[i] = decodeRange(ranges[i], decoded[i]); });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    for (std::size_t i = 0; i < ranges.size(); i++)
+    {
+      if (!statuses[i])
+      {
+        return false;
+      }
+      for (std::size_t j = 0; j < decoded[i].size(); j++)
+      {
+        if (!processEvent(decoded[i][j], ranges[i].firstEvent + j))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Decode all events of the byte range with a separate decoder, configured as the main one.
+ */
+bool JPetHLDLoader::decodeRange(const JPetHLDIndex::Range& range, std::vector<JPetHLDEvent>& events) const
+{
+  JPetTracer::Scope scope("io", "JPetHLDLoader::decodeRange");
+  JPetHLDDecoder decoder;
+  decoder.setConfiguration(fDecoder);
+  if (!decoder.open(fInputFileName) || !decoder.seek(range.beginOffset, range.firstEvent))
+  {
+    return false;
+  }
+  decoder.setEndOffset(range.endOffset);
+  events.resize(range.lastEvent - range.firstEvent + 1);
+  std::size_t nEvents = 0;
+  while (nEvents < events.size() && decoder.nextEvent(events[nEvents]))
+  {
+    nEvents++;
+  }
+  events.resize(nEvents);
+  return !decoder.hasError();
+}
+
+/**
+ * Convert the decoded TDC hits to JPetSigCh objects, with the TOMB channel, PM, FEB and TRB
+ * set according to the parameter bank. Hits in channels absent in the parameter bank are skipped.
+ */
+void JPetHLDLoader::fillTimeWindow(const JPetHLDEvent& event, const JPetParamBank& bank, JPetTimeWindow& window)
+{
+  fHitsWithoutReference += event.hitsWithoutReference;
+  const auto& tombChannels = bank.getTOMBChannels();
+  for (const auto& hit : event.hits)
+  {
+    auto found = tombChannels.find(hit.channel);
+    if (found == tombChannels.end())
+    {
+      if (fUnknownChannels.insert(hit.channel).second)
+      {
+        WARNING("DAQ channel " + std::to_string(hit.channel) + " is not present in the parameter bank, its signals are skipped.");
+      }
+      continue;
+    }
+    const auto& tombChannel = *found->second;
+    JPetSigCh sigCh(hit.isLeading ? JPetSigCh::Leading : JPetSigCh::Trailing, hit.time);
+    sigCh.setTOMBChannel(tombChannel);
+    sigCh.setPM(tombChannel.getPM());
+    sigCh.setFEB(tombChannel.getFEB());
+    sigCh.setTRB(tombChannel.getTRB());
+    sigCh.setDAQch(tombChannel.getChannel());
+    sigCh.setThresholdNumber(tombChannel.getLocalChannelNumber());
+    sigCh.setThreshold(tombChannel.getThreshold());
+    sigCh.setRecoFlag(JPetSigCh::Good);
+    window.add<JPetSigCh>(sigCh);
+  }
+}
+
+bool JPetHLDLoader::terminate(JPetParams& output_params)
+{
+  fDecoder.close();
+  if (isOutput())
+  {
+    auto newOpts = JPetTaskIOTools::setOutputOptions(fParams, fTaskInfo.fResetOutputPath, fTaskInfo.fOutFileFullPath);
+    output_params = JPetParams(newOpts, fParams.getParamManagerAsShared());
+    if (!fHeader || !fStatistics)
+    {
+      ERROR("Tree header or statistics are not set, subtask name:" + getFirstSubTaskName());
+      return false;
+    }
+    saveProfiles(fTaskInfo.fOutFileFullPath);
+    fOutputHandler->saveAndCloseOutput(getParamManager(), fHeader, fStatistics.get(), fSubTasksStatistics);
+  }
+  else
+  {
+    output_params = fParams;
+    saveProfiles(fInputFileName);
+  }
+  return true;
+}
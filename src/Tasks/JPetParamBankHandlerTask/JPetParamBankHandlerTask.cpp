@@ -32,11 +32,12 @@ JPetParamBankHandlerTask::JPetParamBankHandlerTask(const char* name) : JPetTask(
 bool JPetParamBankHandlerTask::init(const JPetParams& params)
 {
   using namespace jpet_options_tools;
-  auto options = params.getOptions();
+  const auto& options = params.getOptions();
   switch (FileTypeChecker::getInputFileType(options))
   {
   case FileTypeChecker::FileType::kHld:
   case FileTypeChecker::FileType::kHldRoot:
+  case FileTypeChecker::FileType::kZip:
     return generateParamBankFromConfig(params);
     break;
   case FileTypeChecker::FileType::kRoot:
@@ -77,7 +78,7 @@ bool JPetParamBankHandlerTask::terminate(JPetParams&) { return true; }
 bool JPetParamBankHandlerTask::generateParamBankFromRootFile(const JPetParams& params)
 {
   using namespace jpet_options_tools;
-  auto options = params.getOptions();
+  const auto& options = params.getOptions();
   if (getRunNumber(options) != -1)
   {
     WARNING("Input file was ROOT, but run number option is set, ignoring it");
@@ -95,7 +96,7 @@ bool JPetParamBankHandlerTask::generateParamBankFromRootFile(const JPetParams& p
 bool JPetParamBankHandlerTask::generateParamBankFromConfig(const JPetParams& params)
 {
   using namespace jpet_options_tools;
-  auto options = params.getOptions();
+  const auto& options = params.getOptions();
   if (getRunNumber(options) == -1 || !isLocalDB(options))
   {
     ERROR("LocalDB and run number are required for Hld, HldRoot or Scope files");
@@ -20,11 +20,15 @@
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
 #include "JPetScopeConfigParser/JPetScopeConfigParser.h"
 #include "JPetScopeData/JPetScopeData.h"
+#include "JPetScopeTask/JPetScopeFileParser.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/regex.hpp>
 
 #include <TSystem.h>
+#include <algorithm>
+#include <iterator>
+#include <thread>
 
 using namespace std;
 using namespace boost::filesystem;
@@ -71,35 +75,77 @@ std::map<std::string, int> JPetScopeLoader::createInputScopeFileNames(const std:
                                                                       std::map<std::string, int> pmPref2Id) const
 {
   std::map<std::string, int> scopeFiles;
+  scanInputScopeFiles(inputPathToScopeFiles, pmPref2Id, [&scopeFiles](TimeWindowFiles&& window) {
+    scopeFiles.insert(window.second.begin(), window.second.end());
+    return true;
+  });
+  return scopeFiles;
+}
+
+/**
+ * Walks the directory and groups the scope files by the time window index on the fly.
+ * A time window is complete when it contains a file for every photomultiplier prefix.
+ * The complete windows are passed to the callback as soon as no window with a lower index
+ * is pending, so the processing starts before the whole directory is scanned, whatever
+ * the first index is and even if some indices are missing. The windows are passed in the order
+ * of their indices if the files of the lower windows are found first.
+ * The windows which are still pending at the end of the scan, i.e. the incomplete ones and the windows
+ * following them, are passed in the order of their indices.
+ * Returns false if the directory does not exist or if the callback returned false.
+ */
+bool JPetScopeLoader::scanInputScopeFiles(const std::string& inputPathToScopeFiles, const std::map<std::string, int>& pmPref2Id,
+                                          const std::function<bool(TimeWindowFiles&&)>& onTimeWindow) const
+{
   path current_dir(inputPathToScopeFiles);
-  if (exists(current_dir))
+  if (!exists(current_dir))
+  {
+    string msg = "Directory: \"";
+    msg += current_dir.string();
+    msg += "\" does not exist.";
+    ERROR(msg.c_str());
+    return false;
+  }
+  struct PendingWindow
+  {
+    std::map<std::string, int> fFiles;
+    std::set<std::string> fPrefixes;
+  };
+  std::map<int, PendingWindow> pendingWindows;
+  for (recursive_directory_iterator iter(current_dir), end; iter != end; ++iter)
   {
-    for (recursive_directory_iterator iter(current_dir), end; iter != end; ++iter)
+    std::string filename = iter->path().filename().string();
+    if (!isCorrectScopeFileName(filename))
+    {
+      continue;
+    }
+    auto prefix = getFilePrefix(filename);
+    auto pm = pmPref2Id.find(prefix);
+    if (pm == pmPref2Id.end())
     {
-      std::string filename = iter->path().leaf().string();
-      if (isCorrectScopeFileName(filename))
+      WARNING("The filename does not contain the accepted prefix:" + filename);
+      continue;
+    }
+    auto& window = pendingWindows[parseTimeWindowIndex(filename)];
+    window.fFiles[iter->path().parent_path().string() + "/" + filename] = pm->second;
+    window.fPrefixes.insert(prefix);
+    while (!pendingWindows.empty() && pendingWindows.begin()->second.fPrefixes.size() == pmPref2Id.size())
+    {
+      TimeWindowFiles completeWindow(pendingWindows.begin()->first, std::move(pendingWindows.begin()->second.fFiles));
+      pendingWindows.erase(pendingWindows.begin());
+      if (!onTimeWindow(std::move(completeWindow)))
       {
-        auto prefix = getFilePrefix(filename);
-        if (pmPref2Id.find(prefix) != pmPref2Id.end())
-        {
-          int id = pmPref2Id.find(prefix)->second;
-          scopeFiles[iter->path().parent_path().string() + "/" + filename] = id;
-        }
-        else
-        {
-          WARNING("The filename does not contain the accepted prefix:" + filename);
-        }
+        return false;
       }
     }
   }
-  else
+  for (auto& window : pendingWindows)
   {
-    string msg = "Directory: \"";
-    msg += current_dir.string();
-    msg += "\" does not exist.";
-    ERROR(msg.c_str());
+    if (!onTimeWindow(TimeWindowFiles(window.first, std::move(window.second.fFiles))))
+    {
+      return false;
+    }
   }
-  return scopeFiles;
+  return true;
 }
 
 std::string JPetScopeLoader::getFilePrefix(const std::string& filename) const
@@ -114,7 +160,7 @@ std::string JPetScopeLoader::getFilePrefix(const std::string& filename) const
 
 bool JPetScopeLoader::isCorrectScopeFileName(const std::string& filename) const
 {
-  boost::regex pattern("^[A-Za-z0-9]+_\\d*.txt");
+  static const boost::regex pattern("^[A-Za-z0-9]+_\\d*.txt");
   return regex_match(filename, pattern);
 }
 
@@ -137,19 +183,66 @@ bool JPetScopeLoader::run(const JPetDataInterface&)
     return false;
   }
   auto subTask = fSubTasks.begin()->get();
+  auto cacheDirectoryScope = startCacheDirectoryScope();
   subTask->init(fParams);
 
   using namespace jpet_options_tools;
   JPetScopeConfigParser confParser;
-  auto opts = fParams.getOptions();
+  const auto& opts = fParams.getOptions();
   auto config = confParser.getConfig(getScopeConfigFile(opts));
   auto prefix2PM = getPMPrefixToPMIdMap();
-  auto inputScopeFiles = createInputScopeFileNames(getScopeInputDirectory(opts), prefix2PM);
-  auto events = JPetScopeLoader::groupScopeFileNamesByTimeWindowIndex(inputScopeFiles);
+  auto nThreads = getNumberOfDecodingThreads(opts);
 
-  for (auto& ev : events)
+  std::vector<TimeWindowFiles> batch;
+  std::size_t filesInBatch = 0;
+  bool isOK = true;
+  bool isScanOK = scanInputScopeFiles(getScopeInputDirectory(opts), prefix2PM, [&](TimeWindowFiles&& window) {
+    filesInBatch += window.second.size();
+    batch.push_back(std::move(window));
+    if (filesInBatch >= kFilesPerThreadInBatch * nThreads)
+    {
+      isOK = processTimeWindows(batch, nThreads);
+      batch.clear();
+      filesInBatch = 0;
+    }
+    return isOK;
+  });
+  if (!isScanOK || !isOK || !processTimeWindows(batch, nThreads))
   {
-    JPetScopeData data(ev);
+    return false;
+  }
+  subTask->terminate(fParams);
+  return true;
+}
+
+/**
+ * The files of all time windows in the batch are decoded in parallel,
+ * then the windows are passed to the subtask and written ordered by their indices.
+ */
+bool JPetScopeLoader::processTimeWindows(std::vector<TimeWindowFiles>& timeWindows, unsigned int nThreads)
+{
+  if (timeWindows.empty())
+  {
+    return true;
+  }
+  std::sort(timeWindows.begin(), timeWindows.end(),
+            [](const TimeWindowFiles& a, const TimeWindowFiles& b) { return a.first < b.first; });
+  auto subTask = fSubTasks.begin()->get();
+  std::vector<std::string> fileNames;
+  for (const auto& window : timeWindows)
+  {
+    for (const auto& file : window.second)
+    {
+      fileNames.push_back(file.first);
+    }
+  }
+  auto signals = JPetScopeFileParser::parseFiles(fileNames, nThreads);
+  auto signalIt = signals.begin();
+  for (auto& window : timeWindows)
+  {
+    std::vector<JPetRecoSignal> windowSignals(std::make_move_iterator(signalIt), std::make_move_iterator(signalIt + window.second.size()));
+    signalIt += window.second.size();
+    JPetScopeData data(window, std::move(windowSignals));
     subTask->run(data);
     if (isOutput())
     {
@@ -159,10 +252,24 @@ bool JPetScopeLoader::run(const JPetDataInterface&)
       }
     }
   }
-  subTask->terminate(fParams);
   return true;
 }
 
+unsigned int JPetScopeLoader::getNumberOfDecodingThreads(const jpet_options_tools::OptsStrAny& opts) const
+{
+  using namespace jpet_options_tools;
+  if (isOptionSet(opts, kNumberOfDecodingThreadsKey))
+  {
+    auto nThreads = getOptionAsInt(opts, kNumberOfDecodingThreadsKey);
+    if (nThreads > 0)
+    {
+      return nThreads;
+    }
+    WARNING(kNumberOfDecodingThreadsKey + " must be greater than 0, using the default value.");
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
 bool JPetScopeLoader::terminate(JPetParams& output_params)
 {
   OptsStrAny new_opts;
@@ -180,7 +287,7 @@ bool JPetScopeLoader::createOutputObjects(const char* outputFilename)
   assert(!fOutputHandler);
   fOutputHandler = jpet_common_tools::make_unique<JPetOutputHandler>(outputFilename);
   using namespace jpet_options_tools;
-  auto opts = fParams.getOptions();
+  const auto& opts = fParams.getOptions();
   if (!fSubTasks.empty())
   {
     assert(fSubTasks.size() == 1);
@@ -240,12 +347,17 @@ std::tuple<bool, std::string, std::string, bool> JPetScopeLoader::setInputAndOut
 
 int JPetScopeLoader::getTimeWindowIndex(const std::string& pathAndFileName)
 {
-  int time_window_index = -1;
   if (!boost::filesystem::exists(pathAndFileName))
   {
     ERROR("File does not exist ");
   }
-  int res = sscanf(JPetCommonTools::extractFileNameFromFullPath(pathAndFileName).c_str(), "%*3s %d", &time_window_index);
+  return parseTimeWindowIndex(JPetCommonTools::extractFileNameFromFullPath(pathAndFileName));
+}
+
+int JPetScopeLoader::parseTimeWindowIndex(const std::string& fileName)
+{
+  int time_window_index = -1;
+  int res = sscanf(fileName.c_str(), "%*3s %d", &time_window_index);
   if (res <= 0)
   {
     ERROR("scanf failed");
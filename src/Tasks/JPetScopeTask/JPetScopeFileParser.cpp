@@ -0,0 +1,262 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeFileParser.cpp
+ */
+
+#include "JPetScopeTask/JPetScopeFileParser.h"
+#include "JPetLoggerInclude.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+constexpr double JPetScopeFileParser::kSecondsToPs;
+constexpr double JPetScopeFileParser::kVoltsTomV;
+
+namespace
+{
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+const double kPowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+const int kMaxExactPower = 22;
+const int kMaxMantissaDigits = 19;
+}
+
+/**
+ * Parses numbers in the format [+-]digits[.digits][(e|E)[+-]digits], independently of the locale.
+ * Up to 19 significant digits are accumulated in an integer mantissa, the rest only shifts the exponent.
+ */
+bool JPetScopeFileParser::parseNumber(const char*& pos, const char* end, double& value)
+{
+  const char* p = pos;
+  while (p < end && isBlank(*p))
+  {
+    p++;
+  }
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    p++;
+  }
+  std::uint64_t mantissa = 0;
+  int nDigits = 0;
+  int exponent = 0;
+  bool anyDigit = false;
+  for (; p < end && isDigit(*p); p++)
+  {
+    anyDigit = true;
+    if (nDigits < kMaxMantissaDigits)
+    {
+      if (mantissa != 0 || *p != '0')
+      {
+        nDigits++;
+      }
+      mantissa = mantissa * 10 + (*p - '0');
+    }
+    else
+    {
+      exponent++;
+    }
+  }
+  if (p < end && *p == '.')
+  {
+    p++;
+    for (; p < end && isDigit(*p); p++)
+    {
+      anyDigit = true;
+      if (nDigits < kMaxMantissaDigits)
+      {
+        if (mantissa != 0 || *p != '0')
+        {
+          nDigits++;
+        }
+        mantissa = mantissa * 10 + (*p - '0');
+        exponent--;
+      }
+    }
+  }
+  if (!anyDigit)
+  {
+    return false;
+  }
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    const char* expPos = p + 1;
+    bool negativeExp = false;
+    if (expPos < end && (*expPos == '-' || *expPos == '+'))
+    {
+      negativeExp = (*expPos == '-');
+      expPos++;
+    }
+    if (expPos < end && isDigit(*expPos))
+    {
+      int expValue = 0;
+      for (; expPos < end && isDigit(*expPos); expPos++)
+      {
+        if (expValue < 10000)
+        {
+          expValue = expValue * 10 + (*expPos - '0');
+        }
+      }
+      exponent += negativeExp ? -expValue : expValue;
+      p = expPos;
+    }
+  }
+  double result = static_cast<double>(mantissa);
+  if (exponent < 0 && exponent >= -kMaxExactPower)
+  {
+    result /= kPowersOf10[-exponent];
+  }
+  else if (exponent > 0 && exponent <= kMaxExactPower)
+  {
+    result *= kPowersOf10[exponent];
+  }
+  else if (exponent != 0)
+  {
+    result *= std::pow(10.0, exponent);
+  }
+  value = negative ? -result : result;
+  pos = p;
+  return true;
+}
+
+const char* JPetScopeFileParser::skipLine(const char* pos, const char* end)
+{
+  const char* newLine = std::find(pos, end, '\n');
+  return newLine == end ? end : newLine + 1;
+}
+
+const char* JPetScopeFileParser::skipWord(const char* pos, const char* end)
+{
+  while (pos < end && (*pos == ' ' || *pos == '\t'))
+  {
+    pos++;
+  }
+  while (pos < end && !isBlank(*pos))
+  {
+    pos++;
+  }
+  return pos;
+}
+
+JPetRecoSignal JPetScopeFileParser::parseContent(const char* begin, const char* end, bool hasHeader, const std::string& fileName)
+{
+  int segmentSize = 0;
+  const char* pos = begin;
+  if (hasHeader)
+  {
+    pos = skipLine(pos, end);
+    const char* lineEnd = skipLine(pos, end);
+    for (int i = 0; i < 3; i++)
+    {
+      pos = skipWord(pos, lineEnd);
+    }
+    double size = 0;
+    if (parseNumber(pos, lineEnd, size))
+    {
+      segmentSize = static_cast<int>(size);
+    }
+    pos = lineEnd;
+    for (int i = 2; i < kNumberOfHeaderLines; i++)
+    {
+      pos = skipLine(pos, end);
+    }
+  }
+  JPetRecoSignal recoSignal(segmentSize);
+  for (int i = 0; i < segmentSize; ++i)
+  {
+    double value = 0;
+    double threshold = 0;
+    if (!parseNumber(pos, end, value) || !parseNumber(pos, end, threshold))
+    {
+      ERROR("Non-numerical symbol in file " + fileName + " at line " + std::to_string(i + kNumberOfHeaderLines + 1));
+      pos = skipLine(pos, end);
+      if (pos == end)
+      {
+        break;
+      }
+      continue;
+    }
+    /// The values are rounded to float, as it was done by the previous fscanf based implementation.
+    float time = static_cast<float>(value) * kSecondsToPs;
+    float amplitude = static_cast<float>(threshold) * kVoltsTomV;
+    recoSignal.setShapePoint(time, amplitude);
+  }
+  return recoSignal;
+}
+
+JPetRecoSignal JPetScopeFileParser::parseFile(const std::string& fileName)
+{
+  namespace bip = boost::interprocess;
+  bool hasHeader = boost::filesystem::extension(fileName) != ".tsv";
+  boost::system::error_code ec;
+  auto size = boost::filesystem::file_size(fileName, ec);
+  if (ec)
+  {
+    ERROR("Error: cannot open file " + fileName);
+    return JPetRecoSignal(0);
+  }
+  if (size == 0)
+  {
+    return parseContent(nullptr, nullptr, hasHeader, fileName);
+  }
+  try
+  {
+    bip::file_mapping file(fileName.c_str(), bip::read_only);
+    bip::mapped_region region(file, bip::read_only);
+    region.advise(bip::mapped_region::advice_sequential);
+    const char* begin = static_cast<const char*>(region.get_address());
+    return parseContent(begin, begin + region.get_size(), hasHeader, fileName);
+  }
+  catch (const bip::interprocess_exception& ex)
+  {
+    ERROR("Error: cannot map file " + fileName + " " + ex.what());
+    return JPetRecoSignal(0);
+  }
+}
+
+/**
+ * The files are distributed dynamically between the threads, each result is stored
+ * at the index of its file name, so the output order does not depend on the scheduling.
+ */
+std::vector<JPetRecoSignal> JPetScopeFileParser::parseFiles(const std::vector<std::string>& fileNames, unsigned int nThreads)
+{
+  std::vector<JPetRecoSignal> signals(fileNames.size());
+  nThreads = std::max(1u, std::min<unsigned int>(nThreads, fileNames.size()));
+  std::atomic<std::size_t> nextFile(0);
+  auto worker = [&]() {
+    for (auto i = nextFile++; i < fileNames.size(); i = nextFile++)
+    {
+      signals[i] = parseFile(fileNames[i]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < nThreads; i++)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  return signals;
+}
@@ -15,6 +15,7 @@
 
 #include "JPetScopeTask/JPetScopeTask.h"
 #include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetOptionsTools/JPetOptionsTools.h"
 #include "JPetScopeData/JPetScopeData.h"
 #include "JPetScopeTask/JPetScopeTaskUtils.h"
 
@@ -23,6 +24,7 @@
 #include <memory>
 
 using namespace boost::filesystem;
+using namespace jpet_options_tools;
 
 JPetScopeTask::JPetScopeTask(const char* name) : JPetUserTask(name) {}
 
@@ -30,13 +32,37 @@ bool JPetScopeTask::run(const JPetDataInterface& inData)
 {
   auto& currData = dynamic_cast<const JPetScopeData&>(inData);
   fInputFilesInCurrentWindow = currData.getEvent();
-  return exec();
+  fDecodedSignals = currData.hasDecodedSignals() ? &currData.getDecodedSignals() : nullptr;
+  bool result = exec();
+  fDecodedSignals = nullptr;
+  return result;
 }
 
 bool JPetScopeTask::init()
 {
   INFO("Scope Task started");
   fOutputEvents = new JPetTimeWindow("JPetRecoSignal");
+  if (isOptionSet(fParams.getOptions(), kCalculateSignalPropertiesParamKey))
+  {
+    fCalculateSignalProperties = getOptionAsBool(fParams.getOptions(), kCalculateSignalPropertiesParamKey);
+  }
+  if (isOptionSet(fParams.getOptions(), kBaselinePointsParamKey))
+  {
+    fBaselinePoints = getOptionAsInt(fParams.getOptions(), kBaselinePointsParamKey);
+  }
+  if (isOptionSet(fParams.getOptions(), kConstantFractionParamKey))
+  {
+    fConstantFraction = getOptionAsFloat(fParams.getOptions(), kConstantFractionParamKey);
+  }
+  if (isOptionSet(fParams.getOptions(), kThresholdsParamKey))
+  {
+    fThresholds = getOptionAsVectorOfInts(fParams.getOptions(), kThresholdsParamKey);
+  }
+  if (fBaselinePoints < 1)
+  {
+    WARNING("Number of baseline points must be positive, using 1");
+    fBaselinePoints = 1;
+  }
   return true;
 }
 
@@ -51,23 +77,77 @@ bool JPetScopeTask::exec()
   else
   {
     DEBUG(std::string("time window index:") + std::to_string(fInputFilesInCurrentWindow.first));
-    auto files = fInputFilesInCurrentWindow.second;
+    const auto& files = fInputFilesInCurrentWindow.second;
+    fSignals.clear();
+    std::size_t fileIndex = 0;
     for (const auto& file : files)
     {
       DEBUG(std::string("file to open:") + file.first);
-      JPetRecoSignal sig = RecoSignalUtils::generateSignal(file.first.c_str());
+      JPetRecoSignal sig = fDecodedSignals ? (*fDecodedSignals)[fileIndex] : RecoSignalUtils::generateSignal(file.first.c_str());
+      fileIndex++;
       DEBUG("before setPM");
       const JPetPM& pm = bank.getPM(file.second);
       const JPetBarrelSlot& bs = pm.getBarrelSlot();
       sig.setPM(pm);
       sig.setBarrelSlot(bs);
       DEBUG("after setPM");
+      fSignals.push_back(std::move(sig));
+    }
+    if (fCalculateSignalProperties)
+    {
+      calculateSignalProperties(fSignals);
+    }
+    for (const auto& sig : fSignals)
+    {
       fOutputEvents->add<JPetRecoSignal>(sig);
     }
   }
   return true;
 }
 
+/**
+ * Fill offset, amplitude, charge and the times at thresholds of all signals
+ * of the time window, processed together as one batch of waveforms.
+ * Thresholds not crossed by a signal are not set.
+ */
+void JPetScopeTask::calculateSignalProperties(std::vector<JPetRecoSignal>& signals)
+{
+  fWaveforms.clear();
+  for (const auto& sig : signals)
+  {
+    fWaveforms.addSignal(sig);
+  }
+  std::vector<float> baselines, amplitudes, charges, times;
+  fWaveforms.calculateBaselines(fBaselinePoints, baselines);
+  fWaveforms.calculateAmplitudes(baselines, amplitudes);
+  fWaveforms.calculateCharges(baselines, charges);
+  for (std::size_t i = 0; i < signals.size(); i++)
+  {
+    signals[i].setOffset(baselines[i]);
+    signals[i].setAmplitude(amplitudes[i]);
+    signals[i].setCharge(charges[i]);
+  }
+  fWaveforms.calculateConstantFractionTimes(baselines, amplitudes, fConstantFraction, times);
+  for (std::size_t i = 0; i < signals.size(); i++)
+  {
+    if (times[i] != JPetWaveformBatch::Unset)
+    {
+      signals[i].setRecoTimeAtThreshold(fConstantFraction, times[i]);
+    }
+  }
+  for (auto threshold : fThresholds)
+  {
+    fWaveforms.calculateThresholdTimes(baselines, threshold, times);
+    for (std::size_t i = 0; i < signals.size(); i++)
+    {
+      if (times[i] != JPetWaveformBatch::Unset)
+      {
+        signals[i].setRecoTimeAtThreshold(threshold, times[i]);
+      }
+    }
+  }
+}
+
 bool JPetScopeTask::terminate()
 {
   INFO("Scope Task finished");
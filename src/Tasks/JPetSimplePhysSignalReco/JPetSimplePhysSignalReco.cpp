@@ -19,45 +19,98 @@
 
 #include <boost/property_tree/json_parser.hpp>
 #include <cassert>
-#include <math.h>
 
-using namespace boost::numeric::ublas;
-
-JPetSimplePhysSignalReco::JPetSimplePhysSignalReco() : fAlpha(1), fThresholdSel(-1) { readConfigFileAndSetAlphaAndThreshParams("configParams.json"); }
+JPetSimplePhysSignalReco::JPetSimplePhysSignalReco(const char* name)
+    : JPetUserTask(name), fAlpha(1), fThresholdSel(-1), fFitter(fAlpha, fThresholdSel)
+{
+}
 
 JPetSimplePhysSignalReco::~JPetSimplePhysSignalReco() {}
 
-bool JPetSimplePhysSignalReco::exec() { return true; }
+bool JPetSimplePhysSignalReco::init()
+{
+  readConfigFileAndSetAlphaAndThreshParams("configParams.json");
+  fOutputEvents = new JPetTimeWindow("JPetPhysSignal");
+  return true;
+}
+
+bool JPetSimplePhysSignalReco::exec()
+{
+  if (auto timeWindow = dynamic_cast<const JPetTimeWindow*>(fEvent))
+  {
+    reconstructTimes(*timeWindow);
+    for (size_t i = 0; i < timeWindow->getNumberOfEvents(); i++)
+    {
+      fOutputEvents->add<JPetPhysSignal>(createPhysSignal(timeWindow->getEvent<JPetRecoSignal>(i), i));
+    }
+  }
+  return true;
+}
+
+bool JPetSimplePhysSignalReco::terminate() { return true; }
 
 void JPetSimplePhysSignalReco::savePhysSignal(JPetPhysSignal) {}
 
 /**
- * Simple example of creating JPetPhysSignal from JPetRecoSignal
+ * Fits the times of all signals in the time window in a single call of LeadingEdgeFitter::fitAll.
+ * Signals with less than two points on the leading or the trailing edge get an empty range
+ * of points, and their time is taken from the reconstructed times at thresholds.
+ * The leading-edge points of each signal are ordered by the threshold value.
  */
-JPetPhysSignal JPetSimplePhysSignalReco::createPhysSignal(JPetRecoSignal& recoSignal)
+void JPetSimplePhysSignalReco::reconstructTimes(const JPetTimeWindow& timeWindow)
+{
+  const auto nSignals = timeWindow.getNumberOfEvents();
+  fLeadingTimes.clear();
+  fLeadingThresholds.clear();
+  fSignalOffsets.clear();
+  fSignalOffsets.push_back(0);
+  for (size_t i = 0; i < nSignals; i++)
+  {
+    const auto& rawSignal = timeWindow.getEvent<JPetRecoSignal>(i).getRawSignal();
+    if (rawSignal.getNumberOfPoints(JPetSigCh::Leading) >= 2 && rawSignal.getNumberOfPoints(JPetSigCh::Trailing) >= 2)
+    {
+      const auto first = fLeadingTimes.size();
+      for (const auto& point : rawSignal.getUnsortedPoints(JPetSigCh::Leading))
+      {
+        auto thr = point.getThreshold();
+        auto time = point.getValue();
+        auto j = fLeadingTimes.size();
+        fLeadingTimes.push_back(time);
+        fLeadingThresholds.push_back(thr);
+        for (; j > first && fLeadingThresholds[j - 1] > thr; j--)
+        {
+          fLeadingTimes[j] = fLeadingTimes[j - 1];
+          fLeadingThresholds[j] = fLeadingThresholds[j - 1];
+        }
+        fLeadingTimes[j] = time;
+        fLeadingThresholds[j] = thr;
+      }
+    }
+    fSignalOffsets.push_back(fLeadingTimes.size());
+  }
+  fFittedTimes.resize(nSignals);
+  assert(fThresholdSel < 0);
+  assert(fAlpha > 0);
+  fFitter.fitAll(fLeadingTimes.data(), fLeadingThresholds.data(), fSignalOffsets.data(), nSignals, fFittedTimes.data());
+}
+
+/**
+ * Simple example of creating JPetPhysSignal from JPetRecoSignal,
+ * the time is taken from the results of the last reconstructTimes() call.
+ */
+JPetPhysSignal JPetSimplePhysSignalReco::createPhysSignal(const JPetRecoSignal& recoSignal, int signalIndex) const
 {
   JPetPhysSignal physSignal;
   physSignal.setPhe(recoSignal.getCharge() * 1.0 + 0.0);
   physSignal.setQualityOfPhe(1.0);
-  double time = recoSignal.getRecoTimesAtThreshold().begin()->second;
-  JPetRawSignal rawSignal = recoSignal.getRawSignal();
-
-  if (rawSignal.getNumberOfPoints(JPetSigCh::Leading) >= 2 && rawSignal.getNumberOfPoints(JPetSigCh::Trailing) >= 2)
+  double time = 0.0;
+  if (fSignalOffsets[signalIndex + 1] > fSignalOffsets[signalIndex])
   {
-    int iNumPoints = rawSignal.getNumberOfPoints(JPetSigCh::Leading);
-    std::vector<JPetSigCh> leadingPoints = rawSignal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrValue);
-    vector<float> vecTime(iNumPoints);
-    vector<float> vecVolt(iNumPoints);
-    for (int j = 0; j < iNumPoints; j++)
-    {
-      vecTime(j) = leadingPoints.at(j).getValue();
-      vecVolt(j) = leadingPoints.at(j).getThreshold();
-    }
-    int alfa = getAlpha();
-    float thr_sel = getThresholdSel();
-    assert(thr_sel < 0);
-    assert(alfa > 0);
-    time = static_cast<double>(polynomialFit(vecTime, vecVolt, alfa, thr_sel));
+    time = static_cast<double>(fFittedTimes[signalIndex]);
+  }
+  else if (!recoSignal.getRecoTimesAtThreshold().empty())
+  {
+    time = recoSignal.getRecoTimesAtThreshold().begin()->second;
   }
   physSignal.setTime(time);
   physSignal.setQualityOfTime(1.0);
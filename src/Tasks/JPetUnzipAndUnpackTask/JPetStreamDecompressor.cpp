@@ -0,0 +1,418 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStreamDecompressor.cpp
+ */
+
+#include "JPetUnzipAndUnpackTask/JPetStreamDecompressor.h"
+#include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetLoggerInclude.h"
+
+#include <bzlib.h>
+#include <cstdint>
+#include <lzma.h>
+#include <zlib.h>
+
+/**
+ * @brief Interface of a single decompression library wrapper
+ *
+ * process() decompresses as much as possible from the input to the output buffer,
+ * advancing both. kStreamEnd means that the end of one compressed stream was reached;
+ * the next concatenated stream (if any) is started with reset().
+ */
+class JPetStreamDecompressor::Codec
+{
+public:
+  enum Status
+  {
+    kOk,
+    kStreamEnd,
+    kError
+  };
+  virtual ~Codec() {}
+  virtual bool init(unsigned int nThreads, std::string& error) = 0;
+  virtual bool reset(std::string& error) = 0;
+  virtual Status process(const unsigned char*& in, std::size_t& availIn, unsigned char*& out, std::size_t& availOut, bool inputEnd,
+                         std::string& error) = 0;
+};
+
+namespace
+{
+using Codec = JPetStreamDecompressor::Codec;
+
+class GzipCodec : public Codec
+{
+public:
+  ~GzipCodec()
+  {
+    if (fInitialized)
+    {
+      inflateEnd(&fStream);
+    }
+  }
+
+  bool init(unsigned int, std::string& error) override
+  {
+    fStream = z_stream();
+    /// 15 + 32: maximal window size with automatic detection of the gzip or zlib header
+    if (inflateInit2(&fStream, 15 + 32) != Z_OK)
+    {
+      error = "zlib initialization failed";
+      return false;
+    }
+    fInitialized = true;
+    return true;
+  }
+
+  bool reset(std::string& error) override
+  {
+    if (inflateReset(&fStream) != Z_OK)
+    {
+      error = "zlib reset failed";
+      return false;
+    }
+    return true;
+  }
+
+  Status process(const unsigned char*& in, std::size_t& availIn, unsigned char*& out, std::size_t& availOut, bool,
+                 std::string& error) override
+  {
+    fStream.next_in = const_cast<Bytef*>(in);
+    fStream.avail_in = static_cast<uInt>(availIn);
+    fStream.next_out = out;
+    fStream.avail_out = static_cast<uInt>(availOut);
+    auto ret = inflate(&fStream, Z_NO_FLUSH);
+    in = fStream.next_in;
+    availIn = fStream.avail_in;
+    out = fStream.next_out;
+    availOut = fStream.avail_out;
+    switch (ret)
+    {
+    case Z_OK:
+    case Z_BUF_ERROR:
+      return kOk;
+    case Z_STREAM_END:
+      return kStreamEnd;
+    default:
+      error = std::string("zlib error: ") + (fStream.msg ? fStream.msg : std::to_string(ret));
+      return kError;
+    }
+  }
+
+private:
+  z_stream fStream;
+  bool fInitialized = false;
+};
+
+class Bzip2Codec : public Codec
+{
+public:
+  ~Bzip2Codec()
+  {
+    if (fInitialized)
+    {
+      BZ2_bzDecompressEnd(&fStream);
+    }
+  }
+
+  bool init(unsigned int, std::string& error) override
+  {
+    fStream = bz_stream();
+    if (BZ2_bzDecompressInit(&fStream, 0, 0) != BZ_OK)
+    {
+      error = "bzip2 initialization failed";
+      return false;
+    }
+    fInitialized = true;
+    return true;
+  }
+
+  bool reset(std::string& error) override
+  {
+    BZ2_bzDecompressEnd(&fStream);
+    fInitialized = false;
+    return init(1, error);
+  }
+
+  Status process(const unsigned char*& in, std::size_t& availIn, unsigned char*& out, std::size_t& availOut, bool,
+                 std::string& error) override
+  {
+    fStream.next_in = reinterpret_cast<char*>(const_cast<unsigned char*>(in));
+    fStream.avail_in = static_cast<unsigned int>(availIn);
+    fStream.next_out = reinterpret_cast<char*>(out);
+    fStream.avail_out = static_cast<unsigned int>(availOut);
+    auto ret = BZ2_bzDecompress(&fStream);
+    in = reinterpret_cast<const unsigned char*>(fStream.next_in);
+    availIn = fStream.avail_in;
+    out = reinterpret_cast<unsigned char*>(fStream.next_out);
+    availOut = fStream.avail_out;
+    switch (ret)
+    {
+    case BZ_OK:
+      return kOk;
+    case BZ_STREAM_END:
+      return kStreamEnd;
+    default:
+      error = "bzip2 error: " + std::to_string(ret);
+      return kError;
+    }
+  }
+
+private:
+  bz_stream fStream;
+  bool fInitialized = false;
+};
+
+class XzCodec : public Codec
+{
+public:
+  ~XzCodec() { lzma_end(&fStream); }
+
+  /// Concatenated .xz streams are handled by liblzma itself, so kStreamEnd
+  /// is returned only at the very end of the input.
+  bool init(unsigned int nThreads, std::string& error) override
+  {
+    fStream = LZMA_STREAM_INIT;
+    lzma_ret ret;
+#if LZMA_VERSION >= 50040002
+    if (nThreads > 1)
+    {
+      lzma_mt mt = lzma_mt();
+      mt.flags = LZMA_CONCATENATED;
+      mt.threads = nThreads;
+      mt.timeout = 0;
+      mt.memlimit_threading = lzma_physmem() / 4;
+      mt.memlimit_stop = UINT64_MAX;
+      ret = lzma_stream_decoder_mt(&fStream, &mt);
+    }
+    else
+    {
+      ret = lzma_stream_decoder(&fStream, UINT64_MAX, LZMA_CONCATENATED);
+    }
+#else
+    (void)nThreads;
+    ret = lzma_stream_decoder(&fStream, UINT64_MAX, LZMA_CONCATENATED);
+#endif
+    if (ret != LZMA_OK)
+    {
+      error = "liblzma initialization failed: " + std::to_string(ret);
+      return false;
+    }
+    return true;
+  }
+
+  bool reset(std::string& error) override
+  {
+    error = "unexpected data after the end of the xz stream";
+    return false;
+  }
+
+  Status process(const unsigned char*& in, std::size_t& availIn, unsigned char*& out, std::size_t& availOut, bool inputEnd,
+                 std::string& error) override
+  {
+    fStream.next_in = in;
+    fStream.avail_in = availIn;
+    fStream.next_out = out;
+    fStream.avail_out = availOut;
+    auto ret = lzma_code(&fStream, inputEnd ? LZMA_FINISH : LZMA_RUN);
+    in = fStream.next_in;
+    availIn = fStream.avail_in;
+    out = fStream.next_out;
+    availOut = fStream.avail_out;
+    switch (ret)
+    {
+    case LZMA_OK:
+    case LZMA_BUF_ERROR:
+      return kOk;
+    case LZMA_STREAM_END:
+      return kStreamEnd;
+    default:
+      error = "liblzma error: " + std::to_string(ret);
+      return kError;
+    }
+  }
+
+private:
+  lzma_stream fStream = LZMA_STREAM_INIT;
+};
+}
+
+const std::size_t JPetStreamDecompressor::kInputBufferSize;
+
+JPetStreamDecompressor::Format JPetStreamDecompressor::getFormat(const std::string& fileName)
+{
+  const auto suffix = JPetCommonTools::exctractFileNameSuffix(fileName);
+  if (suffix == ".gz")
+  {
+    return kGzip;
+  }
+  else if (suffix == ".xz")
+  {
+    return kXz;
+  }
+  else if (suffix == ".bz2")
+  {
+    return kBzip2;
+  }
+  return kUnknown;
+}
+
+JPetStreamDecompressor::JPetStreamDecompressor(const std::string& fileName, unsigned int nThreads) : fFileName(fileName)
+{
+  switch (getFormat(fileName))
+  {
+  case kGzip:
+    fCodec.reset(new GzipCodec());
+    break;
+  case kXz:
+    fCodec.reset(new XzCodec());
+    break;
+  case kBzip2:
+    fCodec.reset(new Bzip2Codec());
+    break;
+  default:
+    setError("Unsupported compression format");
+    return;
+  }
+  std::string error;
+  if (!fCodec->init(nThreads, error))
+  {
+    fCodec.reset();
+    setError(error);
+    return;
+  }
+  fInput = std::fopen(fileName.c_str(), "rb");
+  if (!fInput)
+  {
+    setError("Cannot open the file");
+    return;
+  }
+  fInputBuffer.resize(kInputBufferSize);
+}
+
+JPetStreamDecompressor::~JPetStreamDecompressor()
+{
+  if (fInput)
+  {
+    std::fclose(fInput);
+  }
+}
+
+/**
+ * Decompress up to size bytes into the buffer.
+ *
+ * @return number of bytes written; less than size only at the end of data or after an error
+ */
+std::size_t JPetStreamDecompressor::read(char* buffer, std::size_t size)
+{
+  if (!isOpen() || hasError())
+  {
+    return 0;
+  }
+  auto out = reinterpret_cast<unsigned char*>(buffer);
+  std::size_t availOut = size;
+  std::string error;
+  while (availOut > 0 && !fFinished)
+  {
+    if (fAvailIn == 0 && !fInputEnd)
+    {
+      auto nRead = std::fread(fInputBuffer.data(), 1, fInputBuffer.size(), fInput);
+      if (std::ferror(fInput))
+      {
+        setError("Read error");
+        break;
+      }
+      fNextIn = fInputBuffer.data();
+      fAvailIn = nRead;
+      fInputEnd = nRead < fInputBuffer.size() && std::feof(fInput);
+    }
+    if (fStreamEnded)
+    {
+      if (fAvailIn == 0 && fInputEnd)
+      {
+        fFinished = true;
+        break;
+      }
+      if (!fCodec->reset(error))
+      {
+        setError(error);
+        break;
+      }
+      fStreamEnded = false;
+    }
+    const auto availInBefore = fAvailIn;
+    const auto availOutBefore = availOut;
+    auto status = fCodec->process(fNextIn, fAvailIn, out, availOut, fInputEnd, error);
+    if (status == Codec::kError)
+    {
+      setError(error);
+      break;
+    }
+    if (status == Codec::kStreamEnd)
+    {
+      fStreamEnded = true;
+    }
+    else if (fInputEnd && fAvailIn == 0 && availInBefore == 0 && availOut == availOutBefore)
+    {
+      setError("Unexpected end of compressed data");
+      break;
+    }
+  }
+  if (fStreamEnded && fAvailIn == 0 && fInputEnd)
+  {
+    fFinished = true;
+  }
+  return size - availOut;
+}
+
+void JPetStreamDecompressor::setError(const std::string& message)
+{
+  fErrorMessage = message;
+  ERROR(message + " in file: " + fFileName);
+}
+
+/**
+ * Decompress the whole file to outFileName. The output file is removed on failure.
+ */
+bool JPetStreamDecompressor::decompressToFile(const std::string& inFileName, const std::string& outFileName, unsigned int nThreads)
+{
+  JPetStreamDecompressor decompressor(inFileName, nThreads);
+  if (!decompressor.isOpen())
+  {
+    return false;
+  }
+  std::FILE* output = std::fopen(outFileName.c_str(), "wb");
+  if (!output)
+  {
+    ERROR("Cannot open the output file: " + outFileName);
+    return false;
+  }
+  std::vector<char> buffer(kInputBufferSize);
+  bool writeOk = true;
+  while (!decompressor.isFinished() && !decompressor.hasError())
+  {
+    auto nBytes = decompressor.read(buffer.data(), buffer.size());
+    if (std::fwrite(buffer.data(), 1, nBytes, output) != nBytes)
+    {
+      ERROR("Write error in file: " + outFileName);
+      writeOk = false;
+      break;
+    }
+  }
+  writeOk = (std::fclose(output) == 0) && writeOk;
+  if (!writeOk || decompressor.hasError())
+  {
+    std::remove(outFileName.c_str());
+    return false;
+  }
+  return true;
+}
@@ -15,13 +15,119 @@
 
 #include "JPetUnzipAndUnpackTask/JPetUnzipAndUnpackTask.h"
 #include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetHLDLoader/JPetHLDIndex.h"
+#include "JPetHLDLoader/JPetHLDLoader.h"
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
 #include "JPetOptionsTools/JPetOptionsTools.h"
 #include "JPetParams/JPetParams.h"
+#include "JPetTaskIO/JPetTaskIOTools.h"
 #include "JPetUnpacker/JPetUnpacker.h"
+#include "JPetUnzipAndUnpackTask/JPetStreamDecompressor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fcntl.h>
+#include <functional>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <thread>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
 
 using namespace jpet_options_tools;
 
+namespace
+{
+/// Reads up to the given number of bytes; returns 0 at the end of data and -1 on error.
+using DataSource = std::function<long long(char*, std::size_t)>;
+
+/**
+ * Write the data to the named pipe until the end of data,
+ * or until the reader closes the pipe (e.g. after reading the requested number of events).
+ * Opening is retried until the reader appears or stopRequested is set,
+ * so that the writer does not block forever if the unpacker never opens the pipe.
+ */
+bool feedPipe(const DataSource& source, const std::string& pipeName, const std::atomic<bool>& stopRequested)
+{
+  /// SIGPIPE for a write is delivered to the writing thread; with the signal blocked,
+  /// write() fails with EPIPE instead of terminating the process.
+  sigset_t sigpipeMask;
+  sigemptyset(&sigpipeMask);
+  sigaddset(&sigpipeMask, SIGPIPE);
+  pthread_sigmask(SIG_BLOCK, &sigpipeMask, nullptr);
+
+  int fd = -1;
+  while (fd < 0)
+  {
+    fd = open(pipeName.c_str(), O_WRONLY | O_NONBLOCK);
+    if (fd < 0)
+    {
+      if (errno != ENXIO || stopRequested)
+      {
+        return errno == ENXIO;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+
+  std::vector<char> buffer(1 << 20);
+  long long nBytes = 0;
+  while ((nBytes = source(buffer.data(), buffer.size())) > 0)
+  {
+    long long written = 0;
+    while (written < nBytes)
+    {
+      auto ret = write(fd, buffer.data() + written, nBytes - written);
+      if (ret < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        bool status = errno == EPIPE;
+        if (!status)
+        {
+          ERROR("Error while writing data to: " + pipeName);
+        }
+        close(fd);
+        return status;
+      }
+      written += ret;
+    }
+  }
+  close(fd);
+  return nBytes == 0;
+}
+
+/**
+ * Create the named pipe, feed it from a separate thread and unpack the data read from it.
+ */
+bool unpackFromPipe(const DataSource& source, const std::string& pipeName, long long nevents, const std::string& configfile,
+                    const std::string& totCalibFile, const std::string& tdcCalibFile)
+{
+  if (mkfifo(pipeName.c_str(), S_IRUSR | S_IWUSR) != 0)
+  {
+    ERROR("Cannot create the named pipe: " + pipeName);
+    return false;
+  }
+  std::atomic<bool> stopRequested(false);
+  bool feedStatus = false;
+  std::thread feeder([&]() { feedStatus = feedPipe(source, pipeName, stopRequested); });
+  bool unpackStatus = JPetUnzipAndUnpackTask::unpackFile(pipeName, nevents, configfile, totCalibFile, tdcCalibFile);
+  stopRequested = true;
+  feeder.join();
+  boost::filesystem::remove(pipeName);
+  return unpackStatus && feedStatus;
+}
+}
+
 JPetUnzipAndUnpackTask::JPetUnzipAndUnpackTask(const char* name) : JPetTask(name), fUnpackHappened(false) {}
 
 bool JPetUnzipAndUnpackTask::init(const JPetParams& inParams)
@@ -61,6 +167,20 @@ bool JPetUnzipAndUnpackTask::init(const JPetParams& inParams)
     WARNING("No file with TDC nonlinearity calibration was provided by the user.");
   }
 
+  if (isOptionSet(inParams.getOptions(), kStreamDecompressionKey))
+  {
+    fStreamDecompression = getOptionAsBool(inParams.getOptions(), kStreamDecompressionKey);
+  }
+  if (isOptionSet(inParams.getOptions(), kHLDIndexKey))
+  {
+    fUseHLDIndex = getOptionAsBool(inParams.getOptions(), kHLDIndexKey);
+  }
+  fDecompressionThreads = std::max(1u, std::thread::hardware_concurrency());
+  if (isOptionSet(inParams.getOptions(), kDecompressionThreadsKey))
+  {
+    fDecompressionThreads = std::max(1, getOptionAsInt(inParams.getOptions(), kDecompressionThreadsKey));
+  }
+
   return true;
 }
 
@@ -74,16 +194,52 @@ bool JPetUnzipAndUnpackTask::run(const JPetDataInterface&)
 
   bool runStatus = false;
 
+  if (JPetHLDLoader::isNativeDecodingOn(fOptions))
+  {
+    INFO("File " + inputFile + " will be decoded directly by JPetHLDLoader, the unpacker is not used");
+    return true;
+  }
+
   switch (inputFileType)
   {
   case FileTypeChecker::kHld:
+    if (getNumberOfShards(fOptions) > 1)
+    {
+      runStatus = unpackShard(inputFile, unpackerConfigFile);
+      fUnpackHappened = true;
+      fIsRangeUnpacked = true;
+      break;
+    }
+    /// the last event not set (-1) means the end of the file
+    if (fUseHLDIndex && getFirstEvent(fOptions) > 0)
+    {
+      runStatus = unpackFileRange(inputFile, getUnpackedFileName(), getFirstEvent(fOptions), getLastEvent(fOptions), unpackerConfigFile,
+                                  fTOToffsetCalibFile, fTDCnonlinearityCalibFile);
+      fUnpackHappened = true;
+      fIsRangeUnpacked = true;
+      break;
+    }
     INFO("Unpacking file " + inputFile);
     runStatus = unpackFile(inputFile, getTotalEvents(fOptions), unpackerConfigFile, fTOToffsetCalibFile, fTDCnonlinearityCalibFile);
     fUnpackHappened = true;
     break;
   case FileTypeChecker::kZip:
+    if (getNumberOfShards(fOptions) > 1)
+    {
+      ERROR("Unpacking a shard of the hld file requires its index, which is available only for the plain hld files");
+      runStatus = false;
+      break;
+    }
+    if (fStreamDecompression && JPetStreamDecompressor::getFormat(inputFile) != JPetStreamDecompressor::kUnknown)
+    {
+      INFO("Unpacking file " + inputFile + " with streamed decompression");
+      runStatus = unzipAndUnpackFile(inputFile, getTotalEvents(fOptions), unpackerConfigFile, fTOToffsetCalibFile, fTDCnonlinearityCalibFile,
+                                     fDecompressionThreads);
+      fUnpackHappened = true;
+      break;
+    }
     INFO("Unzipping file before unpacking, file name: " + inputFile);
-    runStatus = unzipFile(inputFile);
+    runStatus = unzipFile(inputFile, fDecompressionThreads);
     if (!runStatus)
     {
       ERROR("Problem with unzipping file: " + inputFile);
@@ -122,33 +278,194 @@ bool JPetUnzipAndUnpackTask::terminate(JPetParams& outParams)
   {
     OptsStrAny new_opts;
     jpet_options_generator_tools::setOutputFileType(new_opts, "hldRoot");
-    if (jpet_options_tools::isOptionSet(fOptions, "firstEvent_int") && jpet_options_tools::isOptionSet(fOptions, "lastEvent_int"))
+    /// the output of the range unpacking starts with the first requested event
+    if (fIsRangeUnpacked)
+    {
+      jpet_options_generator_tools::setResetEventRangeOption(new_opts, true);
+    }
+    else if (jpet_options_tools::isOptionSet(fOptions, "firstEvent_int") && jpet_options_tools::isOptionSet(fOptions, "lastEvent_int"))
     {
       if (jpet_options_tools::getOptionAsInt(fOptions, "firstEvent_int") != -1 && jpet_options_tools::getOptionAsInt(fOptions, "lastEvent_int") != -1)
       {
         jpet_options_generator_tools::setResetEventRangeOption(new_opts, true);
       }
     }
-    jpet_options_generator_tools::setOutputFile(new_opts, JPetCommonTools::replaceDataTypeInFileName(getInputFile(fOptions), "hld"));
+    jpet_options_generator_tools::setOutputFile(new_opts, getUnpackedFileName());
     outParams = JPetParams(new_opts, outParams.getParamManagerAsShared());
   }
   return true;
 }
 
-bool JPetUnzipAndUnpackTask::unzipFile(const std::string& filename)
+/**
+ * Decompress the file next to the input, keeping the input file.
+ * Zip archives are still extracted with the external unzip program.
+ */
+bool JPetUnzipAndUnpackTask::unzipFile(const std::string& filename, unsigned int nThreads)
 {
-  if (JPetCommonTools::exctractFileNameSuffix(filename) == ".gz")
-    return !(system((std::string("gzip -dk ") + std::string(filename)).c_str()));
-  else if (JPetCommonTools::exctractFileNameSuffix(filename) == ".xz")
-    return !(system((std::string("xz -dk ") + std::string(filename)).c_str()));
-  else if (JPetCommonTools::exctractFileNameSuffix(filename) == ".bz2")
-    return !(system((std::string("bzip2 -dk ") + std::string(filename)).c_str()));
+  if (JPetStreamDecompressor::getFormat(filename) != JPetStreamDecompressor::kUnknown)
+  {
+    const auto unzippedFilename = JPetCommonTools::stripFileNameSuffix(filename);
+    if (boost::filesystem::exists(unzippedFilename))
+    {
+      ERROR("Unzipped file already exists: " + unzippedFilename);
+      return false;
+    }
+    return JPetStreamDecompressor::decompressToFile(filename, unzippedFilename, nThreads);
+  }
   else if (JPetCommonTools::exctractFileNameSuffix(filename) == ".zip")
     return !(system((std::string("unzip ") + std::string(filename)).c_str()));
   else
     return false;
 }
 
+/**
+ * Unpack the compressed file without storing the decompressed data on disk.
+ * A named pipe is created with the name of the unzipped file (so that the unpacker
+ * output gets the same name as for a regular hld file) and fed from a separate thread,
+ * so decompression and unpacking run concurrently.
+ */
+bool JPetUnzipAndUnpackTask::unzipAndUnpackFile(const std::string& filename, long long nevents, const std::string& configfile,
+                                                const std::string& totCalibFile, const std::string& tdcCalibFile, unsigned int nThreads)
+{
+  const auto pipeName = JPetCommonTools::stripFileNameSuffix(filename);
+  if (boost::filesystem::exists(pipeName))
+  {
+    ERROR("Unzipped file already exists: " + pipeName);
+    return false;
+  }
+  JPetStreamDecompressor decompressor(filename, nThreads);
+  if (!decompressor.isOpen())
+  {
+    return false;
+  }
+  DataSource source = [&decompressor](char* buffer, std::size_t size) -> long long {
+    while (!decompressor.isFinished() && !decompressor.hasError())
+    {
+      auto nBytes = decompressor.read(buffer, size);
+      if (nBytes > 0)
+      {
+        return nBytes;
+      }
+    }
+    return decompressor.hasError() ? -1 : 0;
+  };
+  return unpackFromPipe(source, pipeName, nevents, configfile, totCalibFile, tdcCalibFile);
+}
+
+/**
+ * Name of the unpacker output. If only a shard of the hld file is unpacked,
+ * the shard is added to the name, so the outputs of the shards do not overwrite each other.
+ */
+std::string JPetUnzipAndUnpackTask::getUnpackedFileName() const
+{
+  auto fileName = JPetCommonTools::replaceDataTypeInFileName(getInputFile(fOptions), "hld");
+  if (getNumberOfShards(fOptions) > 1)
+  {
+    fileName = JPetTaskIOTools::addShardToFileName(fileName, getShardIndex(fOptions), getNumberOfShards(fOptions));
+  }
+  return fileName;
+}
+
+/**
+ * Unpack only the events of the shard selected with the -s option, within the user range of events,
+ * so the shards of one hld file can be unpacked by separate processes at the same time.
+ */
+bool JPetUnzipAndUnpackTask::unpackShard(const std::string& filename, const std::string& configfile) const
+{
+  if (!fUseHLDIndex)
+  {
+    ERROR("Unpacking a shard of the hld file requires its index, " + kHLDIndexKey + " cannot be set to false");
+    return false;
+  }
+  JPetHLDIndex index;
+  if (!index.loadOrBuild(filename))
+  {
+    return false;
+  }
+  bool isRangeOK = false;
+  long long firstEvent = -1;
+  long long lastEvent = -1;
+  std::tie(isRangeOK, firstEvent, lastEvent) = JPetTaskIOTools::setUserLimits(fOptions, index.getNumberOfEvents());
+  if (!isRangeOK)
+  {
+    return false;
+  }
+  return unpackFileRange(filename, getUnpackedFileName(), firstEvent, lastEvent, configfile, fTOToffsetCalibFile, fTDCnonlinearityCalibFile);
+}
+
+/**
+ * Unpack the events from firstEvent to lastEvent (inclusive) of the plain hld file,
+ * starting directly at the first requested event found with JPetHLDIndex.
+ * The byte range of the events is fed to the unpacker through a named pipe with the same
+ * file name as the input, created in a temporary directory, and the unpacker output
+ * is moved to outputFile afterwards.
+ */
+bool JPetUnzipAndUnpackTask::unpackFileRange(const std::string& filename, const std::string& outputFile, long long firstEvent,
+                                             long long lastEvent, const std::string& configfile, const std::string& totCalibFile,
+                                             const std::string& tdcCalibFile)
+{
+  JPetHLDIndex index;
+  if (!index.loadOrBuild(filename))
+  {
+    return false;
+  }
+  auto range = index.getRange(firstEvent, lastEvent);
+  if (range.firstEvent > range.lastEvent)
+  {
+    ERROR("The hld file " + filename + " contains less events than the first requested event");
+    return false;
+  }
+  std::FILE* file = std::fopen(filename.c_str(), "rb");
+  if (!file || fseeko(file, static_cast<off_t>(range.beginOffset), SEEK_SET) != 0)
+  {
+    ERROR("Cannot read the hld file: " + filename);
+    if (file)
+    {
+      std::fclose(file);
+    }
+    return false;
+  }
+  auto remaining = range.endOffset - range.beginOffset;
+  DataSource source = [file, &remaining](char* buffer, std::size_t size) -> long long {
+    auto nBytes = std::fread(buffer, 1, std::min<std::uint64_t>(size, remaining), file);
+    remaining -= nBytes;
+    if (nBytes == 0 && remaining > 0)
+    {
+      return -1;
+    }
+    return nBytes;
+  };
+
+  boost::system::error_code ec;
+  auto tmpDir = boost::filesystem::temp_directory_path(ec) / boost::filesystem::unique_path();
+  if (ec || !boost::filesystem::create_directory(tmpDir, ec))
+  {
+    ERROR("Cannot create a temporary directory for the named pipe");
+    std::fclose(file);
+    return false;
+  }
+  const auto pipeName = (tmpDir / boost::filesystem::path(filename).filename()).string();
+  INFO("Unpacking events " + std::to_string(range.firstEvent) + " - " + std::to_string(range.lastEvent) + " starting at byte "
+       + std::to_string(range.beginOffset) + " of file " + filename);
+  bool status = unpackFromPipe(source, pipeName, range.lastEvent - range.firstEvent + 1, configfile, totCalibFile, tdcCalibFile);
+  std::fclose(file);
+  if (status)
+  {
+    boost::filesystem::rename(pipeName + ".root", outputFile, ec);
+    if (ec)
+    {
+      boost::filesystem::copy_file(pipeName + ".root", outputFile, boost::filesystem::copy_option::overwrite_if_exists, ec);
+    }
+    if (ec)
+    {
+      ERROR("Cannot move the unpacker output to: " + outputFile + " " + ec.message());
+      status = false;
+    }
+  }
+  boost::filesystem::remove_all(tmpDir, ec);
+  return status;
+}
+
 bool JPetUnzipAndUnpackTask::unpackFile(const std::string& filename, long long nevents, const std::string& configfile = "",
                                         const std::string& totCalibFile = "", const std::string& tdcCalibFile = "")
 {
@@ -156,8 +473,7 @@ bool JPetUnzipAndUnpackTask::unpackFile(const std::string& filename, long long n
   if (nevents > 0)
   {
     unpacker.setParams(filename, nevents, configfile, totCalibFile, tdcCalibFile);
-    WARNING(std::string("Even though the range of events was set, only the first ") + JPetCommonTools::intToString(nevents) +
-            std::string(" will be unpacked by the unpacker. \n The unpacker always starts from the beginning of the file."));
+    WARNING(std::string("Only the first ") + JPetCommonTools::intToString(nevents) + std::string(" events will be unpacked by the unpacker."));
   }
   else
   {
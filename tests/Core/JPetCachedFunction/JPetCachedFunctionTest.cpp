@@ -3,7 +3,9 @@
 
 #include "JPetCachedFunction/JPetCachedFunction.h"
 #include "JPetLoggerInclude.h"
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <thread>
 
 using namespace jpet_common_tools;
 /// Returns Time-over-threshold for given deposited energy
@@ -64,4 +66,69 @@ BOOST_AUTO_TEST_CASE(cached_2D)
   BOOST_CHECK_CLOSE(func(1., 0.), 2., 0.1);
 }
 
+BOOST_AUTO_TEST_CASE(cacheStore_keys)
+{
+  JPetCachedFunctionParams params("pol1", { -91958., 19341.});
+  JPetCachedFunctionParams otherParams("pol1", { -91958., 19341.0001});
+  auto key = JPetCachedFunctionStore::generateKey(params, {Range(100, 0., 100.)});
+  BOOST_CHECK_EQUAL(key, JPetCachedFunctionStore::generateKey(params, {Range(100, 0., 100.)}));
+  BOOST_CHECK(key != JPetCachedFunctionStore::generateKey(otherParams, {Range(100, 0., 100.)}));
+  BOOST_CHECK(key != JPetCachedFunctionStore::generateKey(params, {Range(101, 0., 100.)}));
+  BOOST_CHECK(key != JPetCachedFunctionStore::generateKey(params, {Range(100, 0., 100.), Range(100, 0., 100.)}));
+}
+
+BOOST_AUTO_TEST_CASE(cacheStore_saveAndLoad)
+{
+  auto dir = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  JPetCachedFunctionStore::setCacheDirectory(dir);
+  BOOST_CHECK(JPetCachedFunctionStore::isEnabled());
+  std::vector<double> values = {1., 2.5, -3.};
+  std::vector<double> loaded;
+  BOOST_CHECK(!JPetCachedFunctionStore::load("someKey", values.size(), loaded));
+  BOOST_CHECK(JPetCachedFunctionStore::save("someKey", values));
+  BOOST_CHECK(JPetCachedFunctionStore::load("someKey", values.size(), loaded));
+  BOOST_CHECK(values == loaded);
+  BOOST_CHECK(!JPetCachedFunctionStore::load("someKey", values.size() + 1, loaded));
+  BOOST_CHECK(!JPetCachedFunctionStore::load("otherKey", values.size(), loaded));
+  JPetCachedFunctionStore::setCacheDirectory("");
+  BOOST_CHECK(!JPetCachedFunctionStore::isEnabled());
+  boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(cached_2D_fromCache)
+{
+  auto dir = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  JPetCachedFunctionStore::setCacheDirectory(dir);
+  JPetCachedFunctionParams params("[0] + [1] * x  + [2] * y", {1., 1., 2.}); /// 1 + x + 2 * y
+  JPetCachedFunction2D func(params, Range(100, 0., 100.), Range(100, 0., 100.));
+  auto key = JPetCachedFunctionStore::generateKey(params, {Range(100, 0., 100.), Range(100, 0., 100.)});
+  BOOST_CHECK(boost::filesystem::exists(JPetCachedFunctionStore::generateFileName(key)));
+  JPetCachedFunction2D funcFromCache(params, Range(100, 0., 100.), Range(100, 0., 100.));
+  BOOST_CHECK(funcFromCache.getParams().fValidFunction);
+  BOOST_CHECK(func.getValues() == funcFromCache.getValues());
+  BOOST_CHECK_CLOSE(funcFromCache(1, 1.), 4., 0.1);
+  JPetCachedFunctionStore::setCacheDirectory("");
+  boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(cacheStore_directoryScope)
+{
+  JPetCachedFunctionStore::setCacheDirectory("processDir");
+  {
+    JPetCachedFunctionStore::DirectoryScope scope("taskDir");
+    BOOST_CHECK_EQUAL(JPetCachedFunctionStore::getCacheDirectory(), "taskDir");
+    {
+      JPetCachedFunctionStore::DirectoryScope innerScope("innerTaskDir");
+      BOOST_CHECK_EQUAL(JPetCachedFunctionStore::getCacheDirectory(), "innerTaskDir");
+    }
+    BOOST_CHECK_EQUAL(JPetCachedFunctionStore::getCacheDirectory(), "taskDir");
+    std::string directoryInOtherThread;
+    std::thread other([&directoryInOtherThread]() { directoryInOtherThread = JPetCachedFunctionStore::getCacheDirectory(); });
+    other.join();
+    BOOST_CHECK_EQUAL(directoryInOtherThread, "processDir");
+  }
+  BOOST_CHECK_EQUAL(JPetCachedFunctionStore::getCacheDirectory(), "processDir");
+  JPetCachedFunctionStore::setCacheDirectory("");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetLoggerTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetLoggerTest
+#undef JPET_LOG_MIN_LEVEL
+#define JPET_LOG_MIN_LEVEL 3
+
+#include "JPetLoggerInclude.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+int evaluations = 0;
+
+std::string countedMessage(const std::string& message)
+{
+  evaluations++;
+  return message;
+}
+
+/// Number of occurrences of the text in all the log files in the current directory.
+int countInLogFiles(const std::string& text)
+{
+  int count = 0;
+  for (const auto& entry : boost::filesystem::directory_iterator("."))
+  {
+    auto name = entry.path().filename().string();
+    if (name.find("JPet_") != 0 || entry.path().extension() != ".log")
+    {
+      continue;
+    }
+    std::ifstream in(entry.path().string());
+    std::string line;
+    while (std::getline(in, line))
+    {
+      if (line.find(text) != std::string::npos)
+      {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(JPetLoggerTestSuite)
+
+BOOST_AUTO_TEST_CASE(levelsBelowMinimumAreStripped)
+{
+  evaluations = 0;
+  DEBUG(countedMessage("stripped debug"));
+  INFO(countedMessage("stripped info"));
+  BOOST_REQUIRE_EQUAL(evaluations, 0);
+  WARNING(countedMessage("kept warning"));
+  BOOST_REQUIRE_EQUAL(evaluations, 1);
+}
+
+BOOST_AUTO_TEST_CASE(runtimeLevel)
+{
+  BOOST_REQUIRE(JPetLogger::isLevelEnabled(boost::log::trivial::error));
+  SET_MINIMAL_LOG_ERROR();
+  BOOST_REQUIRE(!JPetLogger::isLevelEnabled(boost::log::trivial::warning));
+  evaluations = 0;
+  WARNING(countedMessage("filtered warning"));
+  BOOST_REQUIRE_EQUAL(evaluations, 0);
+  SET_MINIMAL_LOG_INFO();
+  BOOST_REQUIRE(JPetLogger::isLevelEnabled(boost::log::trivial::warning));
+  BOOST_REQUIRE(!JPetLogger::isLevelEnabled(boost::log::trivial::debug));
+}
+
+BOOST_AUTO_TEST_CASE(asynchronousRecordsAreFlushed)
+{
+  FLUSH_LOG();
+  int before = countInLogFiles("JPetLoggerTest thread ");
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back([i]() {
+      for (int j = 0; j < 100; j++)
+      {
+        std::ostringstream message;
+        message << "JPetLoggerTest thread " << i << " message " << j;
+        ERROR(message.str());
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  FLUSH_LOG();
+  BOOST_REQUIRE_EQUAL(countInLogFiles("JPetLoggerTest thread ") - before, 400);
+}
+
+BOOST_AUTO_TEST_CASE(repetitionsAreSuppressed)
+{
+  FLUSH_LOG();
+  int messagesBefore = countInLogFiles("JPetLoggerTest repeated message");
+  int repetitionsBefore = countInLogFiles("The last message repeated 9 times");
+  for (int i = 0; i < 10; i++)
+  {
+    ERROR("JPetLoggerTest repeated message");
+  }
+  ERROR("JPetLoggerTest other message");
+  FLUSH_LOG();
+  BOOST_REQUIRE_EQUAL(countInLogFiles("JPetLoggerTest repeated message") - messagesBefore, 1);
+  BOOST_REQUIRE_EQUAL(countInLogFiles("The last message repeated 9 times") - repetitionsBefore, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
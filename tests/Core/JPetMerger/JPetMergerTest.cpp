@@ -0,0 +1,121 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetMergerTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetMergerTest
+#include "JPetMerger/JPetMerger.h"
+#include "JPetParamBank/JPetParamBank.h"
+#include "JPetReader/JPetReader.h"
+#include "JPetTaskIO/JPetTaskIOTools.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetTreeHeader/JPetTreeHeader.h"
+
+#include <TH1F.h>
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(JPetMergerTestSuite)
+
+BOOST_AUTO_TEST_CASE(parseShard)
+{
+  JPetTreeHeader header;
+  int shardIndex = -1;
+  int numberOfShards = 0;
+  BOOST_REQUIRE(!JPetMerger::parseShard(header, shardIndex, numberOfShards));
+  header.setVariable(JPetTaskIOTools::kShardHeaderVariable, "3/16");
+  BOOST_REQUIRE(JPetMerger::parseShard(header, shardIndex, numberOfShards));
+  BOOST_REQUIRE_EQUAL(shardIndex, 3);
+  BOOST_REQUIRE_EQUAL(numberOfShards, 16);
+}
+
+BOOST_AUTO_TEST_CASE(areSameHistories)
+{
+  JPetTreeHeader first;
+  JPetTreeHeader second;
+  first.addStageInfo("TimeWindowCreator", "", 0, "Mon Jan 1 10:00:00 2020");
+  second.addStageInfo("TimeWindowCreator", "", 0, "Mon Jan 1 10:05:00 2020");
+  BOOST_REQUIRE(JPetMerger::areSameHistories(first, second));
+  second.addStageInfo("SignalFinder", "", 0, "Mon Jan 1 10:06:00 2020");
+  BOOST_REQUIRE(!JPetMerger::areSameHistories(first, second));
+}
+
+BOOST_AUTO_TEST_CASE(areSameParamBanks)
+{
+  JPetParamBank first;
+  JPetParamBank second;
+  first.addScintillator(JPetScin(1, 2.f, 50.f, 1.9f, 0.7f));
+  second.addScintillator(JPetScin(1, 2.f, 50.f, 1.9f, 0.7f));
+  first.addTRB(JPetTRB(1, 2, 3));
+  second.addTRB(JPetTRB(1, 2, 3));
+  BOOST_REQUIRE(JPetMerger::areSameParamBanks(first, second));
+
+  JPetParamBank otherScin;
+  otherScin.addScintillator(JPetScin(1, 2.f, 30.f, 1.9f, 0.7f));
+  otherScin.addTRB(JPetTRB(1, 2, 3));
+  BOOST_REQUIRE(!JPetMerger::areSameParamBanks(first, otherScin));
+
+  JPetParamBank otherTRB;
+  otherTRB.addScintillator(JPetScin(1, 2.f, 50.f, 1.9f, 0.7f));
+  otherTRB.addTRB(JPetTRB(1, 2, 4));
+  BOOST_REQUIRE(!JPetMerger::areSameParamBanks(first, otherTRB));
+
+  JPetParamBank otherID;
+  otherID.addScintillator(JPetScin(2, 2.f, 50.f, 1.9f, 0.7f));
+  otherID.addTRB(JPetTRB(1, 2, 3));
+  BOOST_REQUIRE(!JPetMerger::areSameParamBanks(first, otherID));
+}
+
+BOOST_AUTO_TEST_CASE(mergeObject)
+{
+  TH1F first("h", "h", 10, 0, 10);
+  TH1F second("h", "h", 10, 0, 10);
+  first.Fill(1);
+  second.Fill(1);
+  second.Fill(5);
+  BOOST_REQUIRE(JPetMerger::mergeObject(&first, &second));
+  BOOST_REQUIRE_EQUAL(first.GetEntries(), 3);
+  BOOST_REQUIRE_EQUAL(first.GetBinContent(first.FindBin(1)), 2);
+  JPetParamBank bank;
+  BOOST_REQUIRE(!JPetMerger::mergeObject(&first, &bank));
+}
+
+BOOST_AUTO_TEST_CASE(mergeFiles)
+{
+  std::string firstFileName = "unitTestData/JPetHaddTest/single_link_def/dabc_17237091818.hadd.test.root";
+  std::string secondFileName = "unitTestData/JPetHaddTest/single_link_def/dabc_17237093844.hadd.test.root";
+  std::string mergedFileName = "unitTestData/JPetHaddTest/merged.hadd.test.root";
+  JPetMerger merger(2);
+  BOOST_REQUIRE(merger.merge({firstFileName, secondFileName}, mergedFileName));
+
+  JPetReader readerFirstFile(firstFileName.c_str());
+  JPetReader readerSecondFile(secondFileName.c_str());
+  JPetReader readerMergedFile(mergedFileName.c_str());
+  BOOST_REQUIRE(readerMergedFile.isOpen());
+  BOOST_REQUIRE_EQUAL(readerMergedFile.getNbOfAllEntries(), readerFirstFile.getNbOfAllEntries() + readerSecondFile.getNbOfAllEntries());
+  const auto& mergedTimeWindow = static_cast<const JPetTimeWindow&>(readerMergedFile.getCurrentEntry());
+  const auto& firstTimeWindow = static_cast<const JPetTimeWindow&>(readerFirstFile.getCurrentEntry());
+  BOOST_REQUIRE_EQUAL(mergedTimeWindow.getNumberOfEvents(), firstTimeWindow.getNumberOfEvents());
+  const auto mergedParamBank = readerMergedFile.getObjectFromFile("ParamBank;1");
+  BOOST_REQUIRE(mergedParamBank);
+  delete mergedParamBank;
+}
+
+BOOST_AUTO_TEST_CASE(missingFile)
+{
+  JPetMerger merger;
+  BOOST_REQUIRE(!merger.merge({"unitTestData/JPetHaddTest/nonExistingFile.root"}, "unitTestData/JPetHaddTest/merged_missing.hadd.test.root"));
+  BOOST_REQUIRE(!merger.merge({}, "unitTestData/JPetHaddTest/merged_missing.hadd.test.root"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
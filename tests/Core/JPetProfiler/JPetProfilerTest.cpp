@@ -0,0 +1,82 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetProfilerTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetProfilerTest
+
+#include "JPetProfiler/JPetProfiler.h"
+
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(JPetProfilerTestSuite)
+
+BOOST_AUTO_TEST_CASE(binning)
+{
+  auto edges = JPetProfiler::getBinEdges();
+  BOOST_REQUIRE_EQUAL(edges.size(), static_cast<std::size_t>(JPetProfiler::kNumberOfBins + 1));
+  BOOST_REQUIRE_CLOSE(edges.front(), 1e-8, 1e-6);
+  BOOST_REQUIRE_CLOSE(edges.back(), 100.0, 1e-6);
+  BOOST_REQUIRE_EQUAL(JPetProfiler::getBin(0.0), 0);
+  BOOST_REQUIRE_EQUAL(JPetProfiler::getBin(1.1e-8), 1);
+  BOOST_REQUIRE_EQUAL(JPetProfiler::getBin(1.1e-7), 1 + JPetProfiler::kBinsPerDecade);
+  BOOST_REQUIRE_EQUAL(JPetProfiler::getBin(1000.0), JPetProfiler::kNumberOfBins + 1);
+}
+
+BOOST_AUTO_TEST_CASE(statistics)
+{
+  JPetProfiler profiler("task");
+  for (int i = 1; i <= 100; i++)
+  {
+    profiler.add(JPetProfiler::kEvent, i * 1e-6);
+  }
+  profiler.add(JPetProfiler::kRun, 0.5);
+  const auto& event = profiler.getStage(JPetProfiler::kEvent);
+  BOOST_REQUIRE_EQUAL(event.count, 100);
+  BOOST_REQUIRE_CLOSE(event.totalSeconds, 5050e-6, 1e-6);
+  BOOST_REQUIRE_CLOSE(event.minSeconds, 1e-6, 1e-6);
+  BOOST_REQUIRE_CLOSE(event.maxSeconds, 100e-6, 1e-6);
+  BOOST_REQUIRE_EQUAL(profiler.getNumberOfEvents(), 100);
+  BOOST_REQUIRE_CLOSE(profiler.getThroughput(), 200.0, 1e-6);
+  /// the bins are 26% wide
+  BOOST_REQUIRE_CLOSE(profiler.getQuantile(JPetProfiler::kEvent, 0.5), 50e-6, 26.0);
+  BOOST_REQUIRE_CLOSE(profiler.getQuantile(JPetProfiler::kEvent, 0.99), 99e-6, 26.0);
+  BOOST_REQUIRE_CLOSE(profiler.getQuantile(JPetProfiler::kEvent, 1.0), 100e-6, 1e-6);
+  BOOST_REQUIRE_EQUAL(profiler.getQuantile(JPetProfiler::kWrite, 0.5), 0.0);
+
+  auto json = profiler.toJSON();
+  BOOST_REQUIRE(json.find("\"name\": \"task\"") != std::string::npos);
+  BOOST_REQUIRE(json.find("\"event\": {\"count\": 100") != std::string::npos);
+  BOOST_REQUIRE(json.find("\"write\"") == std::string::npos);
+
+  profiler.reset();
+  BOOST_REQUIRE_EQUAL(profiler.getNumberOfEvents(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(scope)
+{
+  JPetProfiler profiler;
+  {
+    JPetProfiler::Scope scope(&profiler, JPetProfiler::kInit);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  {
+    JPetProfiler::Scope scope(nullptr, JPetProfiler::kInit);
+  }
+  BOOST_REQUIRE_EQUAL(profiler.getStage(JPetProfiler::kInit).count, 1);
+  BOOST_REQUIRE_GE(profiler.getStage(JPetProfiler::kInit).totalSeconds, 0.002);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -18,6 +18,7 @@
 #include "JPetProgressBarManager/JPetProgressBarManager.h"
 
 #include <boost/test/unit_test.hpp>
+#include <sstream>
 
 BOOST_AUTO_TEST_SUITE(FirstSuite)
 
@@ -31,4 +32,55 @@ BOOST_AUTO_TEST_CASE(progressBarTest)
   BOOST_REQUIRE_EQUAL(bar.getCurrentValue(0, 2), 0);
 }
 
+BOOST_AUTO_TEST_CASE(formatting)
+{
+  BOOST_REQUIRE_EQUAL(JPetProgressReporter::formatRate(12.34), "12.3 ev/s");
+  BOOST_REQUIRE_EQUAL(JPetProgressReporter::formatRate(12345.0), "12.3k ev/s");
+  BOOST_REQUIRE_EQUAL(JPetProgressReporter::formatRate(2.5e6), "2.5M ev/s");
+  BOOST_REQUIRE_EQUAL(JPetProgressReporter::formatDuration(3725.2), "1:02:05");
+  BOOST_REQUIRE_EQUAL(JPetProgressReporter::formatDuration(0.0), "0:00:00");
+}
+
+BOOST_AUTO_TEST_CASE(reporterRendersJobs)
+{
+  std::ostringstream output;
+  auto& reporter = JPetProgressReporter::getInstance();
+  reporter.setOutput(&output);
+  reporter.setInterval(std::chrono::milliseconds(10000));
+  auto first = reporter.startJob("first", 1000);
+  auto second = reporter.startJob("second", 0);
+  first->update(500);
+  second->update(100);
+  auto line = reporter.render(JPetProgressReporter::Clock::now() + std::chrono::seconds(1));
+  BOOST_REQUIRE(line.find("first 50.0%") != std::string::npos);
+  BOOST_REQUIRE(line.find("ETA") != std::string::npos);
+  BOOST_REQUIRE(line.find("second 100.0 ev/s") != std::string::npos || line.find("second 99.") != std::string::npos);
+  BOOST_REQUIRE(line.find("| total") != std::string::npos);
+  BOOST_REQUIRE_CLOSE(first->getRate(), 500.0, 1.0);
+
+  reporter.finishJob(first);
+  reporter.finishJob(second);
+  reporter.waitUntilIdle();
+  reporter.setOutput(nullptr);
+  BOOST_REQUIRE(output.str().find('\n') != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(progressBarJob)
+{
+  std::ostringstream output;
+  JPetProgressReporter::getInstance().setOutput(&output);
+  JPetProgressReporter::getInstance().setInterval(std::chrono::milliseconds(1));
+  JPetProgressBarManager bar;
+  bar.startJob("task file.root", 10);
+  for (int i = 1; i <= 10; i++)
+  {
+    bar.update(i);
+  }
+  bar.finishJob();
+  bar.update(20);
+  JPetProgressReporter::getInstance().waitUntilIdle();
+  JPetProgressReporter::getInstance().setOutput(nullptr);
+  BOOST_REQUIRE(output.str().find("task file.root 100.0%") != std::string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,7 @@
 
 #include "JPetTaskFactory/JPetTaskFactory.h"
 #include "JPetTask/JPetTask.h"
+#include "JPetTaskIO/JPetFusedTaskIO.h"
 #include "JPetTaskIO/JPetTaskIO.h"
 
 #include <boost/any.hpp>
@@ -128,6 +129,40 @@ BOOST_AUTO_TEST_CASE(factory_addAndRegisterTaskWithStop)
   BOOST_REQUIRE(subTask);
 }
 
+BOOST_AUTO_TEST_CASE(factory_fuseTasks)
+{
+  JPetTaskFactory factory;
+  factory.registerTask<TestClass>("task1");
+  factory.registerTask<TestClass>("task2");
+  factory.registerTask<TestClass>("task3");
+  factory.registerTask<TestClass>("task4");
+  BOOST_REQUIRE(factory.addTaskInfo("task1", "raw", "calib", 1));
+  BOOST_REQUIRE(factory.addTaskInfo("task2", "calib", "sig", 1));
+  BOOST_REQUIRE(factory.addTaskInfo("task3", "sig", "pht", 2)); /// iterative tasks are not fused
+  BOOST_REQUIRE(factory.addTaskInfo("task4", "pht", "evt", 1));
+
+  std::map<std::string, boost::any> opts = {{"inputFileType_std::string", std::string("root")}, {kFuseTasksOptionName, true}};
+  auto chain = factory.createTaskGeneratorChain(opts);
+  BOOST_REQUIRE_EQUAL(chain.size(), 5); /// UnpackerAndUnzipper ->ParamBankHandler -> task1+task2 -> task3 -> task4
+  auto fused = chain[2]();
+  BOOST_REQUIRE_EQUAL(fused->getName(), std::string("task1+task2"));
+  BOOST_REQUIRE(dynamic_cast<JPetFusedTaskIO*>(fused.get()));
+  auto stages = fused->getSubTasks();
+  BOOST_REQUIRE_EQUAL(stages.size(), 2u);
+  BOOST_REQUIRE_EQUAL(stages[0]->getName(), std::string("task1"));
+  BOOST_REQUIRE_EQUAL(stages[1]->getName(), std::string("task2"));
+  auto task3 = chain[3]();
+  BOOST_REQUIRE_EQUAL(task3->getName(), std::string("task3"));
+  auto task4 = chain[4]();
+  BOOST_REQUIRE_EQUAL(task4->getName(), std::string("task4"));
+  BOOST_REQUIRE(!dynamic_cast<JPetFusedTaskIO*>(task4.get()));
+
+  opts[kFuseTasksOptionName] = false;
+  BOOST_REQUIRE_EQUAL(factory.createTaskGeneratorChain(opts).size(), 6);
+  opts[JPetFusedTaskIO::kPipelineKey] = true; /// the pipelined execution implies fusing
+  BOOST_REQUIRE_EQUAL(factory.createTaskGeneratorChain(opts).size(), 5);
+}
+
 BOOST_AUTO_TEST_CASE(factory_clear)
 {
   JPetTaskFactory factory;
@@ -0,0 +1,256 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetFusedTaskIOTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetFusedTaskIOTest
+
+#include "JPetTaskIO/JPetFusedTaskIO.h"
+#include "JPetCommonTools/JPetCommonTools.h"
+#include "JPetEvent/JPetEvent.h"
+#include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetReader/JPetReader.h"
+#include "JPetTaskChainExecutor/JPetTaskChainExecutor.h"
+#include "JPetTaskIO/JPetTaskIO.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetUserTask/JPetUserTask.h"
+
+#include <TROOT.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+const std::string kInputFile = "unitTestData/JPetTaskChainExecutorTest/dabc_17025151847.unk.evt.root";
+const std::string kInputFileType = "unk.evt";
+const std::string kFirstStageFileType = "stage1.file";
+const std::string kSecondStageFileType = "stage2.file";
+
+/// The pipeline needs the thread safety of ROOT, which JPetManager enables before any ROOT object is created
+struct ThreadSafetyFixture
+{
+  ThreadSafetyFixture() { ROOT::EnableThreadSafety(); }
+};
+
+/// For every input event creates an event with one hit with the time equal to the index of the input event
+class FirstStageTask : public JPetUserTask
+{
+public:
+  explicit FirstStageTask(int failingWindow = -1) : JPetUserTask("FirstStageTask"), fFailingWindow(failingWindow) {}
+  bool init() override
+  {
+    fOutputEvents = new JPetTimeWindow("JPetEvent");
+    fWindowCount = 0;
+    return true;
+  }
+  bool exec() override
+  {
+    if (fWindowCount++ == fFailingWindow)
+    {
+      return false;
+    }
+    auto input = dynamic_cast<const JPetTimeWindow*>(fEvent);
+    if (!input)
+    {
+      return false;
+    }
+    for (std::size_t i = 0; i < input->getNumberOfEvents(); i++)
+    {
+      JPetHit hit;
+      hit.setTime(i);
+      fOutputEvents->emplace<JPetEvent>(std::vector<JPetHit>{hit}, JPetEventType::k2Gamma);
+    }
+    return true;
+  }
+  bool terminate() override { return true; }
+
+private:
+  int fFailingWindow = -1;
+  int fWindowCount = 0;
+};
+
+/// Copies the events with the even hit times and marks them as prompt
+class SecondStageTask : public JPetUserTask
+{
+public:
+  explicit SecondStageTask(int failingWindow = -1) : JPetUserTask("SecondStageTask"), fFailingWindow(failingWindow) {}
+  bool init() override
+  {
+    fOutputEvents = new JPetTimeWindow("JPetEvent");
+    fWindowCount = 0;
+    return true;
+  }
+  bool exec() override
+  {
+    if (fWindowCount++ == fFailingWindow)
+    {
+      return false;
+    }
+    auto input = dynamic_cast<const JPetTimeWindow*>(fEvent);
+    if (!input)
+    {
+      return false;
+    }
+    for (std::size_t i = 0; i < input->getNumberOfEvents(); i++)
+    {
+      const auto& event = input->getEvent<JPetEvent>(i);
+      if (static_cast<int>(event.getHits().front().getTime()) % 2 == 0)
+      {
+        fOutputEvents->emplace<JPetEvent>(event).addEventType(JPetEventType::kPrompt);
+      }
+    }
+    return true;
+  }
+  bool terminate() override { return true; }
+
+private:
+  int fFailingWindow = -1;
+  int fWindowCount = 0;
+};
+
+jpet_options_tools::OptsStrAny createOptions(const std::string& outputPath)
+{
+  boost::filesystem::remove_all(outputPath);
+  boost::filesystem::create_directories(outputPath);
+  auto opt = jpet_options_generator_tools::getDefaultOptions();
+  opt["firstEvent_int"] = 0;
+  opt["lastEvent_int"] = 20;
+  opt["inputFile_std::string"] = kInputFile;
+  opt["inputFileType_std::string"] = std::string("root");
+  opt["outputPath_std::string"] = outputPath + "/";
+  return opt;
+}
+
+TaskGenerator createFusedTask(int firstStageFailingWindow = -1, int secondStageFailingWindow = -1)
+{
+  return [firstStageFailingWindow, secondStageFailingWindow]() {
+    auto task = jpet_common_tools::make_unique<JPetFusedTaskIO>("FusedTask", kInputFileType.c_str(),
+                                                                std::vector<std::string>{kFirstStageFileType, kSecondStageFileType});
+    task->addSubTask(jpet_common_tools::make_unique<FirstStageTask>(firstStageFailingWindow));
+    task->addSubTask(jpet_common_tools::make_unique<SecondStageTask>(secondStageFailingWindow));
+    return task;
+  };
+}
+
+std::string getOutputFile(const std::string& outputPath, const std::string& fileType)
+{
+  auto fileName = JPetCommonTools::extractFileNameFromFullPath(kInputFile);
+  return outputPath + "/" + JPetCommonTools::replaceDataTypeInFileName(fileName, fileType);
+}
+
+void checkSameEvents(const std::string& fileName, const std::string& expectedFileName)
+{
+  JPetReader reader(fileName.c_str());
+  JPetReader expectedReader(expectedFileName.c_str());
+  BOOST_REQUIRE(reader.isOpen());
+  BOOST_REQUIRE(expectedReader.isOpen());
+  BOOST_REQUIRE(expectedReader.getNbOfAllEntries() > 0);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), expectedReader.getNbOfAllEntries());
+  for (long long entry = 0; entry < reader.getNbOfAllEntries(); entry++)
+  {
+    BOOST_REQUIRE(reader.nthEntry(entry));
+    BOOST_REQUIRE(expectedReader.nthEntry(entry));
+    const auto& window = dynamic_cast<const JPetTimeWindow&>(reader.getCurrentEntry());
+    const auto& expectedWindow = dynamic_cast<const JPetTimeWindow&>(expectedReader.getCurrentEntry());
+    BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), expectedWindow.getNumberOfEvents());
+    for (std::size_t i = 0; i < window.getNumberOfEvents(); i++)
+    {
+      const auto& event = window.getEvent<JPetEvent>(i);
+      const auto& expectedEvent = expectedWindow.getEvent<JPetEvent>(i);
+      BOOST_REQUIRE_EQUAL(event.getEventType(), expectedEvent.getEventType());
+      BOOST_REQUIRE_EQUAL(event.getHits().size(), expectedEvent.getHits().size());
+      BOOST_REQUIRE_EQUAL(event.getHits().front().getTime(), expectedEvent.getHits().front().getTime());
+    }
+  }
+}
+
+void checkSameHistory(const std::string& fileName, const std::string& expectedFileName)
+{
+  JPetReader reader(fileName.c_str());
+  JPetReader expectedReader(expectedFileName.c_str());
+  std::unique_ptr<JPetTreeHeader> header(reader.getHeaderClone());
+  std::unique_ptr<JPetTreeHeader> expectedHeader(expectedReader.getHeaderClone());
+  BOOST_REQUIRE(header);
+  BOOST_REQUIRE(expectedHeader);
+  BOOST_REQUIRE_EQUAL(header->getStagesNb(), expectedHeader->getStagesNb());
+  for (int i = 0; i < header->getStagesNb(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(header->getProcessingStageInfo(i).fModuleName, expectedHeader->getProcessingStageInfo(i).fModuleName);
+  }
+}
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(ThreadSafetyFixture);
+
+BOOST_AUTO_TEST_SUITE(JPetFusedTaskIOTestSuite)
+
+BOOST_AUTO_TEST_CASE(fusedTasksMatchUnfusedChain)
+{
+  const std::string unfusedPath = "JPetFusedTaskIOTestUnfused";
+  auto firstTask = []() {
+    auto task = jpet_common_tools::make_unique<JPetTaskIO>("FirstTask", kInputFileType.c_str(), kFirstStageFileType.c_str());
+    task->addSubTask(jpet_common_tools::make_unique<FirstStageTask>());
+    return task;
+  };
+  auto secondTask = []() {
+    auto task = jpet_common_tools::make_unique<JPetTaskIO>("SecondTask", kFirstStageFileType.c_str(), kSecondStageFileType.c_str());
+    task->addSubTask(jpet_common_tools::make_unique<SecondStageTask>());
+    return task;
+  };
+  JPetTaskChainExecutor unfused({firstTask, secondTask}, 1, createOptions(unfusedPath));
+  BOOST_REQUIRE(unfused.process());
+
+  const std::string fusedPath = "JPetFusedTaskIOTestFused";
+  auto opt = createOptions(fusedPath);
+  opt[JPetFusedTaskIO::kCheckpointsKey] = std::vector<std::string>{kFirstStageFileType};
+  JPetTaskChainExecutor fused({createFusedTask()}, 1, opt);
+  BOOST_REQUIRE(fused.process());
+
+  checkSameEvents(getOutputFile(fusedPath, kSecondStageFileType), getOutputFile(unfusedPath, kSecondStageFileType));
+  checkSameEvents(getOutputFile(fusedPath, kFirstStageFileType), getOutputFile(unfusedPath, kFirstStageFileType));
+  checkSameHistory(getOutputFile(fusedPath, kSecondStageFileType), getOutputFile(unfusedPath, kSecondStageFileType));
+  checkSameHistory(getOutputFile(fusedPath, kFirstStageFileType), getOutputFile(unfusedPath, kFirstStageFileType));
+}
+
+BOOST_AUTO_TEST_CASE(pipelineMatchesSequentialExecution)
+{
+  const std::string sequentialPath = "JPetFusedTaskIOTestSequential";
+  JPetTaskChainExecutor sequential({createFusedTask()}, 1, createOptions(sequentialPath));
+  BOOST_REQUIRE(sequential.process());
+
+  const std::string pipelinePath = "JPetFusedTaskIOTestPipeline";
+  auto opt = createOptions(pipelinePath);
+  opt[JPetFusedTaskIO::kPipelineKey] = true;
+  opt[JPetFusedTaskIO::kPipelineQueueSizeKey] = 1;
+  JPetTaskChainExecutor pipeline({createFusedTask()}, 1, opt);
+  BOOST_REQUIRE(pipeline.process());
+
+  checkSameEvents(getOutputFile(pipelinePath, kSecondStageFileType), getOutputFile(sequentialPath, kSecondStageFileType));
+}
+
+BOOST_AUTO_TEST_CASE(pipelineStopsOnFailure)
+{
+  const std::string outputPath = "JPetFusedTaskIOTestPipelineFailure";
+  auto opt = createOptions(outputPath);
+  opt[JPetFusedTaskIO::kPipelineKey] = true;
+  opt[JPetFusedTaskIO::kPipelineQueueSizeKey] = 1;
+  /// the failure of the later stage closes its input queue and stops the first stage
+  JPetTaskChainExecutor secondStageFailure({createFusedTask(-1, 1)}, 1, opt);
+  BOOST_REQUIRE(!secondStageFailure.process());
+  /// the failure of the first stage closes the queue, so the later stage finishes
+  JPetTaskChainExecutor firstStageFailure({createFusedTask(1, -1)}, 1, opt);
+  BOOST_REQUIRE(!firstStageFailure.process());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
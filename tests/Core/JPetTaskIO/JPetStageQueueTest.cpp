@@ -0,0 +1,95 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetStageQueueTest
+
+#include "JPetTaskIO/JPetStageQueue.h"
+
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(boundedCapacity)
+{
+  JPetStageQueue<int> queue(3);
+  BOOST_REQUIRE_EQUAL(queue.getCapacity(), 3u);
+  int value = 0;
+  BOOST_REQUIRE(!queue.tryPop(value));
+  for (int i = 1; i <= 3; i++)
+  {
+    BOOST_REQUIRE(queue.tryPush(i));
+  }
+  int extra = 4;
+  BOOST_REQUIRE(!queue.tryPush(extra));
+  BOOST_REQUIRE(queue.tryPop(value));
+  BOOST_REQUIRE_EQUAL(value, 1);
+  BOOST_REQUIRE(queue.tryPush(extra));
+  for (int i = 2; i <= 4; i++)
+  {
+    BOOST_REQUIRE(queue.tryPop(value));
+    BOOST_REQUIRE_EQUAL(value, i);
+  }
+  BOOST_REQUIRE(!queue.tryPop(value));
+}
+
+BOOST_AUTO_TEST_CASE(closedQueue)
+{
+  JPetStageQueue<std::unique_ptr<int>> queue(2);
+  BOOST_REQUIRE(queue.push(std::unique_ptr<int>(new int(7))));
+  queue.close();
+  BOOST_REQUIRE(!queue.push(std::unique_ptr<int>(new int(8))));
+  std::unique_ptr<int> value;
+  BOOST_REQUIRE(queue.pop(value)); /// the elements pushed before closing are still available
+  BOOST_REQUIRE_EQUAL(*value, 7);
+  BOOST_REQUIRE(!queue.pop(value));
+}
+
+BOOST_AUTO_TEST_CASE(orderIsKeptBetweenThreads)
+{
+  const int kNumberOfElements = 100000;
+  JPetStageQueue<std::unique_ptr<int>> queue(4);
+  std::thread producer([&queue]() {
+    for (int i = 0; i < kNumberOfElements; i++)
+    {
+      if (!queue.push(std::unique_ptr<int>(new int(i))))
+      {
+        return;
+      }
+    }
+    queue.close();
+  });
+  std::unique_ptr<int> value;
+  int expected = 0;
+  bool isOrdered = true;
+  while (queue.pop(value))
+  {
+    isOrdered = isOrdered && *value == expected;
+    expected++;
+  }
+  producer.join();
+  BOOST_REQUIRE(isOrdered);
+  BOOST_REQUIRE_EQUAL(expected, kNumberOfElements);
+}
+
+BOOST_AUTO_TEST_CASE(consumerStopsProducer)
+{
+  JPetStageQueue<int> queue(2);
+  bool isStopped = false;
+  std::thread producer([&queue, &isStopped]() {
+    for (int i = 0; i < 1000; i++)
+    {
+      if (!queue.push(i))
+      {
+        isStopped = true;
+        return;
+      }
+    }
+  });
+  int value = 0;
+  BOOST_REQUIRE(queue.pop(value));
+  queue.close();
+  producer.join();
+  BOOST_REQUIRE(isStopped);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
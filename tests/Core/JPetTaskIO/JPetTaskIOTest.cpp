@@ -17,6 +17,7 @@
 #define BOOST_TEST_MODULE JPetTaskIOTest
 
 #include "JPetTaskIO/JPetTaskIO.h"
+#include "JPetCachedFunction/JPetCachedFunction.h"
 #include "JPetCmdParser/JPetCmdParser.h"
 #include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetDataInterface/JPetDataInterface.h"
@@ -99,4 +100,57 @@ BOOST_AUTO_TEST_CASE(bad_input_bad_output)
   gErrorIgnoreLevel = kPrint; /// Turning back the ROOT error reporting.
 }
 
+BOOST_AUTO_TEST_CASE(entryFilterFromOptions)
+{
+  BOOST_REQUIRE(!JPetTaskIO::createEntryFilter(jpet_options_tools::OptsStrAny()));
+  jpet_options_tools::OptsStrAny options;
+  options[JPetTaskIO::kIndexMinEventsKey] = 2;
+  options[JPetTaskIO::kIndexMinTimeKey] = 100.0;
+  auto filter = JPetTaskIO::createEntryFilter(options);
+  BOOST_REQUIRE(filter);
+  JPetWindowIndex::Entry entry;
+  entry.fNumberOfEvents = 2;
+  entry.fMinTime = 50.0;
+  entry.fMaxTime = 150.0;
+  BOOST_REQUIRE(filter(entry));
+  entry.fMaxTime = 90.0;
+  BOOST_REQUIRE(!filter(entry));
+  entry.fMaxTime = 150.0;
+  entry.fNumberOfEvents = 1;
+  BOOST_REQUIRE(!filter(entry));
+}
+
+BOOST_AUTO_TEST_CASE(cacheDirectoryFromOptions)
+{
+  using jpet_common_tools::JPetCachedFunctionStore;
+  class JPetCacheDirectoryTask : public JPetTaskTest
+  {
+  public:
+    explicit JPetCacheDirectoryTask(std::string& directory) : JPetTaskTest("cacheDirectoryTask"), fDirectory(directory) {}
+
+  protected:
+    bool init() override
+    {
+      fDirectory = JPetCachedFunctionStore::getCacheDirectory();
+      return true;
+    }
+    std::string& fDirectory;
+  };
+
+  auto opts = jpet_options_generator_tools::getDefaultOptions();
+  opts[JPetTaskIO::kCacheDirectoryKey] = std::string("unitTestData/JPetTaskIOTest/cache");
+  JPetParams params(opts, nullptr);
+  JPetTaskIO taskIO("myTestIO", "", "");
+  std::string directoryInTask;
+  taskIO.addSubTask(jpet_common_tools::make_unique<JPetCacheDirectoryTask>(directoryInTask));
+  BOOST_REQUIRE(taskIO.init(params));
+  BOOST_REQUIRE(!JPetCachedFunctionStore::isEnabled());
+  JPetDataInterface pseudoData;
+  BOOST_REQUIRE(taskIO.run(pseudoData));
+  BOOST_REQUIRE(taskIO.terminate(params));
+  BOOST_REQUIRE_EQUAL(directoryInTask, "unitTestData/JPetTaskIOTest/cache");
+  /// the directory is not left for the following tasks
+  BOOST_REQUIRE(!JPetCachedFunctionStore::isEnabled());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
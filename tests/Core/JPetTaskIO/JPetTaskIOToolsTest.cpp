@@ -78,4 +78,62 @@ BOOST_AUTO_TEST_CASE(setUserLimits_wrong)
   BOOST_REQUIRE_EQUAL(last, -1);
 }
 
+BOOST_AUTO_TEST_CASE(getShardLimits)
+{
+  using namespace JPetTaskIOTools;
+  BOOST_REQUIRE(getShardLimits(0, 9, 0, 1) == std::make_pair(0ll, 9ll));
+  BOOST_REQUIRE(getShardLimits(0, 9, 0, 3) == std::make_pair(0ll, 2ll));
+  BOOST_REQUIRE(getShardLimits(0, 9, 1, 3) == std::make_pair(3ll, 5ll));
+  BOOST_REQUIRE(getShardLimits(0, 9, 2, 3) == std::make_pair(6ll, 9ll));
+  BOOST_REQUIRE(getShardLimits(10, 19, 1, 2) == std::make_pair(15ll, 19ll));
+  /// more shards than events, some of them are empty
+  auto empty = getShardLimits(0, 1, 0, 4);
+  BOOST_REQUIRE(empty.first > empty.second);
+}
+
+BOOST_AUTO_TEST_CASE(setUserLimits_shard)
+{
+  using namespace jpet_options_generator_tools;
+  auto opts = getDefaultOptions();
+  auto first = 0ll;
+  auto last = 0ll;
+  bool isOK = false;
+  opts["shardIndex_int"] = 1;
+  opts["numberOfShards_int"] = 4;
+  std::tie(isOK, first, last) = JPetTaskIOTools::setUserLimits(opts, 100);
+  BOOST_REQUIRE(isOK);
+  BOOST_REQUIRE_EQUAL(first, 25);
+  BOOST_REQUIRE_EQUAL(last, 49);
+
+  opts["firstEvent_int"] = 10;
+  opts["lastEvent_int"] = 29;
+  std::tie(isOK, first, last) = JPetTaskIOTools::setUserLimits(opts, 100);
+  BOOST_REQUIRE(isOK);
+  BOOST_REQUIRE_EQUAL(first, 15);
+  BOOST_REQUIRE_EQUAL(last, 19);
+
+  std::tie(isOK, first, last) = JPetTaskIOTools::setUserLimits(opts, 2);
+  BOOST_REQUIRE(!isOK);
+}
+
+BOOST_AUTO_TEST_CASE(addShardToFileName)
+{
+  using namespace JPetTaskIOTools;
+  BOOST_REQUIRE_EQUAL(addShardToFileName("dabc_123.hits.root", 3, 16), "dabc_123_shard3of16.hits.root");
+  BOOST_REQUIRE_EQUAL(addShardToFileName("data/dabc_123.hits.root", 0, 2), "data/dabc_123_shard0of2.hits.root");
+  BOOST_REQUIRE_EQUAL(addShardToFileName("dabc_123", 1, 2), "dabc_123_shard1of2");
+}
+
+BOOST_AUTO_TEST_CASE(setInputAndOutputFile_shard)
+{
+  using namespace jpet_options_generator_tools;
+  auto opts = getDefaultOptions();
+  opts["inputFile_std::string"] = std::string("dabc_123.hld");
+  opts["shardIndex_int"] = 3;
+  opts["numberOfShards_int"] = 16;
+  auto result = JPetTaskIOTools::setInputAndOutputFile(opts, false, "hld", "tslot.calib");
+  BOOST_REQUIRE(std::get<0>(result));
+  BOOST_REQUIRE_EQUAL(std::get<2>(result), "dabc_123_shard3of16.tslot.calib.root");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
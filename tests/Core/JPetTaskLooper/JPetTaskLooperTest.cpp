@@ -22,6 +22,28 @@ public:
   int fRunCounter = 0;
 };
 
+class TestTaskSkipOutput : public JPetTask
+{
+public:
+  explicit TestTaskSkipOutput(const char* name = "") : JPetTask(name) {}
+  bool init(const JPetParams& paramsI) override
+  {
+    fParams = paramsI;
+    const auto& opts = paramsI.getOptions();
+    auto skip = opts.find(JPetTaskIO::kSkipOutputEventsKey);
+    fSkipOutputEvents.push_back(skip != opts.end() && boost::any_cast<bool>(skip->second));
+    return true;
+  }
+  bool run(const JPetDataInterface&) override { return true; }
+  bool terminate(JPetParams& paramsO) override
+  {
+    paramsO = fParams;
+    return true;
+  }
+  std::vector<bool> fSkipOutputEvents;
+  JPetParams fParams;
+};
+
 class TestTaskRun20Times : public JPetTask
 {
 public:
@@ -269,4 +291,33 @@ BOOST_AUTO_TEST_CASE(my_test_JPetTaskIO_3)
   auto subSubTask = dynamic_cast<TestLooperUserTask*>(subTaskIO->getSubTasks()[0]);
   BOOST_REQUIRE_EQUAL(subSubTask->fRunCounter, 100);
 }
+
+BOOST_AUTO_TEST_CASE(outputOnlyInLastIterationWithInputCache)
+{
+  const int maxIter = 3;
+  JPetTaskLooper looper("testTaskLooper", std::unique_ptr<JPetTask>(new TestTaskSkipOutput), JPetTaskLooper::getMaxIterationPredicate(maxIter));
+  looper.setNumberOfIterations(maxIter);
+  jpet_options_tools::OptsStrAny opt;
+  opt[JPetTaskIO::kInputCacheKey] = 100;
+  JPetDataInterface nullDataObject;
+  BOOST_REQUIRE(looper.init(JPetParams(opt, nullptr)));
+  BOOST_REQUIRE(looper.run(nullDataObject));
+  auto subTask = dynamic_cast<TestTaskSkipOutput*>(looper.getSubTasks()[0]);
+  std::vector<bool> expected = {true, true, false};
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(subTask->fSkipOutputEvents.begin(), subTask->fSkipOutputEvents.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(outputInAllIterationsWithoutInputCache)
+{
+  const int maxIter = 3;
+  JPetTaskLooper looper("testTaskLooper", std::unique_ptr<JPetTask>(new TestTaskSkipOutput), JPetTaskLooper::getMaxIterationPredicate(maxIter));
+  looper.setNumberOfIterations(maxIter);
+  JPetDataInterface nullDataObject;
+  BOOST_REQUIRE(looper.init(JPetParams()));
+  BOOST_REQUIRE(looper.run(nullDataObject));
+  auto subTask = dynamic_cast<TestTaskSkipOutput*>(looper.getSubTasks()[0]);
+  std::vector<bool> expected = {false, false, false};
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(subTask->fSkipOutputEvents.begin(), subTask->fSkipOutputEvents.end(), expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTracerTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetTracerTest
+
+#include "JPetTracer/JPetTracer.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/unit_test.hpp>
+#include <set>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(JPetTracerTestSuite)
+
+BOOST_AUTO_TEST_CASE(disabledByDefault)
+{
+  BOOST_REQUIRE(!JPetTracer::isEnabled());
+  {
+    JPetTracer::Scope scope("test", "not recorded");
+  }
+  BOOST_REQUIRE_EQUAL(JPetTracer::getNumberOfEvents(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(recordThreads)
+{
+  JPetTracer::start();
+  JPetTracer::setThreadName("main \"thread\"");
+  {
+    JPetTracer::Scope outer("test", "outer");
+    std::thread worker([]() {
+      JPetTracer::setThreadName("worker");
+      for (int i = 0; i < 3; i++)
+      {
+        JPetTracer::Scope scope("test", std::string("inner ") + std::to_string(i));
+      }
+    });
+    worker.join();
+  }
+  BOOST_REQUIRE(JPetTracer::stop("tracerTest.json"));
+  BOOST_REQUIRE(!JPetTracer::isEnabled());
+  BOOST_REQUIRE_EQUAL(JPetTracer::getNumberOfEvents(), 4);
+  BOOST_REQUIRE_EQUAL(JPetTracer::getNumberOfDroppedEvents(), 0);
+
+  boost::property_tree::ptree tree;
+  boost::property_tree::read_json("tracerTest.json", tree);
+  std::set<int> threadIds;
+  std::set<std::string> threadNames;
+  int spans = 0;
+  for (const auto& event : tree.get_child("traceEvents"))
+  {
+    threadIds.insert(event.second.get<int>("tid"));
+    if (event.second.get<std::string>("ph") == "M")
+    {
+      threadNames.insert(event.second.get<std::string>("args.name"));
+    }
+    else
+    {
+      BOOST_REQUIRE_EQUAL(event.second.get<std::string>("ph"), "X");
+      BOOST_REQUIRE_GE(event.second.get<double>("dur"), 0.0);
+      spans++;
+    }
+  }
+  BOOST_REQUIRE_EQUAL(spans, 4);
+  BOOST_REQUIRE_EQUAL(threadIds.size(), 2u);
+  BOOST_REQUIRE(threadNames.count("main \"thread\""));
+  BOOST_REQUIRE(threadNames.count("worker"));
+  boost::filesystem::remove("tracerTest.json");
+
+  JPetTracer::start();
+  BOOST_REQUIRE_EQUAL(JPetTracer::getNumberOfEvents(), 0);
+  JPetTracer::stop("tracerTest.json");
+  boost::filesystem::remove("tracerTest.json");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
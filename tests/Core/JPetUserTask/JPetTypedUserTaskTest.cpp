@@ -0,0 +1,83 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTypedUserTaskTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetTypedUserTaskTest
+
+#include "JPetData/JPetData.h"
+#include "JPetEvent/JPetEvent.h"
+#include "JPetHit/JPetHit.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetUserTask/JPetTypedUserTask.h"
+
+#include <boost/test/unit_test.hpp>
+
+class TestHitsToEvent: public JPetTypedUserTask<JPetHit, JPetEvent>
+{
+public:
+  TestHitsToEvent() : JPetTypedUserTask<JPetHit, JPetEvent>("TestHitsToEvent") {}
+  int fProcessedWindows = 0;
+
+protected:
+  bool init() override { return true; }
+  bool terminate() override { return true; }
+  bool process(const InputEvents& hits) override
+  {
+    fProcessedWindows++;
+    JPetEvent event;
+    for (std::size_t i = 0; i < hits.size(); i++)
+    {
+      event.addHit(hits[i]);
+    }
+    addOutput(std::move(event));
+    return true;
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(processTypedWindow)
+{
+  TestHitsToEvent task;
+  BOOST_REQUIRE(task.init(JPetParams()));
+  BOOST_REQUIRE(task.getOutputEvents());
+
+  JPetTimeWindow window("JPetHit");
+  JPetHit hit;
+  hit.setTime(1.0);
+  window.add<JPetHit>(hit);
+  hit.setTime(2.0);
+  window.add<JPetHit>(hit);
+  BOOST_REQUIRE(task.run(JPetData(window)));
+  BOOST_REQUIRE(task.run(JPetData(window)));
+  BOOST_REQUIRE_EQUAL(task.fProcessedWindows, 2);
+  auto output = task.getOutputEvents();
+  BOOST_REQUIRE_EQUAL(output->getNumberOfEvents(), 1u);
+  const auto& event = output->getEvent<JPetEvent>(0);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 2u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[1].getTime(), 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(wrongInputType)
+{
+  TestHitsToEvent task;
+  BOOST_REQUIRE(task.init(JPetParams()));
+  JPetTimeWindow window("JPetSigCh");
+  window.add<JPetSigCh>(JPetSigCh(JPetSigCh::Leading, 1.0));
+  BOOST_REQUIRE(!task.run(JPetData(window)));
+  BOOST_REQUIRE_EQUAL(task.fProcessedWindows, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetRunTimeIndexTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetRunTimeIndexTest
+#include "JPetWindowIndex/JPetRunTimeIndex.h"
+#include "JPetHit/JPetHit.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetWriter/JPetWriter.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+const double kWindowLength = 1000.0;
+
+/// Writes the windows with the given numbers, each with one hit with the time equal to the window number
+void writeFile(const std::string& fileName, const std::vector<int>& windowNumbers, ULong64_t numberOfWindows = 0)
+{
+  JPetWriter writer(fileName.c_str());
+  JPetTimeWindow window("JPetHit");
+  for (auto windowNumber : windowNumbers)
+  {
+    window.Clear();
+    JPetHit hit;
+    hit.setTime(windowNumber);
+    window.add<JPetHit>(hit);
+    writer.setIndexWindowNumber(windowNumber);
+    writer.write(window);
+  }
+  writer.setIndexNumberOfWindows(numberOfWindows);
+  writer.closeFile();
+}
+
+struct RunFixture
+{
+  RunFixture() : run(kWindowLength)
+  {
+    /// the windows 1 and 4 of the first file and 0 of the second one are empty and not written
+    writeFile("runTimeIndexTest_1.root", {0, 2, 3, 5});
+    writeFile("runTimeIndexTest_2.root", {1, 2});
+    BOOST_REQUIRE(run.addFile("runTimeIndexTest_1.root"));
+    BOOST_REQUIRE(run.addFile("runTimeIndexTest_2.root"));
+  }
+  JPetRunTimeIndex run;
+};
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_FIXTURE_TEST_CASE(locate, RunFixture)
+{
+  BOOST_REQUIRE_EQUAL(run.getNumberOfFiles(), 2u);
+  BOOST_REQUIRE_CLOSE(run.getEndTime(), 9 * kWindowLength, 0.001);
+  JPetRunTimeIndex::Location location;
+  BOOST_REQUIRE(run.locate(2500.0, location));
+  BOOST_REQUIRE_EQUAL(location.fFileIndex, 0u);
+  BOOST_REQUIRE_EQUAL(location.fEntry, 1);
+  BOOST_REQUIRE_EQUAL(location.fWindowNumber, 2u);
+  BOOST_REQUIRE_CLOSE(run.getStartTime(location), 2000.0, 0.001);
+
+  BOOST_REQUIRE(run.locate(4100.0, location));
+  BOOST_REQUIRE_EQUAL(location.fEntry, 3);
+  BOOST_REQUIRE_EQUAL(location.fWindowNumber, 5u);
+
+  BOOST_REQUIRE(run.locate(6000.0, location));
+  BOOST_REQUIRE_EQUAL(location.fFileIndex, 1u);
+  BOOST_REQUIRE_EQUAL(location.fEntry, 0);
+  BOOST_REQUIRE_EQUAL(location.fWindowNumber, 7u);
+
+  BOOST_REQUIRE(!run.locate(-1.0, location));
+  BOOST_REQUIRE(!run.locate(9000.0, location));
+}
+
+BOOST_FIXTURE_TEST_CASE(fetchSlice, RunFixture)
+{
+  std::vector<float> times;
+  for (auto window = run.fetch(3000.0); window && run.getStartTime(run.getLocation()) < 8000.0; window = run.fetchNext())
+  {
+    auto timeWindow = dynamic_cast<JPetTimeWindow*>(window);
+    BOOST_REQUIRE(timeWindow);
+    BOOST_REQUIRE_EQUAL(timeWindow->getNumberOfEvents(), 1);
+    times.push_back(timeWindow->getEvent<JPetHit>(0).getTime());
+  }
+  BOOST_REQUIRE_EQUAL(times.size(), 3u);
+  BOOST_REQUIRE_CLOSE(times[0], 3.0, 0.001);
+  BOOST_REQUIRE_CLOSE(times[1], 5.0, 0.001);
+  BOOST_REQUIRE_CLOSE(times[2], 1.0, 0.001);
+  BOOST_REQUIRE(!run.fetch(10000.0));
+}
+
+BOOST_AUTO_TEST_CASE(trailingEmptyWindows)
+{
+  /// the windows 2 and 3 at the end of the first file are empty and not written
+  writeFile("runTimeIndexTest_3.root", {0, 1}, 4);
+  writeFile("runTimeIndexTest_4.root", {0, 1});
+  JPetRunTimeIndex run(kWindowLength);
+  BOOST_REQUIRE(run.addFile("runTimeIndexTest_3.root"));
+  BOOST_REQUIRE(run.addFile("runTimeIndexTest_4.root"));
+  BOOST_REQUIRE_CLOSE(run.getEndTime(), 6 * kWindowLength, 0.001);
+  JPetRunTimeIndex::Location location;
+  BOOST_REQUIRE(run.locate(2500.0, location));
+  BOOST_REQUIRE_EQUAL(location.fFileIndex, 1u);
+  BOOST_REQUIRE_EQUAL(location.fEntry, 0);
+  BOOST_REQUIRE_EQUAL(location.fWindowNumber, 4u);
+  BOOST_REQUIRE(run.locate(5500.0, location));
+  BOOST_REQUIRE_EQUAL(location.fEntry, 1);
+  BOOST_REQUIRE_EQUAL(location.fWindowNumber, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(fileWithoutIndex)
+{
+  JPetRunTimeIndex run(kWindowLength);
+  BOOST_REQUIRE(!run.addFile("nonExistingFile.root"));
+  BOOST_REQUIRE_EQUAL(run.getNumberOfFiles(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
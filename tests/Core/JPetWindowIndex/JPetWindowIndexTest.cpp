@@ -0,0 +1,190 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWindowIndexTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetWindowIndexTest
+#include "JPetWindowIndex/JPetWindowIndex.h"
+#include "JPetEvent/JPetEvent.h"
+#include "JPetHit/JPetHit.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetWriter/JPetWriter.h"
+
+#include <TFile.h>
+#include <TNamed.h>
+#include <TTree.h>
+#include <cmath>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+JPetHit createHit(float time)
+{
+  JPetHit hit;
+  hit.setTime(time);
+  return hit;
+}
+
+JPetWindowIndex::Entry createEntry(unsigned int numberOfEvents, double minTime, double maxTime, ULong64_t flags = 0)
+{
+  JPetWindowIndex::Entry entry;
+  entry.fNumberOfEvents = numberOfEvents;
+  entry.fMinTime = minTime;
+  entry.fMaxTime = maxTime;
+  entry.fFlags = flags;
+  return entry;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(entryOfHitWindow)
+{
+  JPetTimeWindow window("JPetHit");
+  window.add<JPetHit>(createHit(12.5));
+  window.add<JPetHit>(createHit(-3.0));
+  window.add<JPetHit>(createHit(7.0));
+  auto entry = JPetWindowIndex::createEntry(window, 5);
+  BOOST_REQUIRE_EQUAL(entry.fNumberOfEvents, 3u);
+  BOOST_REQUIRE_CLOSE(entry.fMinTime, -3.0, 0.001);
+  BOOST_REQUIRE_CLOSE(entry.fMaxTime, 12.5, 0.001);
+  BOOST_REQUIRE_EQUAL(entry.fFlags, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(entryOfEventAndSigChWindows)
+{
+  JPetTimeWindow events("JPetEvent");
+  JPetEvent event;
+  event.addHit(createHit(4.0));
+  event.addHit(createHit(2.0));
+  events.add<JPetEvent>(event);
+  auto eventEntry = JPetWindowIndex::createEntry(events);
+  BOOST_REQUIRE_EQUAL(eventEntry.fNumberOfEvents, 1u);
+  BOOST_REQUIRE_CLOSE(eventEntry.fMinTime, 2.0, 0.001);
+  BOOST_REQUIRE_CLOSE(eventEntry.fMaxTime, 4.0, 0.001);
+
+  JPetTimeWindow sigChs("JPetSigCh");
+  sigChs.add<JPetSigCh>(JPetSigCh(JPetSigCh::Leading, 1.5));
+  auto sigChEntry = JPetWindowIndex::createEntry(sigChs);
+  BOOST_REQUIRE_CLOSE(sigChEntry.fMinTime, 1.5, 0.001);
+  BOOST_REQUIRE_CLOSE(sigChEntry.fMaxTime, 1.5, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(entryWithoutTime)
+{
+  JPetTimeWindow empty("JPetHit");
+  auto entry = JPetWindowIndex::createEntry(empty);
+  BOOST_REQUIRE_EQUAL(entry.fNumberOfEvents, 0u);
+  BOOST_REQUIRE(std::isnan(entry.fMinTime));
+  BOOST_REQUIRE(std::isnan(entry.fMaxTime));
+  BOOST_REQUIRE(JPetWindowIndex::timeRange(0.0, 1.0)(entry));
+}
+
+BOOST_AUTO_TEST_CASE(predicates)
+{
+  auto entry = createEntry(2, 10.0, 20.0, 0x6);
+  BOOST_REQUIRE(JPetWindowIndex::minNumberOfEvents(2)(entry));
+  BOOST_REQUIRE(!JPetWindowIndex::minNumberOfEvents(3)(entry));
+  BOOST_REQUIRE(JPetWindowIndex::timeRange(15.0, 30.0)(entry));
+  BOOST_REQUIRE(JPetWindowIndex::timeRange(0.0, 10.0)(entry));
+  BOOST_REQUIRE(!JPetWindowIndex::timeRange(20.5, 30.0)(entry));
+  BOOST_REQUIRE(JPetWindowIndex::allFlags(0x2)(entry));
+  BOOST_REQUIRE(!JPetWindowIndex::allFlags(0x3)(entry));
+  BOOST_REQUIRE(JPetWindowIndex::allOf({JPetWindowIndex::minNumberOfEvents(1), JPetWindowIndex::allFlags(0x4)})(entry));
+  BOOST_REQUIRE(!JPetWindowIndex::allOf({JPetWindowIndex::minNumberOfEvents(1), JPetWindowIndex::allFlags(0x1)})(entry));
+}
+
+BOOST_AUTO_TEST_CASE(writeReadAndFind)
+{
+  std::string fileName = "windowIndexTest.root";
+  {
+    JPetWriter writer(fileName.c_str());
+    JPetTimeWindow window("JPetHit");
+    for (int i = 0; i < 5; i++)
+    {
+      window.Clear();
+      for (int j = 0; j < i % 3; j++)
+      {
+        window.add<JPetHit>(createHit(100.0 * i + j));
+      }
+      writer.setIndexFlags(i == 4 ? 1 : 0);
+      writer.write(window);
+    }
+    writer.closeFile();
+  }
+  TFile file(fileName.c_str(), "READ");
+  auto tree = dynamic_cast<TTree*>(file.Get(JPetWindowIndex::kIndexTreeName.c_str()));
+  BOOST_REQUIRE(tree);
+  JPetWindowIndex index;
+  BOOST_REQUIRE(index.read(*tree));
+  BOOST_REQUIRE_EQUAL(index.size(), 5);
+  BOOST_REQUIRE_EQUAL(index[2].fNumberOfEvents, 2u);
+  BOOST_REQUIRE_CLOSE(index[2].fMinTime, 200.0, 0.001);
+  BOOST_REQUIRE_CLOSE(index[2].fMaxTime, 201.0, 0.001);
+  BOOST_REQUIRE_EQUAL(index[4].fFlags, 1u);
+
+  auto twoHits = JPetWindowIndex::minNumberOfEvents(2);
+  BOOST_REQUIRE_EQUAL(index.findNext(0, 4, twoHits), 2);
+  BOOST_REQUIRE_EQUAL(index.findNext(3, 4, twoHits), -1);
+  BOOST_REQUIRE_EQUAL(index.findNext(0, 4, JPetWindowIndex::timeRange(350.0, 1000.0)), 4);
+  BOOST_REQUIRE_EQUAL(index.findNext(0, 2, JPetWindowIndex::allFlags(1)), -1);
+  BOOST_REQUIRE_EQUAL(index[3].fWindowNumber, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(findWindow)
+{
+  std::string fileName = "windowIndexTestNumbers.root";
+  {
+    JPetWriter writer(fileName.c_str());
+    JPetTimeWindow window("JPetHit");
+    window.add<JPetHit>(createHit(1.0));
+    for (auto windowNumber : {2, 3, 7})
+    {
+      writer.setIndexWindowNumber(windowNumber);
+      writer.write(window);
+    }
+    writer.write(window);
+    writer.closeFile();
+  }
+  TFile file(fileName.c_str(), "READ");
+  auto tree = dynamic_cast<TTree*>(file.Get(JPetWindowIndex::kIndexTreeName.c_str()));
+  BOOST_REQUIRE(tree);
+  JPetWindowIndex index;
+  BOOST_REQUIRE(index.read(*tree));
+  BOOST_REQUIRE_EQUAL(index.size(), 4);
+  BOOST_REQUIRE_EQUAL(index[3].fWindowNumber, 8u);
+  BOOST_REQUIRE_EQUAL(index.findWindow(0), 0);
+  BOOST_REQUIRE_EQUAL(index.findWindow(3), 1);
+  BOOST_REQUIRE_EQUAL(index.findWindow(4), 2);
+  BOOST_REQUIRE_EQUAL(index.findWindow(8), 3);
+  BOOST_REQUIRE_EQUAL(index.findWindow(9), -1);
+}
+
+BOOST_AUTO_TEST_CASE(noIndexForOtherObjects)
+{
+  std::string fileName = "windowIndexTestTNamed.root";
+  {
+    JPetWriter writer(fileName.c_str());
+    TNamed object("TNamed", "Title");
+    writer.write(object);
+    writer.closeFile();
+  }
+  TFile file(fileName.c_str(), "READ");
+  BOOST_REQUIRE(!file.Get(JPetWindowIndex::kIndexTreeName.c_str()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
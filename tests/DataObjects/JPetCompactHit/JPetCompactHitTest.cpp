@@ -0,0 +1,106 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetCompactHitTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetCompactHitTest
+
+#include "JPetBarrelSlot/JPetBarrelSlot.h"
+#include "JPetCompactHit/JPetCompactHit.h"
+#include "JPetCompactHit/JPetCompactHitWindow.h"
+#include "JPetCompactHitConverter/JPetCompactHitConverter.h"
+#include "JPetScin/JPetScin.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(default_constructor)
+{
+  JPetCompactHit hit;
+  BOOST_REQUIRE_EQUAL(hit.getRecoFlag(), JPetHit::Unknown);
+  BOOST_REQUIRE_EQUAL(hit.getTime(), 0.0f);
+  BOOST_REQUIRE_EQUAL(hit.getEnergy(), 0.0f);
+  BOOST_REQUIRE_EQUAL(hit.getScintillatorID(), -1);
+  BOOST_REQUIRE_EQUAL(hit.getMCindex(), JPetHit::kMCindexError);
+  BOOST_REQUIRE(!hit.hasSignalA());
+  BOOST_REQUIRE(!hit.hasSignalB());
+}
+
+BOOST_AUTO_TEST_CASE(convertWithoutSignals)
+{
+  JPetBarrelSlot slot(43, true, "", 0, 43);
+  JPetScin scin(12);
+  JPetHit hit;
+  hit.setRecoFlag(JPetHit::Good);
+  hit.setTime(1500.0f);
+  hit.setQualityOfTime(0.5f);
+  hit.setEnergy(300.0f);
+  hit.setTimeDiff(-200.0f);
+  hit.setPos(1.0f, 2.0f, 3.0f);
+  hit.setMCindex(7);
+  hit.setBarrelSlot(slot);
+  hit.setScintillator(scin);
+
+  auto compact = JPetCompactHitConverter::convert(hit);
+  BOOST_REQUIRE_EQUAL(compact.getRecoFlag(), JPetHit::Good);
+  BOOST_REQUIRE_EQUAL(compact.getTime(), 1500.0f);
+  BOOST_REQUIRE_EQUAL(compact.getQualityOfTime(), 0.5f);
+  BOOST_REQUIRE_EQUAL(compact.getEnergy(), 300.0f);
+  BOOST_REQUIRE_EQUAL(compact.getTimeDiff(), -200.0f);
+  BOOST_REQUIRE_EQUAL(compact.getPos().X(), 1.0);
+  BOOST_REQUIRE_EQUAL(compact.getPos().Y(), 2.0);
+  BOOST_REQUIRE_EQUAL(compact.getPos().Z(), 3.0);
+  BOOST_REQUIRE_EQUAL(compact.getScintillatorID(), 12);
+  BOOST_REQUIRE_EQUAL(compact.getBarrelSlotID(), 43);
+  BOOST_REQUIRE_EQUAL(compact.getMCindex(), 7u);
+  BOOST_REQUIRE(!compact.hasSignalA());
+  BOOST_REQUIRE(!compact.hasSignalB());
+
+  compact.Clear();
+  BOOST_REQUIRE_EQUAL(compact.getTime(), 0.0f);
+  BOOST_REQUIRE_EQUAL(compact.getScintillatorID(), -1);
+}
+
+BOOST_AUTO_TEST_CASE(convertWithSignals)
+{
+  JPetBarrelSlot slot(43, true, "", 0, 43);
+  JPetScin scin(12);
+  JPetPhysSignal signalA;
+  signalA.setTime(100.0);
+  JPetPhysSignal signalB;
+  signalB.setTime(200.0);
+  JPetHit hit;
+  hit.setBarrelSlot(slot);
+  hit.setScintillator(scin);
+  hit.setSignalA(signalA);
+  hit.setSignalB(signalB);
+
+  JPetCompactHitWindow window("JPetCompactHit");
+  window.add<JPetCompactHit>(JPetCompactHitConverter::convert(hit, &window));
+  window.add<JPetCompactHit>(JPetCompactHitConverter::convert(hit, &window));
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 2u);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfSignals(), 4u);
+  const auto& second = window.getEvent<JPetCompactHit>(1);
+  BOOST_REQUIRE_EQUAL(second.getSignalAIndex(), 2);
+  BOOST_REQUIRE_EQUAL(second.getSignalBIndex(), 3);
+  BOOST_REQUIRE_EQUAL(window.getSignalA(second).getTime(), 100.0);
+  BOOST_REQUIRE_EQUAL(window.getSignalB(second).getTime(), 200.0);
+
+  window.Clear();
+  BOOST_REQUIRE_EQUAL(window.getNumberOfEvents(), 0u);
+  BOOST_REQUIRE_EQUAL(window.getNumberOfSignals(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,31 @@
 
 #include <boost/test/unit_test.hpp>
 
+namespace
+{
+JPetHit createHitWithPoints(float time, int numberOfPoints)
+{
+  JPetRawSignal rawSignal;
+  for (int i = 0; i < numberOfPoints; i++)
+  {
+    rawSignal.addPoint(JPetSigCh(JPetSigCh::Leading, time + i));
+  }
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  JPetPhysSignal physSignal;
+  physSignal.setRecoSignal(recoSignal);
+  JPetHit hit;
+  hit.setTime(time);
+  hit.setSignalA(physSignal);
+  return hit;
+}
+
+std::size_t getPointsCapacity(const JPetHit& hit)
+{
+  return hit.getSignalA().getRecoSignal().getRawSignal().getUnsortedPoints(JPetSigCh::Leading).capacity();
+}
+} // namespace
+
 BOOST_AUTO_TEST_SUITE(FirstSuite)
 
 BOOST_AUTO_TEST_CASE(default_constructor)
@@ -253,4 +278,78 @@ BOOST_AUTO_TEST_CASE(addEventType3)
   BOOST_REQUIRE((type & JPetEventType::kScattered) != JPetEventType::kScattered);
 }
 
+BOOST_AUTO_TEST_CASE(clearAndReuseHits)
+{
+  std::vector<JPetHit> hits(3);
+  hits[0].setTime(3);
+  hits[1].setTime(1);
+  hits[2].setTime(2);
+  JPetEvent event(hits, JPetEventType::k2Gamma);
+  event.Clear();
+  BOOST_REQUIRE(event.getHits().empty());
+  BOOST_REQUIRE(event.isOnlyTypeOf(JPetEventType::kUnknown));
+
+  JPetHit hit;
+  hit.setTime(7);
+  event.addHit(hit);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 1u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 7);
+  event.setHits(hits);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 3u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 1);
+  BOOST_REQUIRE_EQUAL(event.getHits()[1].getTime(), 2);
+  BOOST_REQUIRE_EQUAL(event.getHits()[2].getTime(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(assignmentAfterClear)
+{
+  std::vector<JPetHit> hits(2);
+  hits[0].setTime(1);
+  hits[1].setTime(2);
+  JPetEvent event(hits, JPetEventType::k3Gamma);
+  event.setRecoFlag(JPetEvent::Good);
+  JPetEvent other({hits[1]}, JPetEventType::k2Gamma);
+  other.Clear();
+  other = event;
+  BOOST_REQUIRE_EQUAL(other.getHits().size(), 2u);
+  BOOST_REQUIRE_EQUAL(other.getHits()[0].getTime(), 1);
+  BOOST_REQUIRE_EQUAL(other.getHits()[1].getTime(), 2);
+  BOOST_REQUIRE(other.isOnlyTypeOf(JPetEventType::k3Gamma));
+  BOOST_REQUIRE_EQUAL(other.getRecoFlag(), JPetEvent::Good);
+  JPetEvent copy(other);
+  BOOST_REQUIRE_EQUAL(copy.getHits().size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(moveAssignmentKeepsPool)
+{
+  JPetEvent event({createHitWithPoints(1, 8)}, JPetEventType::k3Gamma);
+  event = JPetEvent({createHitWithPoints(2, 1)}, JPetEventType::k2Gamma);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 1u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 2);
+  BOOST_REQUIRE(event.isOnlyTypeOf(JPetEventType::k2Gamma));
+
+  event.addHit(createHitWithPoints(3, 1));
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 2u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[1].getTime(), 3);
+  BOOST_REQUIRE(getPointsCapacity(event.getHits()[1]) >= 8);
+}
+
+BOOST_AUTO_TEST_CASE(clearResetsNullSignals)
+{
+  JPetHit nullHit;
+  nullHit.setSignalA(JPetPhysSignal(true));
+  BOOST_REQUIRE(nullHit.getSignalA().isNullObject());
+  JPetHit clearedHit(nullHit);
+  clearedHit.Clear();
+  BOOST_REQUIRE(!clearedHit.getSignalA().isNullObject());
+
+  JPetEvent event({nullHit}, JPetEventType::k2Gamma);
+  event.Clear();
+  JPetHit hit;
+  hit.setSignalA(JPetPhysSignal());
+  event.addHit(hit);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 1u);
+  BOOST_REQUIRE(!event.getHits()[0].getSignalA().isNullObject());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
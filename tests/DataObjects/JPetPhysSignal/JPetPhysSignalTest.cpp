@@ -34,6 +34,14 @@ BOOST_AUTO_TEST_CASE(ConstructorTest)
   BOOST_CHECK_CLOSE(signal.getQualityOfPhe(), 0.f, epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(ClearResetsNullObjectTest)
+{
+  JPetPhysSignal signal(true);
+  BOOST_REQUIRE(signal.isNullObject());
+  signal.Clear();
+  BOOST_REQUIRE(!signal.isNullObject());
+}
+
 BOOST_AUTO_TEST_CASE(ScalarFieldsTest)
 {
   double epsilon = 1e-5;
@@ -17,11 +17,38 @@
 #define BOOST_TEST_MODULE JPetTSlotTest
 
 #include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetEvent/JPetEvent.h"
 #include "JPetHit/JPetHit.h"
 #include "JPetSigCh/JPetSigCh.h"
 
+#include <algorithm>
 #include <boost/test/unit_test.hpp>
 
+namespace
+{
+JPetHit createHitWithPoints(float time, int numberOfPoints)
+{
+  JPetRawSignal rawSignal;
+  for (int i = 0; i < numberOfPoints; i++)
+  {
+    rawSignal.addPoint(JPetSigCh(JPetSigCh::Leading, time + i));
+  }
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  JPetPhysSignal physSignal;
+  physSignal.setRecoSignal(recoSignal);
+  JPetHit hit;
+  hit.setTime(time);
+  hit.setSignalA(physSignal);
+  return hit;
+}
+
+std::size_t getPointsCapacity(const JPetHit& hit)
+{
+  return hit.getSignalA().getRecoSignal().getRawSignal().getUnsortedPoints(JPetSigCh::Leading).capacity();
+}
+} // namespace
+
 BOOST_AUTO_TEST_SUITE(FirstSuite)
 
 BOOST_AUTO_TEST_CASE(default_constructor)
@@ -56,4 +83,111 @@ BOOST_AUTO_TEST_CASE(clearing)
   BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(moveAndEmplace)
+{
+  JPetTimeWindow test("JPetSigCh");
+  test.add<JPetSigCh>(JPetSigCh(JPetSigCh::Leading, 1.5));
+  JPetSigCh channel(JPetSigCh::Trailing, 2.5);
+  test.add(std::move(channel));
+  auto& emplaced = test.emplace<JPetSigCh>(JPetSigCh::Leading, 3.5);
+  BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 3);
+  BOOST_REQUIRE_EQUAL(&emplaced, &test.getEvent<JPetSigCh>(2));
+  double epsilon = 0.001;
+  BOOST_REQUIRE_CLOSE(test.getEvent<JPetSigCh>(0).getValue(), 1.5, epsilon);
+  BOOST_REQUIRE_CLOSE(test.getEvent<JPetSigCh>(1).getValue(), 2.5, epsilon);
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetSigCh>(1).getType(), JPetSigCh::Trailing);
+  BOOST_REQUIRE_CLOSE(test.getEvent<JPetSigCh>(2).getValue(), 3.5, epsilon);
+}
+
+BOOST_AUTO_TEST_CASE(moveAndEmplaceKeepSlotStorage)
+{
+  JPetTimeWindow test("JPetEvent");
+  test.add<JPetEvent>(JPetEvent({createHitWithPoints(1, 8)}, JPetEventType::k2Gamma));
+  test.Clear();
+  test.add(JPetEvent({createHitWithPoints(2, 1)}, JPetEventType::k2Gamma));
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetEvent>(0).getHits().size(), 1u);
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetEvent>(0).getHits()[0].getTime(), 2);
+  test.Clear();
+  test.emplace<JPetEvent>(std::vector<JPetHit>{createHitWithPoints(3, 1)}, JPetEventType::k3Gamma);
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetEvent>(0).getHits()[0].getTime(), 3);
+  BOOST_REQUIRE(test.getEvent<JPetEvent>(0).isOnlyTypeOf(JPetEventType::k3Gamma));
+  test.Clear();
+
+  // The slot keeps the hits of all the previous events, including the one with 8 points
+  JPetEvent event({createHitWithPoints(4, 1), createHitWithPoints(5, 1), createHitWithPoints(6, 1)}, JPetEventType::k2Gamma);
+  test.add<JPetEvent>(event);
+  const auto& hits = test.getEvent<JPetEvent>(0).getHits();
+  BOOST_REQUIRE_EQUAL(hits.size(), 3u);
+  BOOST_REQUIRE(std::any_of(hits.begin(), hits.end(), [](const JPetHit& hit) { return getPointsCapacity(hit) >= 8; }));
+}
+
+BOOST_AUTO_TEST_CASE(addAllAndReserve)
+{
+  JPetTimeWindow test("JPetHit");
+  std::vector<JPetHit> hits(3);
+  hits[0].setTime(1);
+  hits[1].setTime(2);
+  hits[2].setTime(3);
+  test.addAll<JPetHit>(hits);
+  test.addAll<JPetHit>(std::move(hits));
+  BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 6);
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetHit>(2).getTime(), 3);
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetHit>(5).getTime(), 3);
+
+  test.reserve(5000);
+  BOOST_REQUIRE(test.getCapacity() >= 5000);
+  test.Clear();
+  BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 0);
+  BOOST_REQUIRE(test.getCapacity() >= 5000);
+}
+
+BOOST_AUTO_TEST_CASE(typedRange)
+{
+  JPetTimeWindow test("JPetHit");
+  for (auto time : {3.0f, 1.0f, 2.0f})
+  {
+    JPetHit hit;
+    hit.setTime(time);
+    test.add<JPetHit>(hit);
+  }
+  auto hits = test.getEvents<JPetHit>();
+  BOOST_REQUIRE_EQUAL(hits.size(), 3u);
+  BOOST_REQUIRE_EQUAL(hits.end() - hits.begin(), 3);
+  std::sort(hits.begin(), hits.end(), [](const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); });
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetHit>(0).getTime(), 1.0f);
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetHit>(2).getTime(), 3.0f);
+
+  const JPetTimeWindow& constTest = test;
+  float sum = 0.0f;
+  for (const auto& hit : constTest.getEvents<JPetHit>())
+  {
+    sum += hit.getTime();
+  }
+  BOOST_REQUIRE_EQUAL(sum, 6.0f);
+  auto firstLate = std::partition(hits.begin(), hits.end(), [](const JPetHit& hit) { return hit.getTime() > 1.5f; });
+  BOOST_REQUIRE_EQUAL(firstLate - hits.begin(), 2);
+  BOOST_CHECK_THROW(test.getEvents<JPetSigCh>(), std::bad_cast);
+}
+
+BOOST_AUTO_TEST_CASE(gatherFields)
+{
+  JPetTimeWindow test("JPetHit");
+  for (auto time : {3.0f, 1.0f})
+  {
+    JPetHit hit;
+    hit.setTime(time);
+    hit.setEnergy(10.0f * time);
+    test.add<JPetHit>(hit);
+  }
+  std::vector<float> times;
+  test.gather<JPetHit>(times, &JPetHit::getTime);
+  BOOST_REQUIRE_EQUAL(times.size(), 2u);
+  BOOST_REQUIRE_EQUAL(times[0], 3.0f);
+  BOOST_REQUIRE_EQUAL(times[1], 1.0f);
+  std::vector<double> energies;
+  test.gather<JPetHit>(energies, [](const JPetHit& hit) { return hit.getEnergy(); });
+  BOOST_REQUIRE_EQUAL(energies[0], 30.0);
+  BOOST_REQUIRE_EQUAL(energies[1], 10.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,120 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetWaveformBatchTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetWaveformBatchTest
+
+#include "JPetWaveformBatch/JPetWaveformBatch.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+/// Triangular negative pulse on a -10 mV baseline, sampled every 100 ps:
+/// flat for 20 points, falling by 10 mV per sample to -110 mV, then rising back.
+JPetRecoSignal makeTriangle(double baseline = -10.0)
+{
+  JPetRecoSignal signal;
+  int point = 0;
+  for (; point < 20; point++)
+  {
+    signal.setShapePoint(point * 100.0, baseline);
+  }
+  for (int step = 1; step <= 10; step++, point++)
+  {
+    signal.setShapePoint(point * 100.0, baseline - 10.0 * step);
+  }
+  for (int step = 9; step >= 0; step--, point++)
+  {
+    signal.setShapePoint(point * 100.0, baseline - 10.0 * step);
+  }
+  for (int i = 0; i < 13; i++, point++)
+  {
+    signal.setShapePoint(point * 100.0, baseline);
+  }
+  return signal;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(emptyBatch)
+{
+  JPetWaveformBatch batch;
+  BOOST_REQUIRE_EQUAL(batch.getNumberOfSignals(), 0u);
+  std::vector<float> baselines;
+  batch.calculateBaselines(10, baselines);
+  BOOST_REQUIRE(baselines.empty());
+}
+
+BOOST_AUTO_TEST_CASE(addSignal)
+{
+  JPetWaveformBatch batch;
+  JPetRecoSignal signal;
+  signal.setShapePoint(1.0, -2.0);
+  signal.setShapePoint(3.0, -4.0);
+  BOOST_REQUIRE_EQUAL(batch.addSignal(JPetRecoSignal()), 0u);
+  BOOST_REQUIRE_EQUAL(batch.addSignal(signal), 1u);
+  BOOST_REQUIRE_EQUAL(batch.getNumberOfSignals(), 2u);
+  BOOST_REQUIRE_EQUAL(batch.getNumberOfPoints(0), 0u);
+  BOOST_REQUIRE_EQUAL(batch.getNumberOfPoints(1), 2u);
+  BOOST_REQUIRE_EQUAL(batch.getTimes(1)[1], 3.0f);
+  BOOST_REQUIRE_EQUAL(batch.getAmplitudes(1)[0], -2.0f);
+  batch.clear();
+  BOOST_REQUIRE_EQUAL(batch.getNumberOfSignals(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(signalProperties)
+{
+  const float epsilon = 1e-3;
+  JPetWaveformBatch batch;
+  batch.addSignal(makeTriangle());
+  batch.addSignal(makeTriangle(-20.0));
+  BOOST_REQUIRE_EQUAL(batch.getNumberOfSignals(), 2u);
+  BOOST_REQUIRE_EQUAL(batch.getNumberOfPoints(0), 53u);
+
+  std::vector<float> baselines, amplitudes, charges, times;
+  batch.calculateBaselines(10, baselines);
+  BOOST_REQUIRE_CLOSE(baselines[0], -10.0f, epsilon);
+  BOOST_REQUIRE_CLOSE(baselines[1], -20.0f, epsilon);
+
+  batch.calculateAmplitudes(baselines, amplitudes);
+  BOOST_REQUIRE_CLOSE(amplitudes[0], 100.0f, epsilon);
+  BOOST_REQUIRE_CLOSE(amplitudes[1], 100.0f, epsilon);
+
+  batch.calculateCharges(baselines, charges);
+  BOOST_REQUIRE_CLOSE(charges[0], 100.0f * 2000.0f / 2.0f, epsilon);
+
+  batch.calculateThresholdTimes(baselines, 25.0f, times);
+  BOOST_REQUIRE_CLOSE(times[0], 2150.0f, epsilon);
+  BOOST_REQUIRE_CLOSE(times[1], 2150.0f, epsilon);
+
+  batch.calculateThresholdTimes(baselines, 200.0f, times);
+  BOOST_REQUIRE_EQUAL(times[0], JPetWaveformBatch::Unset);
+
+  batch.calculateConstantFractionTimes(baselines, amplitudes, 0.5f, times);
+  BOOST_REQUIRE_CLOSE(times[0], 2400.0f, epsilon);
+}
+
+BOOST_AUTO_TEST_CASE(crossingTime)
+{
+  const float times[] = {0.0f, 1.0f, 2.0f};
+  const float amplitudes[] = {-1.0f, -3.0f, -5.0f};
+  BOOST_REQUIRE_CLOSE(JPetWaveformBatch::crossingTime(times, amplitudes, 3, -2.0f), 0.5f, 1e-3);
+  BOOST_REQUIRE_EQUAL(JPetWaveformBatch::crossingTime(times, amplitudes, 3, 0.0f), 0.0f);
+  BOOST_REQUIRE_EQUAL(JPetWaveformBatch::crossingTime(times, amplitudes, 3, -6.0f), JPetWaveformBatch::Unset);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -126,6 +126,17 @@ BOOST_AUTO_TEST_CASE(areCorrectSomeOptionsWork)
   BOOST_REQUIRE(validator.areCorrectOptions(options, v));
 }
 
+BOOST_AUTO_TEST_CASE(isShardValid)
+{
+  auto shard = [](std::vector<int> value) { return std::make_pair(std::string("shard_std::vector<int>"), boost::any(value)); };
+  BOOST_REQUIRE(JPetOptionValidator::isShardValid(shard({0, 1})));
+  BOOST_REQUIRE(JPetOptionValidator::isShardValid(shard({15, 16})));
+  BOOST_REQUIRE(!JPetOptionValidator::isShardValid(shard({16, 16})));
+  BOOST_REQUIRE(!JPetOptionValidator::isShardValid(shard({-1, 16})));
+  BOOST_REQUIRE(!JPetOptionValidator::isShardValid(shard({0, 0})));
+  BOOST_REQUIRE(!JPetOptionValidator::isShardValid(shard({3})));
+}
+
 BOOST_AUTO_TEST_CASE(areCorrectExtensions)
 {
   std::string scopeType = "scope";
@@ -0,0 +1,54 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetOptionsClassTest
+
+#include "JPetOptionsTools/JPetOptions.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(keysAreInterned)
+{
+  JPetOptions::Key key1("JPetOptionsTest_First_int");
+  JPetOptions::Key key2("JPetOptionsTest_Second_int");
+  JPetOptions::Key key3("JPetOptionsTest_First_int");
+  BOOST_REQUIRE_EQUAL(key1.getId(), key3.getId());
+  BOOST_REQUIRE(key1.getId() != key2.getId());
+  BOOST_REQUIRE_EQUAL(key2.getName(), "JPetOptionsTest_Second_int");
+}
+
+BOOST_AUTO_TEST_CASE(typedAccess)
+{
+  JPetOptions::OptsStrAny map = {{"JPetOptionsTest_Int_int", 5},
+                                 {"JPetOptionsTest_Bool_bool", true},
+                                 {"JPetOptionsTest_Names_std::vector<std::string>", std::vector<std::string>{"a", "b"}}};
+  auto options = JPetOptions::create(map);
+  BOOST_REQUIRE_EQUAL(options->size(), 3u);
+  BOOST_REQUIRE_EQUAL(options->getMap().size(), 3u);
+
+  JPetOptions::Key intKey("JPetOptionsTest_Int_int");
+  JPetOptions::Key boolKey("JPetOptionsTest_Bool_bool");
+  JPetOptions::Key namesKey("JPetOptionsTest_Names_std::vector<std::string>");
+  BOOST_REQUIRE(options->isSet(intKey));
+  BOOST_REQUIRE_EQUAL(options->get<int>(intKey), 5);
+  BOOST_REQUIRE(options->get<bool>(boolKey));
+  BOOST_REQUIRE_EQUAL(options->get<std::vector<std::string>>(namesKey).size(), 2u);
+  BOOST_REQUIRE(options->getIf<int>(intKey));
+  BOOST_REQUIRE(!options->getIf<double>(intKey));
+  BOOST_REQUIRE_THROW(options->get<std::string>(intKey), boost::bad_any_cast);
+}
+
+BOOST_AUTO_TEST_CASE(missingOption)
+{
+  auto options = JPetOptions::create(JPetOptions::OptsStrAny{{"JPetOptionsTest_Set_int", 1}});
+  /// the key created after the options
+  JPetOptions::Key missingKey("JPetOptionsTest_NotSetAnywhere_int");
+  BOOST_REQUIRE(!options->isSet(missingKey));
+  BOOST_REQUIRE(!options->getIf<int>(missingKey));
+  BOOST_REQUIRE_EQUAL(options->get(missingKey, 7), 7);
+  BOOST_REQUIRE_THROW(options->get<int>(missingKey), std::out_of_range);
+  BOOST_REQUIRE(!JPetOptions::getEmpty()->isSet(missingKey));
+  BOOST_REQUIRE_EQUAL(JPetOptions::getEmpty()->size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
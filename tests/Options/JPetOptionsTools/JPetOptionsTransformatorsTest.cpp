@@ -35,4 +35,17 @@ BOOST_AUTO_TEST_CASE(checkIfFunctionsToTransformOptionWork)
   BOOST_REQUIRE_EQUAL(any_cast<std::string>(appendSlash(pathForCorrection).second), correctPath);
 }
 
+BOOST_AUTO_TEST_CASE(generateShard)
+{
+  std::vector<int> shard = {3, 16};
+  BOOST_REQUIRE_EQUAL(generateShardIndex(shard).first, "shardIndex_int");
+  BOOST_REQUIRE_EQUAL(any_cast<int>(generateShardIndex(shard).second), 3);
+  BOOST_REQUIRE_EQUAL(generateNumberOfShards(shard).first, "numberOfShards_int");
+  BOOST_REQUIRE_EQUAL(any_cast<int>(generateNumberOfShards(shard).second), 16);
+
+  std::vector<int> wrongShard = {3};
+  BOOST_REQUIRE_EQUAL(generateShardIndex(wrongShard).first, "wrongShardIndex_int");
+  BOOST_REQUIRE_EQUAL(generateNumberOfShards(wrongShard).first, "wrongNumberOfShards_int");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -49,6 +49,9 @@ BOOST_AUTO_TEST_CASE(copyCtr)
   auto params2 = params;
   BOOST_REQUIRE_EQUAL(params2.getParamManager(), mgr.get());
   BOOST_REQUIRE_EQUAL(params2.getOptions().size(), params.getOptions().size());
+  /// the options are shared, not copied
+  BOOST_REQUIRE_EQUAL(params2.getSharedOptions(), params.getSharedOptions());
+  BOOST_REQUIRE_EQUAL(&params2.getOptions(), &params.getOptions());
 }
 
 BOOST_AUTO_TEST_CASE(memoryLeaks)
@@ -0,0 +1,229 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDDecoderTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetHLDDecoderTest
+
+#include "JPetHLDLoader/JPetHLDDecoder.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+using Words = std::vector<std::uint32_t>;
+
+void appendWord(std::string& out, std::uint32_t word, bool bigEndian)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    int shift = bigEndian ? 24 - 8 * i : 8 * i;
+    out.push_back(static_cast<char>((word >> shift) & 0xff));
+  }
+}
+
+std::uint32_t timeWord(unsigned int channel, unsigned int fine, bool rising, unsigned int coarse)
+{
+  return 0x80000000u | (channel << 22) | (fine << 12) | (rising ? 1u << 11 : 0u) | coarse;
+}
+
+std::uint32_t epochWord(unsigned int epoch) { return 0x60000000u | epoch; }
+
+/// Event with a single big-endian subevent from the hub 0x8000,
+/// containing the data of the TDC 0xa110 nested in the block of the hub.
+std::string makeEvent(unsigned int sequenceNumber, const Words& tdcWords)
+{
+  Words data;
+  data.push_back(((tdcWords.size() + 1) << 16) | 0x8000);
+  data.push_back((tdcWords.size() << 16) | 0xa110);
+  data.insert(data.end(), tdcWords.begin(), tdcWords.end());
+  data.push_back((1 << 16) | 0x5555);
+  data.push_back(0x00000001);
+
+  std::string subEvent;
+  appendWord(subEvent, 16 + 4 * data.size(), true);
+  appendWord(subEvent, 0x00020001, true);
+  appendWord(subEvent, 0x8000, true);
+  appendWord(subEvent, sequenceNumber, true);
+  for (auto word : data)
+  {
+    appendWord(subEvent, word, true);
+  }
+
+  std::string event;
+  Words header = {static_cast<std::uint32_t>(32 + subEvent.size()), 0x00030001, 0x00002001, sequenceNumber, 0, 0, 42, 0};
+  for (auto word : header)
+  {
+    appendWord(event, word, false);
+  }
+  event += subEvent;
+  event.resize((event.size() + 7) & ~std::size_t(7), '\0');
+  return event;
+}
+
+std::string makeFileHeaderEvent()
+{
+  std::string event;
+  Words header = {32, 0x00030001, 0x00010002, 0, 0, 0, 42, 0};
+  for (auto word : header)
+  {
+    appendWord(event, word, false);
+  }
+  return event;
+}
+
+void writeFile(const std::string& fileName, const std::string& content)
+{
+  std::ofstream out(fileName, std::ios::binary);
+  out.write(content.data(), content.size());
+}
+}
+
+BOOST_AUTO_TEST_SUITE(JPetHLDDecoderTestSuite)
+
+BOOST_AUTO_TEST_CASE(loadConfig)
+{
+  writeFile("hldDecoderTestConfig.xml", "<READOUT><DATA_SOURCE><TYPE>TRB3_S</TYPE><TRBNET_ADDRESS>8000</TRBNET_ADDRESS><MODULES>"
+                                        "<MODULE><TYPE>LATTICE_TDC</TYPE><TRBNET_ADDRESS>a110</TRBNET_ADDRESS>"
+                                        "<NUMBER_OF_CHANNELS>65</NUMBER_OF_CHANNELS><CHANNEL_OFFSET>130</CHANNEL_OFFSET></MODULE>"
+                                        "</MODULES></DATA_SOURCE></READOUT>");
+  JPetHLDDecoder decoder;
+  BOOST_REQUIRE(decoder.loadConfig("hldDecoderTestConfig.xml"));
+  BOOST_REQUIRE_EQUAL(decoder.getTDCs().size(), 1u);
+  BOOST_REQUIRE_EQUAL(decoder.getTDCs().at(0xa110).channelOffset, 130u);
+  BOOST_REQUIRE_EQUAL(decoder.getTDCs().at(0xa110).numberOfChannels, 65u);
+  boost::filesystem::remove("hldDecoderTestConfig.xml");
+  BOOST_REQUIRE(!decoder.loadConfig("notExistingConfig.xml"));
+}
+
+BOOST_AUTO_TEST_CASE(decodeEvent)
+{
+  JPetHLDDecoder decoder;
+  decoder.addHub(0x8000);
+  decoder.addTDC(0xa110, 130, 65);
+  decoder.setFineTimeRange(0, 500);
+  Words tdcWords = {0x20000000, epochWord(7), timeWord(0, 100, true, 20), timeWord(3, 100, true, 30), timeWord(3, 350, false, 32),
+                    epochWord(8), timeWord(70, 100, true, 1)};
+  auto eventData = makeEvent(5, tdcWords);
+  JPetHLDEvent event;
+  BOOST_REQUIRE(decoder.decodeEvent(eventData.data(), eventData.size(), event));
+  BOOST_REQUIRE_EQUAL(event.sequenceNumber, 5u);
+  BOOST_REQUIRE_EQUAL(event.runNumber, 42u);
+  BOOST_REQUIRE_EQUAL(event.hits.size(), 2u);
+  BOOST_REQUIRE_EQUAL(event.hits[0].channel, 133u);
+  BOOST_REQUIRE(event.hits[0].isLeading);
+  BOOST_REQUIRE_CLOSE(event.hits[0].time, 10 * 5000.0, 1e-9);
+  BOOST_REQUIRE_EQUAL(event.hits[1].channel, 133u);
+  BOOST_REQUIRE(!event.hits[1].isLeading);
+  BOOST_REQUIRE_CLOSE(event.hits[1].time, 12 * 5000.0 - 250 * 10.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(missingReference)
+{
+  JPetHLDDecoder decoder;
+  decoder.addHub(0x8000);
+  decoder.addTDC(0xa110, 0, 65);
+  auto eventData = makeEvent(1, {epochWord(1), timeWord(1, 100, true, 20), timeWord(2, 100, true, 20)});
+  JPetHLDEvent event;
+  BOOST_REQUIRE(decoder.decodeEvent(eventData.data(), eventData.size(), event));
+  BOOST_REQUIRE(event.hits.empty());
+  BOOST_REQUIRE_EQUAL(event.hitsWithoutReference, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(unknownEndpointIsSkipped)
+{
+  JPetHLDDecoder decoder;
+  decoder.addTDC(0xa111, 0, 65);
+  auto eventData = makeEvent(1, {timeWord(0, 100, true, 20), timeWord(1, 100, true, 20)});
+  JPetHLDEvent event;
+  BOOST_REQUIRE(decoder.decodeEvent(eventData.data(), eventData.size(), event));
+  BOOST_REQUIRE(event.hits.empty());
+}
+
+BOOST_AUTO_TEST_CASE(readFile)
+{
+  std::string content = makeFileHeaderEvent();
+  for (unsigned int i = 0; i < 10; i++)
+  {
+    content += makeEvent(i, {epochWord(0), timeWord(0, 100, true, 20), timeWord(1, 100, true, 20 + i)});
+  }
+  writeFile("hldDecoderTest.hld", content);
+  JPetHLDDecoder decoder;
+  decoder.addHub(0x8000);
+  decoder.addTDC(0xa110, 0, 65);
+  BOOST_REQUIRE(decoder.open("hldDecoderTest.hld"));
+  BOOST_REQUIRE_EQUAL(decoder.skipEvents(3), 3);
+  JPetHLDEvent event;
+  unsigned int expected = 3;
+  while (decoder.nextEvent(event))
+  {
+    BOOST_REQUIRE_EQUAL(event.sequenceNumber, expected);
+    BOOST_REQUIRE_EQUAL(event.hits.size(), 1u);
+    BOOST_REQUIRE_CLOSE(event.hits[0].time + 1.0, expected * 5000.0 + 1.0, 1e-9);
+    expected++;
+  }
+  BOOST_REQUIRE_EQUAL(expected, 10u);
+  BOOST_REQUIRE(!decoder.hasError());
+  BOOST_REQUIRE_EQUAL(decoder.getNumberOfReadEvents(), 10);
+
+  writeFile("hldDecoderTestTruncated.hld", content.substr(0, content.size() - 12));
+  BOOST_REQUIRE(decoder.open("hldDecoderTestTruncated.hld"));
+  BOOST_REQUIRE_EQUAL(decoder.skipEvents(20), 9);
+  BOOST_REQUIRE(decoder.hasError());
+  decoder.close();
+  boost::filesystem::remove("hldDecoderTest.hld");
+  boost::filesystem::remove("hldDecoderTestTruncated.hld");
+  BOOST_REQUIRE(!decoder.open("hldDecoderTest.hld"));
+}
+
+BOOST_AUTO_TEST_CASE(readRange)
+{
+  std::string content = makeFileHeaderEvent();
+  std::vector<std::uint64_t> offsets;
+  for (unsigned int i = 0; i < 10; i++)
+  {
+    offsets.push_back(content.size());
+    content += makeEvent(i, {epochWord(0), timeWord(0, 100, true, 20), timeWord(1, 100, true, 20 + i)});
+  }
+  writeFile("hldDecoderTest.hld", content);
+  JPetHLDDecoder config;
+  config.addHub(0x8000);
+  config.addTDC(0xa110, 0, 65);
+  JPetHLDDecoder decoder;
+  decoder.setConfiguration(config);
+  BOOST_REQUIRE(decoder.open("hldDecoderTest.hld"));
+  BOOST_REQUIRE(decoder.isSeekable());
+  BOOST_REQUIRE(decoder.seek(offsets[4], 4));
+  decoder.setEndOffset(offsets[7]);
+  JPetHLDEvent event;
+  unsigned int expected = 4;
+  while (decoder.nextEvent(event))
+  {
+    BOOST_REQUIRE_EQUAL(event.sequenceNumber, expected);
+    BOOST_REQUIRE_EQUAL(event.hits.size(), 1u);
+    expected++;
+  }
+  BOOST_REQUIRE_EQUAL(expected, 7u);
+  BOOST_REQUIRE_EQUAL(decoder.getNumberOfReadEvents(), 7);
+  BOOST_REQUIRE_EQUAL(decoder.getCurrentOffset(), offsets[7]);
+  BOOST_REQUIRE(!decoder.hasError());
+  decoder.close();
+  boost::filesystem::remove("hldDecoderTest.hld");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDIndexTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetHLDIndexTest
+
+#include "JPetHLDLoader/JPetHLDIndex.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+/// Event of the given size (not padded) with an empty payload, followed by the padding.
+std::string makeEvent(std::uint32_t size)
+{
+  std::string event(size, '\0');
+  std::uint32_t header[2] = {size, 0x00030001};
+  std::memcpy(&event[0], header, sizeof(header));
+  event.resize((size + 7) & ~std::uint32_t(7), '\0');
+  return event;
+}
+
+/// File header event followed by 10 events of different sizes.
+std::string makeFile(std::vector<std::uint64_t>& offsets)
+{
+  std::string content = makeEvent(32);
+  for (unsigned int i = 0; i < 10; i++)
+  {
+    offsets.push_back(content.size());
+    content += makeEvent(48 + 4 * i);
+  }
+  return content;
+}
+
+void writeFile(const std::string& fileName, const std::string& content)
+{
+  std::ofstream out(fileName, std::ios::binary);
+  out.write(content.data(), content.size());
+}
+}
+
+BOOST_AUTO_TEST_SUITE(JPetHLDIndexTestSuite)
+
+BOOST_AUTO_TEST_CASE(buildIndex)
+{
+  std::vector<std::uint64_t> offsets;
+  auto content = makeFile(offsets);
+  writeFile("hldIndexTest.hld", content);
+  JPetHLDIndex index;
+  BOOST_REQUIRE(index.build("hldIndexTest.hld"));
+  BOOST_REQUIRE_EQUAL(index.getNumberOfEvents(), 10);
+  BOOST_REQUIRE_EQUAL(index.getFileSize(), content.size());
+  for (unsigned int i = 0; i < offsets.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(index.getEventOffset(i), offsets[i]);
+  }
+  BOOST_REQUIRE_EQUAL(index.getEventOffset(10), content.size());
+
+  writeFile("hldIndexTest.hld", content.substr(0, content.size() - 20));
+  BOOST_REQUIRE(index.build("hldIndexTest.hld"));
+  BOOST_REQUIRE_EQUAL(index.getNumberOfEvents(), 9);
+  boost::filesystem::remove("hldIndexTest.hld");
+  BOOST_REQUIRE(!index.build("hldIndexTest.hld"));
+}
+
+BOOST_AUTO_TEST_CASE(indexFileIsReused)
+{
+  std::vector<std::uint64_t> offsets;
+  auto content = makeFile(offsets);
+  writeFile("hldIndexTest.hld", content);
+  auto indexFileName = JPetHLDIndex::getIndexFileName("hldIndexTest.hld");
+  boost::filesystem::remove(indexFileName);
+
+  JPetHLDIndex index;
+  BOOST_REQUIRE(!index.load("hldIndexTest.hld"));
+  BOOST_REQUIRE(index.loadOrBuild("hldIndexTest.hld"));
+  BOOST_REQUIRE(boost::filesystem::exists(indexFileName));
+
+  JPetHLDIndex loaded;
+  BOOST_REQUIRE(loaded.load("hldIndexTest.hld"));
+  BOOST_REQUIRE_EQUAL(loaded.getNumberOfEvents(), 10);
+  BOOST_REQUIRE_EQUAL(loaded.getEventOffset(5), offsets[5]);
+
+  /// the index of the modified file is not used
+  writeFile("hldIndexTest.hld", content + makeEvent(40));
+  BOOST_REQUIRE(!loaded.load("hldIndexTest.hld"));
+  BOOST_REQUIRE(loaded.loadOrBuild("hldIndexTest.hld"));
+  BOOST_REQUIRE_EQUAL(loaded.getNumberOfEvents(), 11);
+
+  writeFile(indexFileName, "corrupted");
+  BOOST_REQUIRE(!loaded.load("hldIndexTest.hld"));
+  boost::filesystem::remove(indexFileName);
+  boost::filesystem::remove("hldIndexTest.hld");
+}
+
+BOOST_AUTO_TEST_CASE(splitIntoRanges)
+{
+  std::vector<std::uint64_t> offsets;
+  auto content = makeFile(offsets);
+  writeFile("hldIndexTest.hld", content);
+  JPetHLDIndex index;
+  BOOST_REQUIRE(index.build("hldIndexTest.hld"));
+  boost::filesystem::remove("hldIndexTest.hld");
+
+  auto range = index.getRange(2, 4);
+  BOOST_REQUIRE_EQUAL(range.firstEvent, 2);
+  BOOST_REQUIRE_EQUAL(range.lastEvent, 4);
+  BOOST_REQUIRE_EQUAL(range.beginOffset, offsets[2]);
+  BOOST_REQUIRE_EQUAL(range.endOffset, offsets[5]);
+
+  auto ranges = index.split(1, -1, 4);
+  BOOST_REQUIRE_EQUAL(ranges.size(), 4u);
+  BOOST_REQUIRE_EQUAL(ranges.front().firstEvent, 1);
+  BOOST_REQUIRE_EQUAL(ranges.front().beginOffset, offsets[1]);
+  BOOST_REQUIRE_EQUAL(ranges.back().lastEvent, 9);
+  BOOST_REQUIRE_EQUAL(ranges.back().endOffset, content.size());
+  for (std::size_t i = 1; i < ranges.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(ranges[i].firstEvent, ranges[i - 1].lastEvent + 1);
+    BOOST_REQUIRE_EQUAL(ranges[i].beginOffset, ranges[i - 1].endOffset);
+  }
+
+  BOOST_REQUIRE_EQUAL(index.split(8, 20, 5).size(), 2u);
+  BOOST_REQUIRE(index.split(10, 20, 2).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
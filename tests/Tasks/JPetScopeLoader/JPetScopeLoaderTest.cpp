@@ -24,6 +24,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 #include <cstddef>
+#include <fstream>
 #include <functional>
 
 BOOST_AUTO_TEST_SUITE(JPetScopeLoaderTestSuite)
@@ -67,6 +68,75 @@ BOOST_AUTO_TEST_CASE(createInputScopeFileNames)
   }
 }
 
+BOOST_AUTO_TEST_CASE(scanInputScopeFiles)
+{
+  JPetScopeLoader reader(0);
+  auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(dir);
+  for (const auto& name : {"C1_00003.txt", "C2_00003.txt", "C1_00004.txt", "C2_00005.txt", "C3_00004.txt", "C1_00006.gif"})
+  {
+    std::ofstream((dir / name).string());
+  }
+  std::vector<JPetScopeLoader::TimeWindowFiles> windows;
+  auto callback = [&windows](JPetScopeLoader::TimeWindowFiles&& window) {
+    windows.push_back(std::move(window));
+    return true;
+  };
+  BOOST_REQUIRE(reader.scanInputScopeFiles(dir.string(), {{"C1", 0}, {"C2", 1}}, callback));
+  std::map<int, std::size_t> sizes;
+  for (const auto& window : windows)
+  {
+    sizes[window.first] = window.second.size();
+  }
+  std::map<int, std::size_t> expectedSizes{{3, 2}, {4, 1}, {5, 1}};
+  BOOST_REQUIRE(sizes == expectedSizes);
+  /// The windows are passed in the order of their indices, also the complete ones.
+  BOOST_REQUIRE_EQUAL(windows[0].first, 3);
+  BOOST_REQUIRE_EQUAL(windows[1].first, 4);
+  BOOST_REQUIRE_EQUAL(windows[2].first, 5);
+  BOOST_REQUIRE_EQUAL(windows[0].second[(dir / "C2_00003.txt").string()], 1);
+
+  std::size_t calls = 0;
+  BOOST_REQUIRE(!reader.scanInputScopeFiles(dir.string(), {{"C1", 0}}, [&calls](JPetScopeLoader::TimeWindowFiles&&) {
+    calls++;
+    return false;
+  }));
+  BOOST_REQUIRE_EQUAL(calls, 1u);
+  BOOST_REQUIRE(!reader.scanInputScopeFiles("non_existing", {{"C1", 0}}, callback));
+  boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(scanInputScopeFilesWithGaps)
+{
+  JPetScopeLoader reader(0);
+  auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(dir / "repeated");
+  for (const auto& name : {"C1_00003.txt", "C2_00003.txt", "C2_00005.txt", "C1_00005.txt", "C1_00009.txt", "C1_00006.txt",
+                           "C2_00006.txt", "repeated/C1_00005.txt"})
+  {
+    std::ofstream((dir / name).string());
+  }
+  std::vector<JPetScopeLoader::TimeWindowFiles> windows;
+  auto callback = [&windows](JPetScopeLoader::TimeWindowFiles&& window) {
+    windows.push_back(std::move(window));
+    return true;
+  };
+  /// two prefixes of the same photomultiplier, the window is complete only with the files of both of them
+  BOOST_REQUIRE(reader.scanInputScopeFiles(dir.string(), {{"C1", 0}, {"C2", 0}}, callback));
+  std::map<int, std::size_t> files;
+  for (const auto& window : windows)
+  {
+    files[window.first] += window.second.size();
+  }
+  /// the windows start from 3, the missing indices do not stop the complete ones
+  /// and the file with the repeated prefix is kept
+  std::map<int, std::size_t> expectedFiles{{3, 2}, {5, 3}, {6, 2}, {9, 1}};
+  BOOST_REQUIRE(files == expectedFiles);
+  BOOST_REQUIRE_EQUAL(windows.back().first, 9);
+  BOOST_REQUIRE_EQUAL(windows.back().second.size(), 1u);
+  boost::filesystem::remove_all(dir);
+}
+
 BOOST_AUTO_TEST_CASE(isCorrectScopeFileName)
 {
   JPetScopeLoader reader(0);
@@ -0,0 +1,117 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeFileParserTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetScopeFileParserTest
+
+#include "JPetScopeTask/JPetScopeFileParser.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <fstream>
+
+BOOST_AUTO_TEST_SUITE(JPetScopeFileParserTestSuite)
+
+BOOST_AUTO_TEST_CASE(parseNumber)
+{
+  std::vector<std::pair<std::string, double>> cases = {
+      {"0", 0.},         {"12", 12.},          {"-12", -12.},        {"+3.5", 3.5},           {"  \t\n-1.25e-3", -1.25e-3},
+      {"6.02E23", 6.02e23}, {"-2.4e-010", -2.4e-10}, {".5", 0.5},      {"1.", 1.},              {"123456789012345678901234", 123456789012345678901234.}};
+  for (const auto& el : cases)
+  {
+    const char* pos = el.first.c_str();
+    double value = 0.;
+    BOOST_REQUIRE(JPetScopeFileParser::parseNumber(pos, el.first.c_str() + el.first.size(), value));
+    BOOST_REQUIRE_CLOSE(value, el.second, 1e-10);
+    BOOST_REQUIRE(pos == el.first.c_str() + el.first.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parseNumber_wrong)
+{
+  std::vector<std::string> cases = {"", "  ", "abc", "-", ".", "e5"};
+  for (const auto& el : cases)
+  {
+    const char* pos = el.c_str();
+    double value = 7.;
+    BOOST_REQUIRE(!JPetScopeFileParser::parseNumber(pos, el.c_str() + el.size(), value));
+    BOOST_REQUIRE(pos == el.c_str());
+    BOOST_REQUIRE_EQUAL(value, 7.);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parseNumber_stopsAtSeparator)
+{
+  std::string text = "1.5e2 -3\n";
+  const char* pos = text.c_str();
+  const char* end = text.c_str() + text.size();
+  double first = 0., second = 0.;
+  BOOST_REQUIRE(JPetScopeFileParser::parseNumber(pos, end, first));
+  BOOST_REQUIRE(JPetScopeFileParser::parseNumber(pos, end, second));
+  BOOST_REQUIRE_CLOSE(first, 150., 1e-10);
+  BOOST_REQUIRE_CLOSE(second, -3., 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(parseContent)
+{
+  std::string text = "LECROYWR6100A,47110,Waveform\n"
+                     "Segments 1 SegmentSize 3\n"
+                     "Segment,TrigTime,TimeSinceSegment1\n"
+                     "#1,25-Nov-2015 11:33:03,0\n"
+                     "Time,Ampl\n"
+                     "-1.5e-09 -0.001\n"
+                     "-1.4e-09\t-0.0025\r\n"
+                     "-1.3e-09 0.002\n";
+  auto signal = JPetScopeFileParser::parseContent(text.c_str(), text.c_str() + text.size(), true);
+  BOOST_REQUIRE_EQUAL(signal.getShape().size(), 3u);
+  BOOST_REQUIRE_CLOSE(signal.getShape()[0].time, -1500., 1e-3);
+  BOOST_REQUIRE_CLOSE(signal.getShape()[0].amplitude, -1., 1e-3);
+  BOOST_REQUIRE_CLOSE(signal.getShape()[1].time, -1400., 1e-3);
+  BOOST_REQUIRE_CLOSE(signal.getShape()[1].amplitude, -2.5, 1e-3);
+  BOOST_REQUIRE_CLOSE(signal.getShape()[2].amplitude, 2., 1e-3);
+  auto noHeader = JPetScopeFileParser::parseContent(text.c_str(), text.c_str() + text.size(), false);
+  BOOST_REQUIRE(noHeader.getShape().empty());
+}
+
+BOOST_AUTO_TEST_CASE(parseFiles_keepsOrder)
+{
+  auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(dir);
+  std::vector<std::string> fileNames;
+  for (int i = 1; i <= 20; i++)
+  {
+    auto fileName = (dir / ("C1_" + std::to_string(i) + ".txt")).string();
+    std::ofstream out(fileName);
+    out << "header\nSegments 1 SegmentSize " << i << "\n\n\n\n";
+    for (int j = 0; j < i; j++)
+    {
+      out << j << "e-12 " << i << "e-3\n";
+    }
+    fileNames.push_back(fileName);
+  }
+  fileNames.push_back((dir / "C1_999.txt").string());
+  auto signals = JPetScopeFileParser::parseFiles(fileNames, 4);
+  BOOST_REQUIRE_EQUAL(signals.size(), fileNames.size());
+  for (int i = 1; i <= 20; i++)
+  {
+    BOOST_REQUIRE_EQUAL(signals[i - 1].getShape().size(), static_cast<std::size_t>(i));
+    BOOST_REQUIRE_CLOSE(signals[i - 1].getShape().back().time, i - 1., 1e-3);
+    BOOST_REQUIRE_CLOSE(signals[i - 1].getShape().back().amplitude, i, 1e-3);
+  }
+  BOOST_REQUIRE(signals.back().getShape().empty());
+  boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
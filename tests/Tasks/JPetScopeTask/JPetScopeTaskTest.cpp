@@ -0,0 +1,61 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeTaskTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetScopeTaskTest
+
+#include "JPetScopeTask/JPetScopeTask.h"
+#include "JPetRecoSignal/JPetRecoSignal.h"
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+class JPetScopeTaskTester : public JPetScopeTask
+{
+public:
+  JPetScopeTaskTester() : JPetScopeTask("scopeTaskTester")
+  {
+    fBaselinePoints = 2;
+    fThresholds = {50, 200};
+  }
+  using JPetScopeTask::calculateSignalProperties;
+};
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(uncrossedThresholdsAreNotSet)
+{
+  JPetRecoSignal signal;
+  signal.setShapePoint(0.0, 0.0);
+  signal.setShapePoint(100.0, 0.0);
+  signal.setShapePoint(200.0, -100.0);
+  signal.setShapePoint(300.0, 0.0);
+  JPetRecoSignal flatSignal;
+  flatSignal.setShapePoint(0.0, 0.0);
+  flatSignal.setShapePoint(100.0, 0.0);
+  flatSignal.setShapePoint(200.0, 0.0);
+  std::vector<JPetRecoSignal> signals = {signal, flatSignal};
+
+  JPetScopeTaskTester task;
+  task.calculateSignalProperties(signals);
+  const auto& times = signals[0].getRecoTimesAtThreshold();
+  BOOST_REQUIRE_EQUAL(times.size(), 2u);
+  BOOST_REQUIRE_EQUAL(times.count(0.5f), 1u);
+  BOOST_REQUIRE_EQUAL(times.count(50.0f), 1u);
+  BOOST_REQUIRE_CLOSE(signals[0].getAmplitude(), 100.0, 0.001);
+  BOOST_REQUIRE(signals[1].getRecoTimesAtThreshold().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -61,4 +61,21 @@ BOOST_AUTO_TEST_CASE(polynomialFitTest2)
   BOOST_REQUIRE_CLOSE(result, 793.1, epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(leadingEdgeFitterBatchTest)
+{
+  std::vector<float> time = {1035.0, 1542.0, 2282.0, 2900.0, 1035.0, 1542.0, 2282.0, 2900.0, 500.0};
+  std::vector<float> volt = {-0.06, -0.20, -0.35, -0.50, -0.06, -0.20, -0.35, -0.50, -0.1};
+  std::vector<int> offsets = {0, 4, 8, 9};
+  std::vector<float> results(3);
+  LeadingEdgeFitter fitter(1, -0.10);
+  fitter.fitAll(time.data(), volt.data(), offsets.data(), 3, results.data());
+  float epsilon = 0.1;
+  BOOST_REQUIRE_CLOSE(results[0], 1171.98, epsilon);
+  BOOST_REQUIRE_CLOSE(results[1], 1171.98, epsilon);
+  BOOST_REQUIRE_CLOSE(results[2], 500.0, epsilon);
+  LeadingEdgeFitter fitter2(2, -0.05);
+  BOOST_REQUIRE_CLOSE(fitter2.fit(time.data(), volt.data(), 4), 793.1, epsilon);
+  BOOST_REQUIRE_CLOSE(fitter2.fit(time.data(), volt.data(), 0), -1.0, epsilon);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
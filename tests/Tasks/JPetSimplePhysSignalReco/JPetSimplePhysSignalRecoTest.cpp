@@ -0,0 +1,63 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSimplePhysSignalRecoTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetSimplePhysSignalRecoTest
+
+#include "JPetSimplePhysSignalReco/JPetSimplePhysSignalReco.h"
+#include "JPetSimplePhysSignalReco/HelperMathFunctions.h"
+#include "JPetRecoSignal/JPetRecoSignal.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(defaultFitterWithoutConfig)
+{
+  JPetSimplePhysSignalReco task;
+  task.readConfigFileAndSetAlphaAndThreshParams("nonExistingConfigParams.json");
+  BOOST_REQUIRE_EQUAL(task.getAlpha(), 1);
+  BOOST_REQUIRE_CLOSE(task.getThresholdSel(), -1.0, 0.001);
+
+  std::vector<float> times = {2900.0, 2282.0, 1542.0, 1035.0};
+  std::vector<float> thresholds = {-0.50, -0.35, -0.20, -0.06};
+  JPetRawSignal rawSignal;
+  for (std::size_t i = 0; i < times.size(); i++)
+  {
+    JPetSigCh leading(JPetSigCh::Leading, times[i]);
+    leading.setThreshold(thresholds[i]);
+    rawSignal.addPoint(leading);
+  }
+  for (auto time : {4000.0f, 4500.0f})
+  {
+    rawSignal.addPoint(JPetSigCh(JPetSigCh::Trailing, time));
+  }
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  JPetTimeWindow window("JPetRecoSignal");
+  window.add<JPetRecoSignal>(recoSignal);
+
+  task.reconstructTimes(window);
+  BOOST_REQUIRE_EQUAL(task.getFittedTimes().size(), 1u);
+  /// the fit uses the selected threshold of the task, not the default one of the fitter
+  auto expected = LeadingEdgeFitter(1, -1.0).fit(times.data(), thresholds.data(), static_cast<int>(times.size()));
+  BOOST_REQUIRE_CLOSE(task.getFittedTimes()[0], expected, 0.001);
+  BOOST_REQUIRE(std::abs(expected - LeadingEdgeFitter(1, 0.0).fit(times.data(), thresholds.data(), static_cast<int>(times.size()))) > 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+/**
+ *  @copyright Copyright 2020 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStreamDecompressorTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetStreamDecompressorTest
+
+#include "JPetUnzipAndUnpackTask/JPetStreamDecompressor.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <bzlib.h>
+#include <fstream>
+#include <lzma.h>
+#include <zlib.h>
+
+namespace
+{
+std::string makeData(std::size_t size)
+{
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i < size; i++)
+  {
+    data[i] = static_cast<char>((i * 7919) % 251);
+  }
+  return data;
+}
+
+void writeFile(const std::string& fileName, const std::string& content)
+{
+  std::ofstream out(fileName, std::ios::binary);
+  out.write(content.data(), content.size());
+}
+
+std::string gzipCompress(const std::string& data)
+{
+  z_stream stream = z_stream();
+  deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  std::string out(deflateBound(&stream, data.size()) + 32, '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+  stream.avail_out = out.size();
+  deflate(&stream, Z_FINISH);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return out;
+}
+
+std::string xzCompress(const std::string& data)
+{
+  std::string out(lzma_stream_buffer_bound(data.size()), '\0');
+  std::size_t outPos = 0;
+  lzma_easy_buffer_encode(1, LZMA_CHECK_CRC64, nullptr, reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                          reinterpret_cast<uint8_t*>(&out[0]), &outPos, out.size());
+  out.resize(outPos);
+  return out;
+}
+
+std::string bzip2Compress(const std::string& data)
+{
+  unsigned int outSize = data.size() + data.size() / 100 + 600;
+  std::string out(outSize, '\0');
+  BZ2_bzBuffToBuffCompress(&out[0], &outSize, const_cast<char*>(data.data()), data.size(), 9, 0, 0);
+  out.resize(outSize);
+  return out;
+}
+
+std::string readAll(JPetStreamDecompressor& decompressor, std::size_t chunkSize)
+{
+  std::string result;
+  std::vector<char> buffer(chunkSize);
+  while (!decompressor.isFinished() && !decompressor.hasError())
+  {
+    auto n = decompressor.read(buffer.data(), buffer.size());
+    result.append(buffer.data(), n);
+  }
+  return result;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(JPetStreamDecompressorTestSuite)
+
+BOOST_AUTO_TEST_CASE(getFormat)
+{
+  BOOST_REQUIRE_EQUAL(JPetStreamDecompressor::getFormat("file.hld.gz"), JPetStreamDecompressor::kGzip);
+  BOOST_REQUIRE_EQUAL(JPetStreamDecompressor::getFormat("file.hld.xz"), JPetStreamDecompressor::kXz);
+  BOOST_REQUIRE_EQUAL(JPetStreamDecompressor::getFormat("file.hld.bz2"), JPetStreamDecompressor::kBzip2);
+  BOOST_REQUIRE_EQUAL(JPetStreamDecompressor::getFormat("file.hld.zip"), JPetStreamDecompressor::kUnknown);
+  BOOST_REQUIRE_EQUAL(JPetStreamDecompressor::getFormat("file.hld"), JPetStreamDecompressor::kUnknown);
+}
+
+BOOST_AUTO_TEST_CASE(notExistingFile)
+{
+  JPetStreamDecompressor decompressor("notExistingFile.xz");
+  BOOST_REQUIRE(!decompressor.isOpen());
+  BOOST_REQUIRE(decompressor.hasError());
+}
+
+BOOST_AUTO_TEST_CASE(streamAllFormats)
+{
+  const auto data = makeData(3 * 1024 * 1024 + 17);
+  writeFile("streamDecompressorTest.gz", gzipCompress(data));
+  writeFile("streamDecompressorTest.xz", xzCompress(data));
+  writeFile("streamDecompressorTest.bz2", bzip2Compress(data));
+  for (const auto& fileName : {"streamDecompressorTest.gz", "streamDecompressorTest.xz", "streamDecompressorTest.bz2"})
+  {
+    JPetStreamDecompressor decompressor(fileName, 2);
+    BOOST_REQUIRE(decompressor.isOpen());
+    BOOST_REQUIRE(readAll(decompressor, 100000) == data);
+    BOOST_REQUIRE(!decompressor.hasError());
+    boost::filesystem::remove(fileName);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(concatenatedStreams)
+{
+  const auto first = makeData(1000);
+  const auto second = makeData(2000);
+  writeFile("streamDecompressorConcat.gz", gzipCompress(first) + gzipCompress(second));
+  writeFile("streamDecompressorConcat.bz2", bzip2Compress(first) + bzip2Compress(second));
+  writeFile("streamDecompressorConcat.xz", xzCompress(first) + xzCompress(second));
+  for (const auto& fileName : {"streamDecompressorConcat.gz", "streamDecompressorConcat.bz2", "streamDecompressorConcat.xz"})
+  {
+    JPetStreamDecompressor decompressor(fileName);
+    BOOST_REQUIRE(readAll(decompressor, 512) == first + second);
+    BOOST_REQUIRE(!decompressor.hasError());
+    boost::filesystem::remove(fileName);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(truncatedFile)
+{
+  const auto compressed = xzCompress(makeData(100000));
+  writeFile("streamDecompressorTruncated.xz", compressed.substr(0, compressed.size() / 2));
+  JPetStreamDecompressor decompressor("streamDecompressorTruncated.xz");
+  readAll(decompressor, 4096);
+  BOOST_REQUIRE(decompressor.hasError());
+  BOOST_REQUIRE(!JPetStreamDecompressor::decompressToFile("streamDecompressorTruncated.xz", "streamDecompressorTruncated"));
+  BOOST_REQUIRE(!boost::filesystem::exists("streamDecompressorTruncated"));
+  boost::filesystem::remove("streamDecompressorTruncated.xz");
+}
+
+BOOST_AUTO_TEST_CASE(decompressToFile)
+{
+  const auto data = makeData(5000);
+  writeFile("streamDecompressorToFile.gz", gzipCompress(data));
+  BOOST_REQUIRE(JPetStreamDecompressor::decompressToFile("streamDecompressorToFile.gz", "streamDecompressorToFile"));
+  std::ifstream in("streamDecompressorToFile", std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  BOOST_REQUIRE(content == data);
+  boost::filesystem::remove("streamDecompressorToFile.gz");
+  boost::filesystem::remove("streamDecompressorToFile");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,10 +17,47 @@
 #define BOOST_TEST_MODULE JPetUnzipAndUnpackTaskTest
 
 #include "JPetUnzipAndUnpackTask/JPetUnzipAndUnpackTask.h"
+#include "JPetDataInterface/JPetDataInterface.h"
+#include "JPetHLDLoader/JPetHLDIndex.h"
+#include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetOptionsTools/JPetOptionsTools.h"
+#include "JPetParams/JPetParams.h"
 
+#include <TFile.h>
+#include <TTree.h>
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
+namespace
+{
+/// The hld file is copied, so its index and the unpacker output do not stay in unitTestData.
+std::string copyTestHldFile(const boost::filesystem::path& dir)
+{
+  boost::filesystem::create_directories(dir);
+  auto hldFile = dir / "xx14099113231.hld";
+  boost::filesystem::copy_file("unitTestData/JPetUnpackerTest/xx14099113231.hld", hldFile);
+  return hldFile.string();
+}
+
+JPetUnzipAndUnpackTask::OptsStrAny createHldOptions(const std::string& hldFile, int firstEvent, int lastEvent)
+{
+  auto opts = jpet_options_generator_tools::getDefaultOptions();
+  opts["inputFile_std::string"] = hldFile;
+  opts["inputFileType_std::string"] = std::string("hld");
+  opts["unpackerConfigFile_std::string"] = std::string("unitTestData/JPetUnpackerTest/conf_trb3.xml");
+  opts["firstEvent_int"] = firstEvent;
+  opts["lastEvent_int"] = lastEvent;
+  return opts;
+}
+
+long long getNumberOfUnpackedEvents(const std::string& fileName)
+{
+  TFile file(fileName.c_str(), "READ");
+  auto tree = dynamic_cast<TTree*>(file.Get("T"));
+  return tree ? tree->GetEntries() : -1;
+}
+}
+
 BOOST_AUTO_TEST_SUITE(JPetUnzipAndUnpackTaskTestSuite)
 
 BOOST_AUTO_TEST_CASE(sucessGz)
@@ -83,4 +120,56 @@ BOOST_AUTO_TEST_CASE(tryToUnzipSomethingNotExistingFileWithZip)
   BOOST_REQUIRE(!JPetUnzipAndUnpackTask::unzipFile("unitTestData/JPetTaskChainExecutorUtilsTest/wrongZIP.zip"));
 }
 
+BOOST_AUTO_TEST_CASE(unpackToTheEndOfFile)
+{
+  auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  auto hldFile = copyTestHldFile(dir);
+  JPetHLDIndex index;
+  BOOST_REQUIRE(index.loadOrBuild(hldFile));
+  BOOST_REQUIRE(index.getNumberOfEvents() > 2);
+
+  JPetUnzipAndUnpackTask task("unpackTask");
+  BOOST_REQUIRE(task.init(JPetParams(createHldOptions(hldFile, 2, -1), nullptr)));
+  JPetDataInterface pseudoData;
+  BOOST_REQUIRE(task.run(pseudoData));
+  JPetParams outParams;
+  BOOST_REQUIRE(task.terminate(outParams));
+  BOOST_REQUIRE_EQUAL(getNumberOfUnpackedEvents(hldFile + ".root"), index.getNumberOfEvents() - 2);
+  /// the output starts with the first requested event, so the range is not applied again
+  BOOST_REQUIRE(jpet_options_tools::getOptionAsBool(outParams.getOptions(), "resetEventRange_bool"));
+  boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(unpackShards)
+{
+  auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  auto hldFile = copyTestHldFile(dir);
+  JPetHLDIndex index;
+  BOOST_REQUIRE(index.loadOrBuild(hldFile));
+  BOOST_REQUIRE(index.getNumberOfEvents() > 1);
+
+  long long unpackedEvents = 0;
+  for (int shard = 0; shard < 2; shard++)
+  {
+    auto opts = createHldOptions(hldFile, -1, -1);
+    opts["shardIndex_int"] = shard;
+    opts["numberOfShards_int"] = 2;
+    JPetUnzipAndUnpackTask task("unpackTask");
+    BOOST_REQUIRE(task.init(JPetParams(opts, nullptr)));
+    JPetDataInterface pseudoData;
+    BOOST_REQUIRE(task.run(pseudoData));
+    JPetParams outParams;
+    BOOST_REQUIRE(task.terminate(outParams));
+    auto shardFile = (dir / ("xx14099113231_shard" + std::to_string(shard) + "of2.hld.root")).string();
+    BOOST_REQUIRE_EQUAL(jpet_options_tools::getOutputFile(outParams.getOptions()), shardFile);
+    /// every shard contains only its own part of the events
+    const auto expectedEvents = index.getNumberOfEvents() * (shard + 1) / 2 - index.getNumberOfEvents() * shard / 2;
+    BOOST_REQUIRE_EQUAL(getNumberOfUnpackedEvents(shardFile), expectedEvents);
+    unpackedEvents += expectedEvents;
+  }
+  BOOST_REQUIRE_EQUAL(unpackedEvents, index.getNumberOfEvents());
+  BOOST_REQUIRE(!boost::filesystem::exists(hldFile + ".root"));
+  boost::filesystem::remove_all(dir);
+}
+
 BOOST_AUTO_TEST_SUITE_END()